@@ -1,7 +1,7 @@
 import { Component, OnInit, OnDestroy, AfterViewInit } from '@angular/core';
 import { MenuItem } from 'primeng/api';
 import { fromEvent } from 'rxjs';
-declare var OccApp: any;
+declare var loadOccApp: any;
 
 @Component({
   selector: 'app-geometry',
@@ -81,6 +81,9 @@ export class GeometryComponent implements OnInit, OnDestroy, AfterViewInit {
       },
     };
     console.log('config :', config);
+    // SIMD or scalar build of the viewer, depending on browser support
+    const { OccApp, variant } = await loadOccApp();
+    console.log('wasm variant : ', variant);
     const runtime = await OccApp(config);
     self.OccViewer = config;
     console.log('runtime : ', runtime);
@@ -0,0 +1,88 @@
+// Loader of the OccApp WebAssembly module.
+// The viewer is built in two variants: OccApp.js runs in every browser, and
+// OccAppSimd.js (configured with WITH_SIMD=ON) requires WebAssembly SIMD128.
+// loadOccApp() picks the SIMD variant when the browser supports it, and falls
+// back to the scalar one otherwise or when OccAppSimd.js is not deployed.
+// Both variants define the same global OccApp factory, so only one of them
+// is loaded per page.
+
+(function(theGlobal) {
+  // (module (func (result v128) i32.const 0 i8x16.splat i8x16.popcnt))
+  const SIMD_PROBE = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10,
+    1, 8, 0, 65, 0, 253, 15, 253, 98, 11
+  ]);
+
+  const FILES = {scalar : 'OccApp.js', simd : 'OccAppSimd.js'};
+
+  let myLoading = null;
+
+  // Return TRUE if the browser can compile WebAssembly SIMD128 code.
+  function hasWasmSimd() {
+    try {
+      return typeof WebAssembly === 'object' &&
+             WebAssembly.validate(SIMD_PROBE);
+    } catch (theError) {
+      return false;
+    }
+  }
+
+  function loadScript(theUrl) {
+    return new Promise(function(theResolve, theReject) {
+      const aScript = document.createElement('script');
+      aScript.src = theUrl;
+      aScript.async = true;
+      aScript.onload = theResolve;
+      aScript.onerror = function() {
+        aScript.remove();
+        theReject(new Error('unable to load ' + theUrl));
+      };
+      document.head.appendChild(aScript);
+    });
+  }
+
+  async function loadVariant(theBaseUrl, theVariant) {
+    await loadScript(theBaseUrl + FILES[theVariant]);
+    return {OccApp : theGlobal.OccApp, variant : theVariant};
+  }
+
+  // Load the OccApp factory and resolve to {OccApp, variant}.
+  // Options:
+  //   baseUrl - directory of the module scripts, 'assets/wasm/' by default;
+  //   variant - 'auto' (default), 'simd' or 'scalar'; the 'wasm' URL query
+  //             parameter (e.g. ?wasm=scalar) overrides 'auto' for testing.
+  // The module is loaded once; later calls return the same result.
+  theGlobal.loadOccApp = function(theOptions) {
+    if (myLoading !== null) {
+      return myLoading;
+    }
+
+    const anOptions = theOptions || {};
+    const aBaseUrl = anOptions.baseUrl || 'assets/wasm/';
+    let aVariant = anOptions.variant || 'auto';
+    if (aVariant === 'auto') {
+      aVariant = new URLSearchParams(theGlobal.location.search).get('wasm') ||
+                 'auto';
+    }
+    if (aVariant === 'auto') {
+      aVariant = hasWasmSimd() ? 'simd' : 'scalar';
+    } else if (aVariant === 'simd' && !hasWasmSimd()) {
+      console.warn('WebAssembly SIMD is not supported, using scalar build');
+      aVariant = 'scalar';
+    } else if (FILES[aVariant] === undefined) {
+      return Promise.reject(new Error('unknown OccApp variant ' + aVariant));
+    }
+
+    myLoading = loadVariant(aBaseUrl, aVariant).catch(function(theError) {
+      if (aVariant !== 'simd') {
+        throw theError;
+      }
+      // SIMD build is optional
+      console.warn(theError.message + ', using scalar build');
+      return loadVariant(aBaseUrl, 'scalar');
+    });
+    return myLoading;
+  };
+
+  theGlobal.hasWasmSimd = hasWasmSimd;
+})(window);
@@ -0,0 +1,299 @@
+// Offscreen frame-time benchmark replaying scripted camera orbits over
+// reference models. The viewer is configured by OcctViewSetup exactly like
+// the WebGL viewer, but renders into a virtual (never mapped) X11 window.
+//
+// Usage: renderbench [-size WxH] [-orbits N] [-frames N] [-warmup N]
+//                    [-csv frames.csv] model1 [model2 ...]
+//
+// Models can be ASCII or binary BRep (optionally gzip/zstd compressed),
+// STEP or IGES files. Each orbit turns the camera around the model at
+// a different elevation; every frame is timed from Redraw() to glFinish().
+//
+// To run on a machine without GPU, use software Mesa within Xvfb:
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a -s "-screen 0 1920x1080x24" \
+//     ./renderbench model.brep
+
+#include <AIS_Shape.hxx>
+#include <Aspect_DisplayConnection.hxx>
+#include <IGESControl_Reader.hxx>
+#include <Message.hxx>
+#include <OSD_Timer.hxx>
+#include <OpenGl_Context.hxx>
+#include <OpenGl_FrameStats.hxx>
+#include <OpenGl_GlFunctions.hxx>
+#include <OpenGl_GraphicDriver.hxx>
+#include <STEPControl_Reader.hxx>
+#include <Xw_Window.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ModelFormat.h"
+#include "ModelReader.h"
+#include "OcctViewSetup.h"
+
+namespace {
+//! Benchmark parameters.
+struct BenchParams {
+  int Width = 1280;
+  int Height = 720;
+  int NbOrbits = 3;
+  int NbFramesPerOrbit = 120;
+  int NbWarmupFrames = 10;
+  std::string CsvPath;
+  std::vector<std::string> Models;
+};
+
+//! Statistics of a single frame.
+struct FrameSample {
+  double Time;       //!< frame time in milliseconds
+  size_t NbDraws;    //!< number of rendered primitive arrays
+  size_t NbTriangles;  //!< number of rendered triangles
+};
+
+//! Read model file into a shape.
+bool readModel(const std::string& thePath, TopoDS_Shape& theShape) {
+  std::string aData;
+  if (!ModelReader::ReadFile(thePath, aData)) {
+    return false;
+  }
+
+  switch (ModelFormatTool::Detect(thePath, aData.data(), aData.size())) {
+    case ModelFormat_BRep:
+    case ModelFormat_BinBRep:
+      return ModelReader::ReadBRep(thePath, aData.data(), aData.size(),
+                                   theShape);
+    case ModelFormat_STEP: {
+      STEPControl_Reader aReader;
+      if (aReader.ReadFile(thePath.c_str()) != IFSelect_RetDone) {
+        return false;
+      }
+      aReader.TransferRoots();
+      theShape = aReader.OneShape();
+      return !theShape.IsNull();
+    }
+    case ModelFormat_IGES: {
+      IGESControl_Reader aReader;
+      if (aReader.ReadFile(thePath.c_str()) != IFSelect_RetDone) {
+        return false;
+      }
+      aReader.TransferRoots();
+      theShape = aReader.OneShape();
+      return !theShape.IsNull();
+    }
+    case ModelFormat_VTK:
+    case ModelFormat_Nastran:
+    case ModelFormat_Abaqus:
+    case ModelFormat_Unknown:
+      break;
+  }
+  return false;
+}
+
+//! Return percentile of sorted values.
+double percentile(const std::vector<double>& theSorted, double thePercent) {
+  if (theSorted.empty()) {
+    return 0.0;
+  }
+  const size_t anIndex = std::min(
+      theSorted.size() - 1, size_t(thePercent / 100.0 * theSorted.size()));
+  return theSorted[anIndex];
+}
+
+//! Offscreen renderer.
+class OffscreenBench {
+ public:
+  //! Create viewer and virtual window.
+  bool Init(const BenchParams& theParams) {
+    Handle(Aspect_DisplayConnection) aDisp = new Aspect_DisplayConnection();
+    myDriver = new OpenGl_GraphicDriver(aDisp, false);
+    // no presentation to screen and no vertical synchronization
+    myDriver->ChangeOptions().buffersNoSwap = true;
+    myDriver->ChangeOptions().swapInterval = 0;
+    if (!myDriver->InitContext()) {
+      Message::SendFail() << "Error: OpenGL context initialization failed";
+      return false;
+    }
+
+    Handle(Xw_Window) aWindow = new Xw_Window(
+        aDisp, "renderbench", 0, 0, theParams.Width, theParams.Height);
+    aWindow->SetVirtual(true);
+
+    Handle(V3d_Viewer) aViewer = OcctViewSetup::CreateViewer(myDriver);
+    myView = OcctViewSetup::CreateView(aViewer, aWindow, 1.0f);
+    myContext = OcctViewSetup::CreateContext(aViewer);
+
+    // collect rendered elements on every frame
+    Graphic3d_RenderingParams& aParams = myView->ChangeRenderingParams();
+    aParams.CollectedStats = Graphic3d_RenderingParams::PerfCounters(
+        Graphic3d_RenderingParams::PerfCounters_Groups |
+        Graphic3d_RenderingParams::PerfCounters_GroupArrays |
+        Graphic3d_RenderingParams::PerfCounters_Triangles);
+    aParams.StatsUpdateInterval = 0.0;
+    return true;
+  }
+
+  //! Display model and replay camera orbits.
+  void Run(const BenchParams& theParams, const TopoDS_Shape& theShape,
+           std::vector<FrameSample>& theSamples) {
+    Handle(AIS_Shape) aPrs = new AIS_Shape(theShape);
+    aPrs->SetMaterial(Graphic3d_NameOfMaterial_Silver);
+    myContext->Display(aPrs, AIS_Shaded, 0, false);
+    myView->FitAll(0.01, false);
+
+    const Handle(Graphic3d_Camera)& aCamera = myView->Camera();
+    const gp_Pnt aCenter = aCamera->Center();
+    const double aDistance = aCamera->Distance();
+
+    // first frames upload buffers and compile shaders
+    for (int aFrameIter = 0; aFrameIter < theParams.NbWarmupFrames;
+         ++aFrameIter) {
+      redraw();
+    }
+
+    theSamples.clear();
+    for (int anOrbitIter = 0; anOrbitIter < theParams.NbOrbits;
+         ++anOrbitIter) {
+      // orbits are spread within [-45, 45] degrees of elevation
+      const double anElevation =
+          (-45.0 + 90.0 * (anOrbitIter + 0.5) / theParams.NbOrbits) * M_PI /
+          180.0;
+      for (int aFrameIter = 0; aFrameIter < theParams.NbFramesPerOrbit;
+           ++aFrameIter) {
+        const double anAngle =
+            2.0 * M_PI * aFrameIter / theParams.NbFramesPerOrbit;
+        const gp_Vec aDir(std::cos(anElevation) * std::cos(anAngle),
+                          std::cos(anElevation) * std::sin(anAngle),
+                          std::sin(anElevation));
+        aCamera->SetEyeAndCenter(aCenter.Translated(aDir * aDistance),
+                                 aCenter);
+        aCamera->SetUp(gp::DZ());
+        myView->AutoZFit();
+        theSamples.push_back(redraw());
+      }
+    }
+
+    myContext->Remove(aPrs, false);
+  }
+
+ private:
+  //! Redraw view and wait for rendering to complete.
+  FrameSample redraw() {
+    const Handle(OpenGl_Context)& aCtx = myDriver->GetSharedContext();
+    OSD_Timer aTimer;
+    aTimer.Start();
+    myView->Invalidate();
+    myView->Redraw();
+    aCtx->core11fwd->glFinish();
+    aTimer.Stop();
+
+    const Graphic3d_FrameStatsData& aStats =
+        aCtx->FrameStats()->LastDataFrame();
+    FrameSample aSample;
+    aSample.Time = aTimer.ElapsedTime() * 1000.0;
+    aSample.NbDraws = aStats[Graphic3d_FrameStatsCounter_NbElemsNotCulled];
+    aSample.NbTriangles =
+        aStats[Graphic3d_FrameStatsCounter_NbTrianglesNotCulled];
+    return aSample;
+  }
+
+ private:
+  Handle(OpenGl_GraphicDriver) myDriver;
+  Handle(V3d_View) myView;
+  Handle(AIS_InteractiveContext) myContext;
+};
+}  // namespace
+
+int main(int theNbArgs, char** theArgVec) {
+  BenchParams aParams;
+  for (int anArgIter = 1; anArgIter < theNbArgs; ++anArgIter) {
+    const char* anArg = theArgVec[anArgIter];
+    const bool hasValue = anArgIter + 1 < theNbArgs;
+    if (::strcmp(anArg, "-size") == 0 && hasValue) {
+      if (std::sscanf(theArgVec[++anArgIter], "%dx%d", &aParams.Width,
+                      &aParams.Height) != 2 ||
+          aParams.Width <= 0 || aParams.Height <= 0) {
+        std::cerr << "Error: wrong size '" << theArgVec[anArgIter] << "'\n";
+        return 1;
+      }
+    } else if (::strcmp(anArg, "-orbits") == 0 && hasValue) {
+      aParams.NbOrbits = std::max(1, std::atoi(theArgVec[++anArgIter]));
+    } else if (::strcmp(anArg, "-frames") == 0 && hasValue) {
+      aParams.NbFramesPerOrbit =
+          std::max(1, std::atoi(theArgVec[++anArgIter]));
+    } else if (::strcmp(anArg, "-warmup") == 0 && hasValue) {
+      aParams.NbWarmupFrames = std::max(0, std::atoi(theArgVec[++anArgIter]));
+    } else if (::strcmp(anArg, "-csv") == 0 && hasValue) {
+      aParams.CsvPath = theArgVec[++anArgIter];
+    } else if (anArg[0] != '-') {
+      aParams.Models.push_back(anArg);
+    } else {
+      std::cerr << "Error: unknown argument '" << anArg << "'\n";
+      return 1;
+    }
+  }
+  if (aParams.Models.empty()) {
+    std::cerr << "Usage: " << theArgVec[0]
+              << " [-size WxH] [-orbits N] [-frames N] [-warmup N]"
+                 " [-csv frames.csv] model1 [model2 ...]\n";
+    return 1;
+  }
+
+  OffscreenBench aBench;
+  if (!aBench.Init(aParams)) {
+    return 1;
+  }
+
+  std::ofstream aCsv;
+  if (!aParams.CsvPath.empty()) {
+    aCsv.open(aParams.CsvPath);
+    aCsv << "model,frame,time_ms,draws,triangles\n";
+  }
+
+  int aResult = 0;
+  std::cout << "model\tframes\tmean ms\tmedian ms\tp95 ms\tmax ms\tdraws\t"
+               "triangles\n";
+  for (const std::string& aModelPath : aParams.Models) {
+    TopoDS_Shape aShape;
+    if (!readModel(aModelPath, aShape)) {
+      std::cerr << "Error: unable to read model '" << aModelPath << "'\n";
+      aResult = 1;
+      continue;
+    }
+
+    std::vector<FrameSample> aSamples;
+    aBench.Run(aParams, aShape, aSamples);
+
+    std::vector<double> aTimes;
+    aTimes.reserve(aSamples.size());
+    size_t aMaxDraws = 0, aMaxTriangles = 0;
+    for (size_t aFrameIter = 0; aFrameIter < aSamples.size(); ++aFrameIter) {
+      const FrameSample& aSample = aSamples[aFrameIter];
+      aTimes.push_back(aSample.Time);
+      aMaxDraws = std::max(aMaxDraws, aSample.NbDraws);
+      aMaxTriangles = std::max(aMaxTriangles, aSample.NbTriangles);
+      if (aCsv.is_open()) {
+        aCsv << aModelPath << "," << aFrameIter << "," << aSample.Time << ","
+             << aSample.NbDraws << "," << aSample.NbTriangles << "\n";
+      }
+    }
+    std::sort(aTimes.begin(), aTimes.end());
+    double aSum = 0.0;
+    for (double aTime : aTimes) {
+      aSum += aTime;
+    }
+    std::cout << aModelPath << "\t" << aTimes.size() << "\t"
+              << aSum / std::max<size_t>(1, aTimes.size()) << "\t"
+              << percentile(aTimes, 50.0) << "\t" << percentile(aTimes, 95.0)
+              << "\t" << (aTimes.empty() ? 0.0 : aTimes.back()) << "\t"
+              << aMaxDraws << "\t" << aMaxTriangles << "\n";
+  }
+  return aResult;
+}
@@ -0,0 +1,33 @@
+#!/bin/sh
+# Generate a series of synthetic assemblies of growing size for the loader
+# scaling benchmark (index.html) and write models/manifest.json.
+#
+# Usage: generate_series.sh [path/to/asmgen] [output directory]
+#
+# Series parameters may be overridden by environment variables:
+#   PARTS="10 100 1000 10000" FACES=12 INSTANCING=4 DEPTH=3
+
+set -e
+
+ASMGEN=${1:-./asmgen}
+OUT_DIR=${2:-models}
+PARTS=${PARTS:-"10 30 100 300 1000 3000 10000"}
+FACES=${FACES:-12}
+INSTANCING=${INSTANCING:-4}
+DEPTH=${DEPTH:-3}
+
+mkdir -p "$OUT_DIR"
+MANIFEST="$OUT_DIR/manifest.json"
+echo "[" > "$MANIFEST"
+SEPARATOR=""
+for NB_PARTS in $PARTS; do
+  NAME="asm_p${NB_PARTS}_f${FACES}_i${INSTANCING}_d${DEPTH}"
+  STATS=$("$ASMGEN" -parts "$NB_PARTS" -faces "$FACES" \
+    -instancing "$INSTANCING" -depth "$DEPTH" \
+    "$OUT_DIR/$NAME.step" "$OUT_DIR/$NAME.brep")
+  echo "$STATS"
+  printf '%s  %s' "$SEPARATOR" "$STATS" >> "$MANIFEST"
+  SEPARATOR=",
+"
+done
+printf '\n]\n' >> "$MANIFEST"
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""Plot load time and heap memory against model size from scaling.csv
+produced by the loader scaling benchmark (index.html).
+
+Usage: plot_scaling.py scaling.csv [output.png]
+"""
+
+import csv
+import sys
+from collections import defaultdict
+
+import matplotlib
+
+matplotlib.use("Agg")
+import matplotlib.pyplot as plt
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 1
+
+    # median of repeated runs per (format, faces)
+    runs = defaultdict(list)
+    for row in csv.DictReader(open(sys.argv[1])):
+        key = (row["format"], int(row["faces"]))
+        runs[key].append((float(row["load_ms"]), float(row["heap_used"])))
+
+    series = defaultdict(list)
+    for (fmt, faces), values in sorted(runs.items()):
+        times = sorted(v[0] for v in values)
+        heaps = sorted(v[1] for v in values)
+        series[fmt].append(
+            (faces, times[len(times) // 2], heaps[len(heaps) // 2] / 2**20))
+
+    fig, (ax_time, ax_mem) = plt.subplots(1, 2, figsize=(12, 5))
+    for fmt, points in series.items():
+        faces = [p[0] for p in points]
+        ax_time.plot(faces, [p[1] for p in points], "o-", label=fmt)
+        ax_mem.plot(faces, [p[2] for p in points], "o-", label=fmt)
+
+    for ax in (ax_time, ax_mem):
+        ax.set_xscale("log")
+        ax.set_yscale("log")
+        ax.set_xlabel("faces (with instances)")
+        ax.grid(True, which="both", alpha=0.3)
+        ax.legend()
+    ax_time.set_ylabel("load time, ms")
+    ax_mem.set_ylabel("heap used after load, MiB")
+    # linear reference makes super-linear growth easy to spot
+    for fmt, points in series.items():
+        if len(points) > 1:
+            f0, t0 = points[0][0], points[0][1]
+            ax_time.plot([p[0] for p in points],
+                         [t0 * p[0] / f0 for p in points],
+                         ":", color="gray")
+            break
+
+    output = sys.argv[2] if len(sys.argv) > 2 else "scaling.png"
+    fig.tight_layout()
+    fig.savefig(output, dpi=120)
+    print("written", output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
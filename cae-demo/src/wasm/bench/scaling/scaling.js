@@ -0,0 +1,87 @@
+// Loader scaling benchmark - feeds generated models through openFromMemory()
+// and records load time and heap memory against model size.
+
+const COLUMNS = ['file', 'format', 'parts', 'instances', 'assemblies',
+                 'faces', 'bytes', 'load_ms', 'heap_used', 'heap_size'];
+
+function setStatus(theText) {
+  document.getElementById('status').textContent = theText;
+}
+
+function addRow(theTable, theValues, theIsHeader) {
+  const aRow = theTable.insertRow();
+  for (const aValue of theValues) {
+    const aCell = document.createElement(theIsHeader ? 'th' : 'td');
+    aCell.textContent = aValue;
+    aRow.appendChild(aCell);
+  }
+}
+
+// Load single file and return elapsed time in milliseconds.
+function loadModel(theModule, theName, theData) {
+  const aBuffer = theModule._malloc(theData.length);
+  theModule.HEAPU8.set(theData, aBuffer);
+  const aStart = performance.now();
+  const isLoaded = theModule.openFromMemory(theName, aBuffer,
+                                            theData.length, true);
+  const anElapsed = performance.now() - aStart;
+  if (!isLoaded) {
+    throw new Error('unable to load ' + theName);
+  }
+  return anElapsed;
+}
+
+async function runBenchmark(theModule) {
+  const aNbRepeats = Math.max(1, Number(
+      document.getElementById('repeats').value));
+  const aManifest = await (await fetch('models/manifest.json')).json();
+  const aTable = document.getElementById('results');
+  aTable.innerHTML = '';
+  addRow(aTable, COLUMNS, true);
+  const aLines = [COLUMNS.join(',')];
+  for (const anEntry of aManifest) {
+    for (const aFile of anEntry.files) {
+      const aName = aFile.path.split('/').pop();
+      const aData = new Uint8Array(
+          await (await fetch('models/' + aName)).arrayBuffer());
+      for (let aRepeat = 0; aRepeat < aNbRepeats; ++aRepeat) {
+        setStatus('Loading ' + aName + ' (' + (aRepeat + 1) + '/' +
+                  aNbRepeats + ')');
+        // let the browser update the page between heavy loads
+        await new Promise(theResolve => setTimeout(theResolve, 0));
+        theModule.removeAllObjects();
+        // drop cached documents so STEP files are parsed on every repeat
+        theModule.clearModelCache();
+        const aTime = loadModel(theModule, aName, aData);
+        const aValues = [aName, aName.split('.').pop(), anEntry.parts,
+                         anEntry.instances, anEntry.assemblies, anEntry.faces,
+                         aData.length, aTime.toFixed(1),
+                         theModule.memoryUsage(), theModule.HEAPU8.length];
+        addRow(aTable, aValues, false);
+        aLines.push(aValues.join(','));
+      }
+    }
+  }
+  theModule.removeAllObjects();
+  theModule.clearModelCache();
+
+  const aLink = document.getElementById('csv');
+  aLink.href = URL.createObjectURL(
+      new Blob([aLines.join('\n') + '\n'], {type : 'text/csv'}));
+  aLink.hidden = false;
+  setStatus('Done');
+}
+
+(async function() {
+  const aCanvas = document.getElementById('canvas');
+  aCanvas.width = 640;
+  aCanvas.height = 360;
+  const aModule = {canvas : aCanvas};
+  await OccApp(aModule);
+  document.getElementById('run').onclick = function() {
+    runBenchmark(aModule).catch(function(theError) {
+      setStatus('Error: ' + theError.message);
+    });
+  };
+  setStatus('Ready');
+})();
@@ -0,0 +1,199 @@
+// SIMD benchmark - times loading, remeshing and picking of the scaling
+// benchmark models in the running (scalar or SIMD) build of the viewer and
+// shows the results of both builds side by side.
+
+const STORAGE_KEY = 'OccAppSimdBench';
+const VARIANTS = ['scalar', 'simd'];
+const METRICS = ['load_ms', 'mesh_ms', 'pick_first_ms', 'pick_ms'];
+// relative deflection of the remeshing pass, finer than the default one
+const MESH_DEFLECTION = 0.0005;
+const MESH_ANGLE = 10.0;
+
+function setStatus(theText) {
+  document.getElementById('status').textContent = theText;
+}
+
+function addRow(theTable, theValues, theIsHeader) {
+  const aRow = theTable.insertRow();
+  for (const aValue of theValues) {
+    const aCell = document.createElement(theIsHeader ? 'th' : 'td');
+    aCell.textContent = aValue;
+    aRow.appendChild(aCell);
+  }
+}
+
+function loadResults() {
+  const aResults = JSON.parse(localStorage.getItem(STORAGE_KEY) || '{}');
+  for (const aVariant of VARIANTS) {
+    aResults[aVariant] = aResults[aVariant] || {};
+  }
+  return aResults;
+}
+
+function median(theValues) {
+  const aSorted = theValues.slice().sort((theA, theB) => theA - theB);
+  const aMid = aSorted.length >> 1;
+  return aSorted.length % 2 !== 0 ? aSorted[aMid]
+                                  : 0.5 * (aSorted[aMid - 1] + aSorted[aMid]);
+}
+
+// Show stored results of both variants side by side, with the speedup of
+// the SIMD build over the scalar one.
+function showResults(theResults) {
+  const aTable = document.getElementById('results');
+  aTable.innerHTML = '';
+  const aHeader = ['file', 'faces', 'bytes'];
+  for (const aMetric of METRICS) {
+    aHeader.push(aMetric + ' scalar', aMetric + ' simd', 'speedup');
+  }
+  addRow(aTable, aHeader, true);
+
+  const aFiles = new Set(Object.keys(theResults.scalar)
+                             .concat(Object.keys(theResults.simd)));
+  const aLines = [['file', 'faces', 'bytes', 'variant'].concat(METRICS)];
+  for (const aFile of aFiles) {
+    const aScalar = theResults.scalar[aFile];
+    const aSimd = theResults.simd[aFile];
+    const anInfo = aScalar || aSimd;
+    const aValues = [aFile, anInfo.faces, anInfo.bytes];
+    for (const aMetric of METRICS) {
+      const aScalarTime = aScalar ? aScalar[aMetric] : undefined;
+      const aSimdTime = aSimd ? aSimd[aMetric] : undefined;
+      aValues.push(aScalarTime !== undefined ? aScalarTime.toFixed(2) : '-',
+                   aSimdTime !== undefined ? aSimdTime.toFixed(2) : '-',
+                   aScalarTime !== undefined && aSimdTime > 0
+                       ? (aScalarTime / aSimdTime).toFixed(2) + 'x'
+                       : '-');
+    }
+    addRow(aTable, aValues, false);
+
+    for (const aVariant of VARIANTS) {
+      const aRecord = theResults[aVariant][aFile];
+      if (aRecord) {
+        aLines.push([aFile, aRecord.faces, aRecord.bytes, aVariant].concat(
+            METRICS.map(theMetric => aRecord[theMetric].toFixed(3))));
+      }
+    }
+  }
+
+  const aLink = document.getElementById('csv');
+  aLink.href = URL.createObjectURL(new Blob(
+      [aLines.map(theLine => theLine.join(',')).join('\n') + '\n'],
+      {type : 'text/csv'}));
+  aLink.hidden = aLines.length < 2;
+}
+
+// Resolve when the named model is remeshed.
+function waitRemesh(theModule, theName) {
+  return new Promise(function(theResolve) {
+    theModule.onRemeshDone = function(theDoneName) {
+      if (theDoneName === theName) {
+        theModule.onRemeshDone = undefined;
+        theResolve();
+      }
+    };
+  });
+}
+
+// Run single load / remesh / pick pass and return timings in milliseconds.
+async function measureModel(theModule, theName, theData, theNbPicks) {
+  const aTimes = {};
+  theModule.removeAllObjects();
+  const aBuffer = theModule._malloc(theData.length);
+  theModule.HEAPU8.set(theData, aBuffer);
+  let aStart = performance.now();
+  const isLoaded = theModule.openFromMemory(theName, aBuffer,
+                                            theData.length, true);
+  aTimes.load_ms = performance.now() - aStart;
+  if (!isLoaded) {
+    throw new Error('unable to load ' + theName);
+  }
+  theModule.fitAllObjects(false);
+
+  // remeshing is split into time slices, so this includes the (equal for
+  // both builds) idle time between slices
+  const aRemeshed = waitRemesh(theModule, theName);
+  aStart = performance.now();
+  if (!theModule.setMeshQuality(theName, MESH_DEFLECTION, MESH_ANGLE, true)) {
+    throw new Error('unable to remesh ' + theName);
+  }
+  await aRemeshed;
+  aTimes.mesh_ms = performance.now() - aStart;
+
+  // the first pick also builds the selection BVH;
+  // points follow a low-discrepancy sequence over the canvas
+  const aCanvas = document.getElementById('canvas');
+  const aPickTimes = [];
+  for (let aPickIter = 0; aPickIter <= theNbPicks; ++aPickIter) {
+    const aX = Math.floor(aCanvas.width * (aPickIter + 0.5) /
+                          (theNbPicks + 1));
+    const aY = Math.floor(aCanvas.height * ((aPickIter * 0.618034) % 1.0));
+    aStart = performance.now();
+    theModule.detectAt(aX, aY);
+    aPickTimes.push(performance.now() - aStart);
+  }
+  aTimes.pick_first_ms = aPickTimes[0];
+  aTimes.pick_ms = median(aPickTimes.slice(1));
+  return aTimes;
+}
+
+async function runBenchmark(theModule, theVariant) {
+  const aNbRepeats = Math.max(1, Number(
+      document.getElementById('repeats').value));
+  const aNbPicks = Math.max(1, Number(document.getElementById('picks').value));
+  const aManifest =
+      await (await fetch('../scaling/models/manifest.json')).json();
+  const aResults = loadResults();
+  aResults[theVariant] = {};
+  for (const anEntry of aManifest) {
+    for (const aFile of anEntry.files) {
+      const aName = aFile.path.split('/').pop();
+      const aData = new Uint8Array(
+          await (await fetch('../scaling/models/' + aName)).arrayBuffer());
+      const aRuns = [];
+      for (let aRepeat = 0; aRepeat < aNbRepeats; ++aRepeat) {
+        setStatus('Measuring ' + aName + ' (' + (aRepeat + 1) + '/' +
+                  aNbRepeats + ')');
+        // let the browser update the page between heavy loads
+        await new Promise(theResolve => setTimeout(theResolve, 0));
+        // drop cached documents so STEP files are parsed on every run
+        theModule.clearModelCache();
+        aRuns.push(await measureModel(theModule, aName, aData, aNbPicks));
+      }
+
+      const aRecord = {faces : anEntry.faces, bytes : aData.length};
+      for (const aMetric of METRICS) {
+        aRecord[aMetric] = median(aRuns.map(theRun => theRun[aMetric]));
+      }
+      aResults[theVariant][aName] = aRecord;
+      localStorage.setItem(STORAGE_KEY, JSON.stringify(aResults));
+      showResults(aResults);
+    }
+  }
+  theModule.removeAllObjects();
+  theModule.clearModelCache();
+  setStatus('Done');
+}
+
+(async function() {
+  showResults(loadResults());
+  const {OccApp, variant} =
+      await loadOccApp({baseUrl : '../../../assets/wasm/'});
+  document.getElementById('variant').textContent = variant;
+
+  const aCanvas = document.getElementById('canvas');
+  aCanvas.width = 640;
+  aCanvas.height = 360;
+  const aModule = {canvas : aCanvas};
+  await OccApp(aModule);
+  document.getElementById('run').onclick = function() {
+    runBenchmark(aModule, variant).catch(function(theError) {
+      setStatus('Error: ' + theError.message);
+    });
+  };
+  document.getElementById('reset').onclick = function() {
+    localStorage.removeItem(STORAGE_KEY);
+    showResults(loadResults());
+  };
+  setStatus('Ready');
+})();
@@ -29,12 +29,13 @@
 
 #include <Message.hxx>
 #include <Message_Messenger.hxx>
-#include <Message_PrinterSystemLog.hxx>
+#include <Message_PrinterOStream.hxx>
 #include <OSD_MemInfo.hxx>
 #include <OSD_Parallel.hxx>
 #include <cstdlib>
 #include <iostream>
 
+#include "WasmLog.h"
 #include "WasmOcctView.h"
 
 //! Dummy main loop callback for a single shot.
@@ -45,32 +46,30 @@ extern "C" void onMainLoop() {
 
 EMSCRIPTEN_KEEPALIVE int main() {
   {
+    // filtering is done by WasmLog, spdlog only prints to the console
     auto console = spdlog::stdout_color_mt("console");
-    spdlog::set_level(spdlog::level::debug);
+    spdlog::set_level(spdlog::level::trace);
   }
-  spdlog::debug(__func__);
 
-  Message::DefaultMessenger()->Printers().First()->SetTraceLevel(Message_Trace);
-  Handle(Message_PrinterSystemLog) aJSConsolePrinter =
-      new Message_PrinterSystemLog("webgl-sample", Message_Trace);
-  Message::DefaultMessenger()->AddPrinter(
-      aJSConsolePrinter);  // open JavaScript console within the Browser to see
-                           // this output
-  Message::SendTrace() << "Emscripten SDK " << __EMSCRIPTEN_major__ << "."
-                       << __EMSCRIPTEN_minor__ << "." << __EMSCRIPTEN_tiny__;
+  // OCCT messages go through the log, open JavaScript console within
+  // the Browser to see warnings and failures, or call Module.dumpLog()
+  Message::DefaultMessenger()->RemovePrinters(
+      STANDARD_TYPE(Message_PrinterOStream));
+  Message::DefaultMessenger()->AddPrinter(new WasmLogPrinter());
+  WASM_LOG_TRACE("Emscripten SDK {}.{}.{}", __EMSCRIPTEN_major__,
+                 __EMSCRIPTEN_minor__, __EMSCRIPTEN_tiny__);
 #if defined(__LP64__)
-  Message::SendTrace() << "Architecture: WASM 64-bit";
+  WASM_LOG_TRACE("Architecture: WASM 64-bit");
 #else
-  Message::SendTrace() << "Architecture: WASM 32-bit";
+  WASM_LOG_TRACE("Architecture: WASM 32-bit");
 #endif
-  Message::SendTrace() << "NbLogicalProcessors: "
-                       << OSD_Parallel::NbLogicalProcessors()
 #ifdef __EMSCRIPTEN_PTHREADS__
-                       << " (pthreads ON)"
+  [[maybe_unused]] const char* aPthreads = "ON";
 #else
-                       << " (pthreads OFF)"
+  [[maybe_unused]] const char* aPthreads = "OFF";
 #endif
-      ;
+  WASM_LOG_TRACE("NbLogicalProcessors: {} (pthreads {})",
+                 OSD_Parallel::NbLogicalProcessors(), aPthreads);
 
   // setup a dummy single-shot main loop callback just to shut up a useless
   // Emscripten error message on calling eglSwapInterval()
@@ -78,6 +77,6 @@ EMSCRIPTEN_KEEPALIVE int main() {
 
   WasmOcctView& aViewer = WasmOcctView::Instance();
   aViewer.run();
-  Message::DefaultMessenger()->Send(OSD_MemInfo::PrintInfo(), Message_Trace);
+  WASM_LOG_DEBUG("{}", OSD_MemInfo::PrintInfo().ToCString());
   return 0;
 }
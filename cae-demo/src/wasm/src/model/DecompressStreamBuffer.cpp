@@ -0,0 +1,276 @@
+#include "DecompressStreamBuffer.h"
+
+#include <zlib.h>
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+//! Codec state.
+struct DecompressStreamBuffer::Decoder {
+  z_stream Zlib;
+  size_t ZlibInLeft = 0;  //!< input not yet passed to zlib
+  bool IsZlibInit = false;
+  bool IsStreamEnd = false;  //!< whole input is decoded
+#ifdef HAVE_ZSTD
+  ZSTD_DStream* Zstd = nullptr;
+  ZSTD_inBuffer ZstdIn = {nullptr, 0, 0};
+#endif
+
+  //! Pass the next slice of input to zlib, which counts input in uInt,
+  //! once the previous one is consumed.
+  void FeedZlib() {
+    if (Zlib.avail_in == 0 && ZlibInLeft != 0) {
+      const size_t aSlice = std::min(ZlibInLeft, size_t(UINT_MAX));
+      Zlib.avail_in = uInt(aSlice);
+      ZlibInLeft -= aSlice;
+    }
+  }
+
+  ~Decoder() {
+    if (IsZlibInit) {
+      inflateEnd(&Zlib);
+    }
+#ifdef HAVE_ZSTD
+    if (Zstd != nullptr) {
+      ZSTD_freeDStream(Zstd);
+    }
+#endif
+  }
+};
+
+// ================================================================
+// Function : DetectCodec
+// Purpose  :
+// ================================================================
+DecompressStreamBuffer::Codec DecompressStreamBuffer::DetectCodec(
+    const char* theData, size_t theLen) {
+  const unsigned char* aBytes = reinterpret_cast<const unsigned char*>(theData);
+  if (theLen >= 2 && aBytes[0] == 0x1F && aBytes[1] == 0x8B) {
+    return Codec_Gzip;
+  }
+  if (theLen >= 4 && aBytes[0] == 0x28 && aBytes[1] == 0xB5 &&
+      aBytes[2] == 0x2F && aBytes[3] == 0xFD) {
+    return Codec_Zstd;
+  }
+  return Codec_None;
+}
+
+// ================================================================
+// Function : StripCodecExtension
+// Purpose  :
+// ================================================================
+std::string DecompressStreamBuffer::StripCodecExtension(
+    const std::string& theName) {
+  for (const char* anExt : {".gz", ".zst"}) {
+    const size_t anExtLen = ::strlen(anExt);
+    if (theName.size() > anExtLen &&
+        theName.compare(theName.size() - anExtLen, anExtLen, anExt) == 0) {
+      return theName.substr(0, theName.size() - anExtLen);
+    }
+  }
+  return theName;
+}
+
+// ================================================================
+// Function : DecompressStreamBuffer
+// Purpose  :
+// ================================================================
+DecompressStreamBuffer::DecompressStreamBuffer(const char* theData,
+                                               size_t theLen,
+                                               size_t theChunkSize)
+    : myData(theData),
+      myLen(theLen),
+      myCodec(DetectCodec(theData, theLen)),
+      myChunkSize(theChunkSize),
+      myNbProduced(0),
+      myIsGood(true) {
+  if (myCodec == Codec_None) {
+    // expose data as is
+    char* aData = const_cast<char*>(theData);
+    setg(aData, aData, aData + theLen);
+    myNbProduced = theLen;
+    return;
+  }
+
+  myDecoder.reset(new Decoder());
+  myChunk.reset(new char[myChunkSize]);
+  resetDecoder();
+}
+
+// ================================================================
+// Function : resetDecoder
+// Purpose  :
+// ================================================================
+void DecompressStreamBuffer::resetDecoder() {
+  myNbProduced = 0;
+  myDecoder->IsStreamEnd = false;
+  setg(myChunk.get(), myChunk.get(), myChunk.get());
+  if (myCodec == Codec_Gzip) {
+    if (myDecoder->IsZlibInit) {
+      inflateEnd(&myDecoder->Zlib);
+    }
+    std::memset(&myDecoder->Zlib, 0, sizeof(z_stream));
+    myDecoder->Zlib.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(myData));
+    myDecoder->ZlibInLeft = myLen;
+    myDecoder->FeedZlib();
+    // 15 + 32 - max window with automatic gzip/zlib header detection
+    myIsGood = inflateInit2(&myDecoder->Zlib, 15 + 32) == Z_OK;
+    myDecoder->IsZlibInit = myIsGood;
+  } else {
+#ifdef HAVE_ZSTD
+    if (myDecoder->Zstd == nullptr) {
+      myDecoder->Zstd = ZSTD_createDStream();
+    }
+    myIsGood = myDecoder->Zstd != nullptr &&
+               !ZSTD_isError(ZSTD_initDStream(myDecoder->Zstd));
+    myDecoder->ZstdIn = {myData, myLen, 0};
+#else
+    myIsGood = false;
+#endif
+  }
+}
+
+// ================================================================
+// Function : ~DecompressStreamBuffer
+// Purpose  :
+// ================================================================
+DecompressStreamBuffer::~DecompressStreamBuffer() {}
+
+// ================================================================
+// Function : inflateChunk
+// Purpose  :
+// ================================================================
+size_t DecompressStreamBuffer::inflateChunk() {
+  if (!myIsGood || myDecoder->IsStreamEnd) {
+    return 0;
+  }
+
+  if (myCodec == Codec_Gzip) {
+    z_stream& aZlib = myDecoder->Zlib;
+    aZlib.next_out = reinterpret_cast<Bytef*>(myChunk.get());
+    aZlib.avail_out = uInt(myChunkSize);
+    while (aZlib.avail_out != 0) {
+      myDecoder->FeedZlib();
+      const int aRes = inflate(&aZlib, Z_NO_FLUSH);
+      if (aRes == Z_STREAM_END) {
+        if (aZlib.avail_in == 0 && myDecoder->ZlibInLeft == 0) {
+          myDecoder->IsStreamEnd = true;
+          break;
+        }
+        // concatenated gzip members are allowed by the format
+        if (inflateReset(&aZlib) != Z_OK) {
+          myIsGood = false;
+          break;
+        }
+      } else if (aRes != Z_OK) {
+        // Z_BUF_ERROR with free output space means that input ends
+        // before the end of the stream - truncated data
+        myIsGood = false;
+        break;
+      }
+    }
+    return myChunkSize - aZlib.avail_out;
+  }
+
+#ifdef HAVE_ZSTD
+  ZSTD_outBuffer anOut = {myChunk.get(), myChunkSize, 0};
+  ZSTD_inBuffer& anIn = myDecoder->ZstdIn;
+  while (anOut.pos < anOut.size) {
+    const size_t aRes = ZSTD_decompressStream(myDecoder->Zstd, &anOut, &anIn);
+    if (ZSTD_isError(aRes)) {
+      myIsGood = false;
+      break;
+    }
+    if (anIn.pos == anIn.size && anOut.pos < anOut.size) {
+      // output is not full, so the decoder has flushed everything it holds;
+      // non-zero result at the end of input means truncated frame
+      myIsGood = aRes == 0;
+      myDecoder->IsStreamEnd = true;
+      break;
+    }
+  }
+  return anOut.pos;
+#else
+  return 0;
+#endif
+}
+
+// ================================================================
+// Function : underflow
+// Purpose  :
+// ================================================================
+DecompressStreamBuffer::int_type DecompressStreamBuffer::underflow() {
+  if (gptr() < egptr()) {
+    return traits_type::to_int_type(*gptr());
+  }
+  if (myCodec == Codec_None) {
+    return traits_type::eof();
+  }
+
+  const size_t aNbBytes = inflateChunk();
+  if (aNbBytes == 0) {
+    return traits_type::eof();
+  }
+  myNbProduced += aNbBytes;
+  setg(myChunk.get(), myChunk.get(), myChunk.get() + aNbBytes);
+  return traits_type::to_int_type(*gptr());
+}
+
+// ================================================================
+// Function : seekoff
+// Purpose  :
+// ================================================================
+DecompressStreamBuffer::pos_type DecompressStreamBuffer::seekoff(
+    off_type theOff, std::ios_base::seekdir theDir,
+    std::ios_base::openmode theMode) {
+  off_type aTarget = theOff;
+  if (theDir == std::ios_base::cur) {
+    aTarget += off_type(myNbProduced - size_t(egptr() - gptr()));
+  } else if (theDir == std::ios_base::end) {
+    if (myCodec != Codec_None) {
+      return pos_type(off_type(-1));
+    }
+    aTarget += off_type(myLen);
+  }
+  return seekpos(pos_type(aTarget), theMode);
+}
+
+// ================================================================
+// Function : seekpos
+// Purpose  :
+// ================================================================
+DecompressStreamBuffer::pos_type DecompressStreamBuffer::seekpos(
+    pos_type thePos, std::ios_base::openmode theMode) {
+  const off_type aTarget = off_type(thePos);
+  if ((theMode & std::ios_base::in) == 0 || aTarget < 0 ||
+      (aTarget > off_type(myNbProduced) && myCodec == Codec_None)) {
+    return pos_type(off_type(-1));
+  }
+
+  // position within the current chunk
+  const size_t aChunkStart = myNbProduced - size_t(egptr() - eback());
+  if (size_t(aTarget) < aChunkStart) {
+    resetDecoder();
+  } else if (size_t(aTarget) <= myNbProduced) {
+    setg(eback(), eback() + (size_t(aTarget) - aChunkStart), egptr());
+    return thePos;
+  }
+
+  // skip forward by inflating chunks
+  while (myNbProduced < size_t(aTarget)) {
+    const size_t aNbBytes = inflateChunk();
+    if (aNbBytes == 0) {
+      return pos_type(off_type(-1));
+    }
+    myNbProduced += aNbBytes;
+    setg(myChunk.get(), myChunk.get(), myChunk.get() + aNbBytes);
+  }
+  setg(eback(), egptr() - (myNbProduced - size_t(aTarget)), egptr());
+  return thePos;
+}
@@ -0,0 +1,90 @@
+#ifndef _DecompressStreamBuffer_HeaderFile
+#define _DecompressStreamBuffer_HeaderFile
+
+#include <cstddef>
+#include <memory>
+#include <streambuf>
+#include <string>
+
+//! Read-only stream buffer over in-memory model data, which may be
+//! compressed. Compressed data (gzip or zstd) is inflated on demand chunk by
+//! chunk while the consumer reads, so the whole decompressed file is never
+//! held in memory. Uncompressed data is exposed directly without copying.
+//!
+//! Seeking is supported, as required by binary BRep reader. Within
+//! compressed data, seeking backward out of the current chunk restarts
+//! decompression from the beginning, so it is expensive.
+class DecompressStreamBuffer : public std::streambuf {
+ public:
+  //! Compression codec.
+  enum Codec {
+    Codec_None,  //!< plain data
+    Codec_Gzip,  //!< gzip or zlib stream
+    Codec_Zstd,  //!< zstd frame
+  };
+
+  //! Detect codec from magic number.
+  static Codec DetectCodec(const char* theData, size_t theLen);
+
+  //! Return name without compression extension (".gz", ".zst").
+  static std::string StripCodecExtension(const std::string& theName);
+
+ public:
+  //! Main constructor.
+  //! @param theData      [in] data, should be kept alive while reading
+  //! @param theLen       [in] data length
+  //! @param theChunkSize [in] size of decompressed chunk
+  DecompressStreamBuffer(const char* theData, size_t theLen,
+                         size_t theChunkSize = 256 * 1024);
+
+  //! Destructor.
+  virtual ~DecompressStreamBuffer();
+
+  //! Return detected codec.
+  Codec CodecType() const { return myCodec; }
+
+  //! Return FALSE if codec is not supported by this build
+  //! or compressed data is corrupted.
+  bool IsGood() const { return myIsGood; }
+
+  //! Return number of decompressed bytes produced so far.
+  size_t NbProduced() const { return myNbProduced; }
+
+ protected:
+  //! Decompress next chunk.
+  virtual int_type underflow() override;
+
+  //! Seek relative to the beginning, current position or end.
+  //! Seeking relative to the end is unsupported for compressed data.
+  virtual pos_type seekoff(off_type theOff, std::ios_base::seekdir theDir,
+                           std::ios_base::openmode theMode) override;
+
+  //! Seek to absolute position.
+  virtual pos_type seekpos(pos_type thePos,
+                           std::ios_base::openmode theMode) override;
+
+ private:
+  //! Restart decompression from the beginning of data.
+  void resetDecoder();
+
+  //! Decompress next chunk into myChunk.
+  //! @return number of produced bytes, 0 at the end of data or on error
+  size_t inflateChunk();
+
+  DecompressStreamBuffer(const DecompressStreamBuffer&) = delete;
+  DecompressStreamBuffer& operator=(const DecompressStreamBuffer&) = delete;
+
+ private:
+  struct Decoder;
+
+  const char* myData;               //!< input data
+  size_t myLen;                     //!< input data length
+  Codec myCodec;                    //!< detected codec
+  std::unique_ptr<Decoder> myDecoder;  //!< codec state
+  std::unique_ptr<char[]> myChunk;  //!< decompressed chunk
+  size_t myChunkSize;               //!< decompressed chunk capacity
+  size_t myNbProduced;              //!< decompressed bytes produced so far
+  bool myIsGood;                    //!< codec state is valid
+};
+
+#endif  // _DecompressStreamBuffer_HeaderFile
@@ -0,0 +1,468 @@
+#include "FeIsoExtractor.h"
+
+#include <OSD_Parallel.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+//! Number of cells processed by a single task.
+static const int THE_CHUNK_CELLS = 1 << 16;
+
+//! Return average of points.
+FeIsoPoint averagePoint(const FeIsoPoint* thePoints, int theNbPoints) {
+  FeIsoPoint aResult = {0.0f, 0.0f, 0.0f, 0.0f};
+  for (int aPntIter = 0; aPntIter < theNbPoints; ++aPntIter) {
+    aResult.X += thePoints[aPntIter].X;
+    aResult.Y += thePoints[aPntIter].Y;
+    aResult.Z += thePoints[aPntIter].Z;
+    aResult.Value += thePoints[aPntIter].Value;
+  }
+  const float aScale = 1.0f / float(theNbPoints);
+  return {aResult.X * aScale, aResult.Y * aScale, aResult.Z * aScale,
+          aResult.Value * aScale};
+}
+
+//! Append interpolated point of the edge crossed by the value.
+void addEdgePoint(const FeIsoPoint& thePnt1, const FeIsoPoint& thePnt2,
+                  float theValue, std::vector<float>& thePositions) {
+  const float aT = thePnt1.Value != thePnt2.Value
+                       ? (theValue - thePnt1.Value) /
+                             (thePnt2.Value - thePnt1.Value)
+                       : 0.5f;
+  thePositions.push_back(thePnt1.X + (thePnt2.X - thePnt1.X) * aT);
+  thePositions.push_back(thePnt1.Y + (thePnt2.Y - thePnt1.Y) * aT);
+  thePositions.push_back(thePnt1.Z + (thePnt2.Z - thePnt1.Z) * aT);
+}
+
+//! Append isosurface triangles of the tetrahedron.
+void addTetrahedron(const FeIsoPoint* theCorners, float theValue,
+                    std::vector<float>& thePositions) {
+  const FeIsoPoint* anAbove[4];
+  const FeIsoPoint* aBelow[4];
+  int aNbAbove = 0, aNbBelow = 0;
+  for (int aCornerIter = 0; aCornerIter < 4; ++aCornerIter) {
+    if (theCorners[aCornerIter].Value >= theValue) {
+      anAbove[aNbAbove++] = &theCorners[aCornerIter];
+    } else {
+      aBelow[aNbBelow++] = &theCorners[aCornerIter];
+    }
+  }
+
+  if (aNbAbove == 1 || aNbBelow == 1) {
+    // single corner is cut off by a triangle
+    const FeIsoPoint* aCorner = aNbAbove == 1 ? anAbove[0] : aBelow[0];
+    const FeIsoPoint* const* anOthers = aNbAbove == 1 ? aBelow : anAbove;
+    for (int anOtherIter = 0; anOtherIter < 3; ++anOtherIter) {
+      addEdgePoint(*aCorner, *anOthers[anOtherIter], theValue, thePositions);
+    }
+  } else if (aNbAbove == 2) {
+    // quadrangle between two pairs of corners is split into triangles
+    const FeIsoPoint* aQuad[4][2] = {{anAbove[0], aBelow[0]},
+                                     {anAbove[0], aBelow[1]},
+                                     {anAbove[1], aBelow[1]},
+                                     {anAbove[1], aBelow[0]}};
+    for (const int aCorner : {0, 1, 2, 0, 2, 3}) {
+      addEdgePoint(*aQuad[aCorner][0], *aQuad[aCorner][1], theValue,
+                   thePositions);
+    }
+  }
+}
+
+//! Clip polygon keeping the part with values above (or below) the bound.
+int clipPolygon(const FeIsoPoint* thePoints, int theNbPoints, float theBound,
+                bool theToKeepAbove, FeIsoPoint* theResult) {
+  int aNbResult = 0;
+  for (int aPntIter = 0; aPntIter < theNbPoints; ++aPntIter) {
+    const FeIsoPoint& aCurr = thePoints[aPntIter];
+    const FeIsoPoint& aNext = thePoints[(aPntIter + 1) % theNbPoints];
+    const bool isCurrIn = theToKeepAbove ? aCurr.Value >= theBound
+                                         : aCurr.Value <= theBound;
+    const bool isNextIn = theToKeepAbove ? aNext.Value >= theBound
+                                         : aNext.Value <= theBound;
+    if (isCurrIn) {
+      theResult[aNbResult++] = aCurr;
+    }
+    if (isCurrIn != isNextIn) {
+      const float aT = (theBound - aCurr.Value) / (aNext.Value - aCurr.Value);
+      theResult[aNbResult++] = {aCurr.X + (aNext.X - aCurr.X) * aT,
+                                aCurr.Y + (aNext.Y - aCurr.Y) * aT,
+                                aCurr.Z + (aNext.Z - aCurr.Z) * aT,
+                                theBound};
+    }
+  }
+  return aNbResult;
+}
+
+//! Run functor over chunks of cells in parallel and concatenate results
+//! in the order of chunks.
+template <typename Func_t>
+void forEachChunk(int theNbCells, FeIsoGeometry& theResult, Func_t theFunc) {
+  const int aNbChunks = (theNbCells + THE_CHUNK_CELLS - 1) / THE_CHUNK_CELLS;
+  std::vector<FeIsoGeometry> aChunks((size_t)aNbChunks);
+  OSD_Parallel::For(0, aNbChunks, [&](int theChunk) {
+    std::vector<int> aCells;
+    const int aFrom = theChunk * THE_CHUNK_CELLS;
+    theFunc(aFrom, std::min(aFrom + THE_CHUNK_CELLS, theNbCells), aCells,
+            aChunks[theChunk]);
+  });
+
+  theResult = FeIsoGeometry();
+  for (const FeIsoGeometry& aChunk : aChunks) {
+    theResult.Positions.insert(theResult.Positions.end(),
+                               aChunk.Positions.begin(),
+                               aChunk.Positions.end());
+    theResult.Levels.insert(theResult.Levels.end(), aChunk.Levels.begin(),
+                            aChunk.Levels.end());
+  }
+}
+}  // namespace
+
+// ================================================================
+// Function : FindActiveCells
+// Purpose  :
+// ================================================================
+void FeIsoExtractor::FindActiveCells(const float* theMin, const float* theMax,
+                                     int theFrom, int theTo, float theValue,
+                                     std::vector<int>& theCells) {
+  int aCell = theFrom;
+#if defined(__wasm_simd128__)
+  const v128_t aValue = wasm_f32x4_splat(theValue);
+  for (; aCell + 4 <= theTo; aCell += 4) {
+    const v128_t anIsActive =
+        wasm_v128_and(wasm_f32x4_le(wasm_v128_load(theMin + aCell), aValue),
+                      wasm_f32x4_ge(wasm_v128_load(theMax + aCell), aValue));
+    for (int aBits = wasm_i32x4_bitmask(anIsActive); aBits != 0;
+         aBits &= aBits - 1) {
+      theCells.push_back(aCell + __builtin_ctz(aBits));
+    }
+  }
+#elif defined(__SSE2__)
+  const __m128 aValue = _mm_set1_ps(theValue);
+  for (; aCell + 4 <= theTo; aCell += 4) {
+    const __m128 anIsActive =
+        _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(theMin + aCell), aValue),
+                   _mm_cmpge_ps(_mm_loadu_ps(theMax + aCell), aValue));
+    for (int aBits = _mm_movemask_ps(anIsActive); aBits != 0;
+         aBits &= aBits - 1) {
+      theCells.push_back(aCell + __builtin_ctz(aBits));
+    }
+  }
+#endif
+  for (; aCell < theTo; ++aCell) {
+    if (theMin[aCell] <= theValue && theMax[aCell] >= theValue) {
+      theCells.push_back(aCell);
+    }
+  }
+}
+
+// ================================================================
+// Function : FeIsoExtractor
+// Purpose  :
+// ================================================================
+FeIsoExtractor::FeIsoExtractor(const Handle(FeMesh) & theMesh,
+                               const FeMeshSkin& theSkin)
+    : myMesh(theMesh) {
+  myBlockFirst.push_back(0);
+  for (const FeElementBlock& aBlock : myMesh->Blocks) {
+    myBlockFirst.push_back(myBlockFirst.back() + aBlock.NbElements());
+  }
+  mySkinTriangles.reserve(theSkin.Triangles.size());
+  for (const int aVert : theSkin.Triangles) {
+    mySkinTriangles.push_back(theSkin.Nodes[aVert]);
+  }
+}
+
+// ================================================================
+// Function : SetScalars
+// Purpose  :
+// ================================================================
+bool FeIsoExtractor::SetScalars(const float* theValues, size_t theNbValues,
+                                int theNbComponents,
+                                FeResultLocation theLocation) {
+  const FeMesh& aMesh = *myMesh;
+  const size_t aNbItems = size_t(theLocation == FeResultLocation_Node
+                                     ? aMesh.NbNodes()
+                                     : aMesh.NbElements());
+  if (theNbComponents <= 0 ||
+      theNbValues != aNbItems * size_t(theNbComponents)) {
+    return false;
+  }
+
+  const float anInf = std::numeric_limits<float>::infinity();
+  myScalars.assign(size_t(aMesh.NbNodes()), 0.0f);
+  if (theLocation == FeResultLocation_Node) {
+    for (size_t aNodeIter = 0; aNodeIter < myScalars.size(); ++aNodeIter) {
+      myScalars[aNodeIter] =
+          FeColormap::Scalar(theValues, aNodeIter, theNbComponents);
+    }
+  } else {
+    std::vector<int> aCounts(myScalars.size(), 0);
+    size_t anElem = 0;
+    for (const FeElementBlock& aBlock : aMesh.Blocks) {
+      for (size_t aNodeIter = 0; aNodeIter < aBlock.Nodes.size();) {
+        const float aScalar =
+            FeColormap::Scalar(theValues, anElem++, theNbComponents);
+        const size_t aNodeEnd =
+            aNodeIter + size_t(FeMesh::NbElementNodes(aBlock.Type));
+        for (; aNodeIter < aNodeEnd; ++aNodeIter) {
+          myScalars[aBlock.Nodes[aNodeIter]] += aScalar;
+          ++aCounts[aBlock.Nodes[aNodeIter]];
+        }
+      }
+    }
+    for (size_t aNodeIter = 0; aNodeIter < myScalars.size(); ++aNodeIter) {
+      myScalars[aNodeIter] = aCounts[aNodeIter] > 0
+                                 ? myScalars[aNodeIter] / aCounts[aNodeIter]
+                                 : NAN;
+    }
+  }
+
+  myRange = FeResultRange{anInf, -anInf};
+  for (const float aScalar : myScalars) {
+    if (!std::isnan(aScalar)) {
+      myRange.Min = std::min(myRange.Min, aScalar);
+      myRange.Max = std::max(myRange.Max, aScalar);
+    }
+  }
+
+  // surface elements are never crossed by isosurfaces
+  myCellMin.assign(size_t(aMesh.NbElements()), anInf);
+  myCellMax.assign(size_t(aMesh.NbElements()), -anInf);
+  size_t anElem = 0;
+  for (const FeElementBlock& aBlock : aMesh.Blocks) {
+    const int aNbElemNodes = FeMesh::NbElementNodes(aBlock.Type);
+    for (size_t aNodeIter = 0; aNodeIter < aBlock.Nodes.size();
+         aNodeIter += size_t(aNbElemNodes), ++anElem) {
+      if (!FeMesh::IsVolume(aBlock.Type)) {
+        continue;
+      }
+      for (int aCornerIter = 0; aCornerIter < aNbElemNodes; ++aCornerIter) {
+        const float aScalar = myScalars[aBlock.Nodes[aNodeIter + aCornerIter]];
+        myCellMin[anElem] = std::min(myCellMin[anElem], aScalar);
+        myCellMax[anElem] = std::max(myCellMax[anElem], aScalar);
+      }
+    }
+  }
+
+  const size_t aNbTris = mySkinTriangles.size() / 3;
+  myTriMin.resize(aNbTris);
+  myTriMax.resize(aNbTris);
+  for (size_t aTriIter = 0; aTriIter < aNbTris; ++aTriIter) {
+    const int* aNodes = mySkinTriangles.data() + aTriIter * 3;
+    const float aScalars[3] = {myScalars[aNodes[0]], myScalars[aNodes[1]],
+                               myScalars[aNodes[2]]};
+    myTriMin[aTriIter] = std::min({aScalars[0], aScalars[1], aScalars[2]});
+    myTriMax[aTriIter] = std::max({aScalars[0], aScalars[1], aScalars[2]});
+  }
+  return true;
+}
+
+// ================================================================
+// Function : SetDisplacements
+// Purpose  :
+// ================================================================
+bool FeIsoExtractor::SetDisplacements(const float* theValues,
+                                      size_t theNbValues, float theScale) {
+  if (theNbValues != size_t(myMesh->NbNodes()) * 3) {
+    return false;
+  }
+  myDisplacements.resize(theNbValues);
+  for (size_t aValIter = 0; aValIter < theNbValues; ++aValIter) {
+    myDisplacements[aValIter] = theValues[aValIter] * theScale;
+  }
+  return true;
+}
+
+// ================================================================
+// Function : nodePoint
+// Purpose  :
+// ================================================================
+FeIsoPoint FeIsoExtractor::nodePoint(int theNode) const {
+  const FeMesh& aMesh = *myMesh;
+  FeIsoPoint aPnt = {aMesh.X[theNode], aMesh.Y[theNode], aMesh.Z[theNode],
+                     myScalars[theNode]};
+  if (!myDisplacements.empty()) {
+    const float* aDisp = myDisplacements.data() + size_t(theNode) * 3;
+    aPnt.X += aDisp[0];
+    aPnt.Y += aDisp[1];
+    aPnt.Z += aDisp[2];
+  }
+  return aPnt;
+}
+
+// ================================================================
+// Function : addElement
+// Purpose  :
+// ================================================================
+void FeIsoExtractor::addElement(const FeElementBlock& theBlock,
+                                const int* theNodes, float theValue,
+                                std::vector<float>& thePositions) const {
+  FeIsoPoint aCorners[8];
+  const int aNbCorners = FeMesh::NbElementNodes(theBlock.Type);
+  for (int aCornerIter = 0; aCornerIter < aNbCorners; ++aCornerIter) {
+    aCorners[aCornerIter] = nodePoint(theNodes[aCornerIter]);
+  }
+  if (theBlock.Type == FeElementType_Tet4) {
+    addTetrahedron(aCorners, theValue, thePositions);
+    return;
+  }
+
+  // faces are connected with the element center; quadrangles are split at
+  // their centers instead of a diagonal, which depends on the node order
+  const FeIsoPoint aCenter = averagePoint(aCorners, aNbCorners);
+  for (int aFaceIter = 0; aFaceIter < FeMesh::NbElementFaces(theBlock.Type);
+       ++aFaceIter) {
+    const int* aFace = FeMesh::ElementFace(theBlock.Type, aFaceIter);
+    if (aFace[3] < 0) {
+      const FeIsoPoint aTet[4] = {aCorners[aFace[0]], aCorners[aFace[1]],
+                                  aCorners[aFace[2]], aCenter};
+      addTetrahedron(aTet, theValue, thePositions);
+      continue;
+    }
+
+    const FeIsoPoint aQuad[4] = {aCorners[aFace[0]], aCorners[aFace[1]],
+                                 aCorners[aFace[2]], aCorners[aFace[3]]};
+    const FeIsoPoint aFaceCenter = averagePoint(aQuad, 4);
+    for (int anEdgeIter = 0; anEdgeIter < 4; ++anEdgeIter) {
+      const FeIsoPoint aTet[4] = {aQuad[anEdgeIter],
+                                  aQuad[(anEdgeIter + 1) % 4], aFaceCenter,
+                                  aCenter};
+      addTetrahedron(aTet, theValue, thePositions);
+    }
+  }
+}
+
+// ================================================================
+// Function : Isosurface
+// Purpose  :
+// ================================================================
+void FeIsoExtractor::Isosurface(float theValue,
+                                FeIsoGeometry& theResult) const {
+  forEachChunk(
+      int(myCellMin.size()), theResult,
+      [&](int theFrom, int theTo, std::vector<int>& theCells,
+          FeIsoGeometry& theChunk) {
+        FindActiveCells(myCellMin.data(), myCellMax.data(), theFrom, theTo,
+                        theValue, theCells);
+        for (const int aCell : theCells) {
+          const size_t aBlockIndex =
+              size_t(std::upper_bound(myBlockFirst.begin(),
+                                      myBlockFirst.end(), aCell) -
+                     myBlockFirst.begin()) -
+              1;
+          const FeElementBlock& aBlock = myMesh->Blocks[aBlockIndex];
+          const int* aNodes =
+              aBlock.Nodes.data() +
+              size_t(aCell - myBlockFirst[aBlockIndex]) *
+                  FeMesh::NbElementNodes(aBlock.Type);
+          addElement(aBlock, aNodes, theValue, theChunk.Positions);
+        }
+        theChunk.Levels.assign(theChunk.Positions.size() / 9, 0);
+      });
+}
+
+// ================================================================
+// Function : IsoLines
+// Purpose  :
+// ================================================================
+void FeIsoExtractor::IsoLines(const std::vector<float>& theValues,
+                              FeIsoGeometry& theResult) const {
+  forEachChunk(
+      int(myTriMin.size()), theResult,
+      [&](int theFrom, int theTo, std::vector<int>& theCells,
+          FeIsoGeometry& theChunk) {
+        for (size_t aLevel = 0; aLevel < theValues.size(); ++aLevel) {
+          const float aValue = theValues[aLevel];
+          theCells.clear();
+          FindActiveCells(myTriMin.data(), myTriMax.data(), theFrom, theTo,
+                          aValue, theCells);
+          for (const int aTri : theCells) {
+            const int* aNodes = mySkinTriangles.data() + size_t(aTri) * 3;
+            int aNbPoints = 0;
+            for (int anEdgeIter = 0; anEdgeIter < 3; ++anEdgeIter) {
+              const int aNode1 = aNodes[anEdgeIter];
+              const int aNode2 = aNodes[(anEdgeIter + 1) % 3];
+              if ((myScalars[aNode1] >= aValue) !=
+                      (myScalars[aNode2] >= aValue) &&
+                  aNbPoints < 2) {
+                addEdgePoint(nodePoint(aNode1), nodePoint(aNode2), aValue,
+                             theChunk.Positions);
+                ++aNbPoints;
+              }
+            }
+            if (aNbPoints == 2) {
+              theChunk.Levels.push_back(int(aLevel));
+            } else {
+              theChunk.Positions.resize(theChunk.Positions.size() -
+                                        size_t(aNbPoints) * 3);
+            }
+          }
+        }
+      });
+}
+
+// ================================================================
+// Function : ContourBands
+// Purpose  :
+// ================================================================
+void FeIsoExtractor::ContourBands(const std::vector<float>& theValues,
+                                  FeIsoGeometry& theResult) const {
+  const auto aBandOf = [&theValues](float theValue) {
+    return int(std::upper_bound(theValues.begin(), theValues.end(),
+                                theValue) -
+               theValues.begin());
+  };
+  forEachChunk(
+      int(myTriMin.size()), theResult,
+      [&](int theFrom, int theTo, std::vector<int>&,
+          FeIsoGeometry& theChunk) {
+        for (int aTri = theFrom; aTri < theTo; ++aTri) {
+          if (std::isnan(myTriMin[aTri]) || std::isnan(myTriMax[aTri])) {
+            continue;
+          }
+
+          FeIsoPoint aTriangle[3];
+          for (int aCornerIter = 0; aCornerIter < 3; ++aCornerIter) {
+            aTriangle[aCornerIter] =
+                nodePoint(mySkinTriangles[size_t(aTri) * 3 + aCornerIter]);
+          }
+
+          // triangle within a single band is kept as is, others are
+          // clipped by bounds of every crossed band
+          const int aBandFrom = aBandOf(myTriMin[aTri]);
+          const int aBandTo = aBandOf(myTriMax[aTri]);
+          for (int aBand = aBandFrom; aBand <= aBandTo; ++aBand) {
+            FeIsoPoint aClipped[5], aPolygon[5];
+            int aNbPoints = 3;
+            std::copy(aTriangle, aTriangle + 3, aPolygon);
+            if (aBand > aBandFrom) {
+              aNbPoints = clipPolygon(aPolygon, aNbPoints,
+                                      theValues[aBand - 1], true, aClipped);
+              std::copy(aClipped, aClipped + aNbPoints, aPolygon);
+            }
+            if (aBand < aBandTo) {
+              aNbPoints = clipPolygon(aPolygon, aNbPoints, theValues[aBand],
+                                      false, aClipped);
+              std::copy(aClipped, aClipped + aNbPoints, aPolygon);
+            }
+            for (int aPntIter = 1; aPntIter + 1 < aNbPoints; ++aPntIter) {
+              for (const FeIsoPoint* aPnt :
+                   {&aPolygon[0], &aPolygon[aPntIter],
+                    &aPolygon[aPntIter + 1]}) {
+                theChunk.Positions.insert(theChunk.Positions.end(),
+                                          {aPnt->X, aPnt->Y, aPnt->Z});
+              }
+              theChunk.Levels.push_back(aBand);
+            }
+          }
+        }
+      });
+}
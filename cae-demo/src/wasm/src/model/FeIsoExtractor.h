@@ -0,0 +1,118 @@
+#ifndef _FeIsoExtractor_HeaderFile
+#define _FeIsoExtractor_HeaderFile
+
+#include <Standard_Transient.hxx>
+
+#include <vector>
+
+#include "FeMesh.h"
+
+//! Geometry extracted from a scalar field as vertex soup:
+//! triangles of isosurfaces and contour bands, or segments of iso-lines.
+struct FeIsoGeometry {
+  std::vector<float> Positions;  //!< XYZ of vertices
+  std::vector<int> Levels;  //!< band or level index of every primitive
+
+  //! Return number of vertices.
+  int NbVertices() const { return int(Positions.size() / 3); }
+};
+
+//! Point with interpolated scalar value.
+struct FeIsoPoint {
+  float X, Y, Z, Value;
+};
+
+//! Extraction of isosurfaces, iso-lines and contour bands from nodal
+//! scalars of a finite-element mesh.
+//!
+//! Value ranges of volume elements and skin triangles are computed once per
+//! field, so that extraction at a new value scans only these arrays to find
+//! cells crossed by it; the scan uses SIMD128 instructions in WebAssembly
+//! builds with SIMD enabled, SSE2 in native builds, and scalar code
+//! otherwise. Cells are processed by chunks in parallel where threads are
+//! available.
+//!
+//! Volume elements are split into tetrahedra connecting their faces with
+//! the element center; quadrangular faces are split at their centers. Centers
+//! take averaged positions and values of their nodes, so that neighbouring
+//! elements split their common face the same way whatever their node order,
+//! and isosurfaces have no cracks. Extracted geometry follows nodal
+//! displacements set by SetDisplacements().
+class FeIsoExtractor : public Standard_Transient {
+  DEFINE_STANDARD_RTTI_INLINE(FeIsoExtractor, Standard_Transient)
+ public:
+  //! Append indices of cells within [theFrom, theTo) which range contains
+  //! the value.
+  static void FindActiveCells(const float* theMin, const float* theMax,
+                              int theFrom, int theTo, float theValue,
+                              std::vector<int>& theCells);
+
+ public:
+  //! Main constructor.
+  //! @param theMesh [in] mesh
+  //! @param theSkin [in] skin of the mesh for iso-lines and contour bands
+  FeIsoExtractor(const Handle(FeMesh) & theMesh, const FeMeshSkin& theSkin);
+
+  //! Set scalar field; element values are averaged at nodes.
+  //! @param theValues       [in] theNbComponents values per node or element
+  //! @param theNbValues     [in] number of values
+  //! @param theNbComponents [in] 1 for scalars, 3 for vectors taken by
+  //!                             magnitude
+  //! @param theLocation     [in] values location
+  //! @return FALSE if number of values does not match the mesh
+  bool SetScalars(const float* theValues, size_t theNbValues,
+                  int theNbComponents, FeResultLocation theLocation);
+
+  //! Return TRUE if scalar field has been set.
+  bool HasScalars() const { return !myScalars.empty(); }
+
+  //! Return range of nodal scalars.
+  const FeResultRange& Range() const { return myRange; }
+
+  //! Set nodal displacements applied to extracted geometry.
+  //! @param theValues   [in] 3 values per node
+  //! @param theNbValues [in] number of values
+  //! @param theScale    [in] displacement scale
+  //! @return FALSE if number of values does not match the mesh
+  bool SetDisplacements(const float* theValues, size_t theNbValues,
+                        float theScale);
+
+  //! Extract geometry of the undeformed mesh.
+  void ClearDisplacements() { myDisplacements.clear(); }
+
+  //! Extract isosurface triangles within volume elements.
+  void Isosurface(float theValue, FeIsoGeometry& theResult) const;
+
+  //! Extract segments of iso-lines on the skin; Levels of the result
+  //! refer to theValues.
+  void IsoLines(const std::vector<float>& theValues,
+                FeIsoGeometry& theResult) const;
+
+  //! Split skin triangles into contour bands between sorted values;
+  //! Levels of the result are band indices, from 0 for values below
+  //! theValues[0] to theValues.size() for values above the last one.
+  void ContourBands(const std::vector<float>& theValues,
+                    FeIsoGeometry& theResult) const;
+
+ private:
+  //! Return displaced position and scalar of the node.
+  FeIsoPoint nodePoint(int theNode) const;
+
+  //! Append isosurface triangles of the volume element.
+  void addElement(const FeElementBlock& theBlock, const int* theNodes,
+                  float theValue, std::vector<float>& thePositions) const;
+
+ private:
+  Handle(FeMesh) myMesh;            //!< mesh
+  std::vector<int> myBlockFirst;    //!< first element index of blocks
+  std::vector<int> mySkinTriangles; //!< mesh nodes of skin triangles
+  std::vector<float> myScalars;     //!< nodal scalars
+  std::vector<float> myDisplacements; //!< scaled nodal displacements
+  std::vector<float> myCellMin;     //!< minimal value of elements
+  std::vector<float> myCellMax;     //!< maximal value of elements
+  std::vector<float> myTriMin;      //!< minimal value of skin triangles
+  std::vector<float> myTriMax;      //!< maximal value of skin triangles
+  FeResultRange myRange;            //!< range of nodal scalars
+};
+
+#endif  // _FeIsoExtractor_HeaderFile
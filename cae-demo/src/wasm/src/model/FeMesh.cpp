@@ -0,0 +1,368 @@
+#include "FeMesh.h"
+
+#include <Message_ProgressScope.hxx>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <numeric>
+
+namespace {
+//! Maximum number of faces matched at once.
+static const size_t THE_PASS_FACES = size_t(1) << 23;
+
+//! Number of bins of the face histogram by smallest node.
+static const int THE_NB_BINS = 1 << 16;
+
+//! Corner indices of element faces; -1 for the missing 4th node.
+struct FeFaceDefs {
+  int NbFaces;
+  int Faces[6][4];
+};
+
+//! Return faces of the element type.
+const FeFaceDefs& faceDefs(FeElementType theType) {
+  static const FeFaceDefs THE_DEFS[6] = {
+      {1, {{0, 1, 2, -1}}},
+      {1, {{0, 1, 2, 3}}},
+      {4, {{0, 1, 2, -1}, {0, 1, 3, -1}, {1, 2, 3, -1}, {0, 2, 3, -1}}},
+      {5,
+       {{0, 1, 2, 3},
+        {0, 1, 4, -1},
+        {1, 2, 4, -1},
+        {2, 3, 4, -1},
+        {3, 0, 4, -1}}},
+      {5,
+       {{0, 1, 2, -1},
+        {3, 4, 5, -1},
+        {0, 1, 4, 3},
+        {1, 2, 5, 4},
+        {2, 0, 3, 5}}},
+      {6,
+       {{0, 1, 2, 3},
+        {4, 5, 6, 7},
+        {0, 1, 5, 4},
+        {1, 2, 6, 5},
+        {2, 3, 7, 6},
+        {3, 0, 4, 7}}}};
+  return THE_DEFS[theType];
+}
+
+//! Face of volume element keyed by its sorted nodes.
+struct FaceKey {
+  int Nodes[4];  //!< sorted node indices, INT_MAX for the missing 4th node
+  uint32_t Ref;  //!< element index * 8 + face index
+
+  bool operator<(const FaceKey& theOther) const {
+    return std::lexicographical_compare(Nodes, Nodes + 4, theOther.Nodes,
+                                        theOther.Nodes + 4);
+  }
+
+  bool IsSame(const FaceKey& theOther) const {
+    return std::equal(Nodes, Nodes + 4, theOther.Nodes);
+  }
+};
+
+//! Call functor for every face of volume elements with face key.
+template <typename Func_t>
+void forEachVolumeFace(const FeMesh& theMesh, Func_t theFunc) {
+  uint32_t anElemIndex = 0;
+  for (const FeElementBlock& aBlock : theMesh.Blocks) {
+    if (!FeMesh::IsVolume(aBlock.Type)) {
+      anElemIndex += uint32_t(aBlock.NbElements());
+      continue;
+    }
+
+    const FeFaceDefs& aDefs = faceDefs(aBlock.Type);
+    const int aNbElemNodes = FeMesh::NbElementNodes(aBlock.Type);
+    const int* anElemNodes = aBlock.Nodes.data();
+    for (int anElemIter = 0; anElemIter < aBlock.NbElements();
+         ++anElemIter, ++anElemIndex, anElemNodes += aNbElemNodes) {
+      for (int aFaceIter = 0; aFaceIter < aDefs.NbFaces; ++aFaceIter) {
+        const int* aDef = aDefs.Faces[aFaceIter];
+        FaceKey aKey;
+        aKey.Nodes[0] = anElemNodes[aDef[0]];
+        aKey.Nodes[1] = anElemNodes[aDef[1]];
+        aKey.Nodes[2] = anElemNodes[aDef[2]];
+        aKey.Nodes[3] = aDef[3] >= 0 ? anElemNodes[aDef[3]] : INT_MAX;
+        std::sort(aKey.Nodes, aKey.Nodes + 4);
+        aKey.Ref = anElemIndex * 8 + uint32_t(aFaceIter);
+        theFunc(aKey);
+      }
+    }
+  }
+}
+}  // namespace
+
+// ================================================================
+// Function : NbElementNodes
+// Purpose  :
+// ================================================================
+int FeMesh::NbElementNodes(FeElementType theType) {
+  static const int THE_NB_NODES[6] = {3, 4, 4, 5, 6, 8};
+  return THE_NB_NODES[theType];
+}
+
+// ================================================================
+// Function : NbElementFaces
+// Purpose  :
+// ================================================================
+int FeMesh::NbElementFaces(FeElementType theType) {
+  return faceDefs(theType).NbFaces;
+}
+
+// ================================================================
+// Function : ElementFace
+// Purpose  :
+// ================================================================
+const int* FeMesh::ElementFace(FeElementType theType, int theFace) {
+  return faceDefs(theType).Faces[theFace];
+}
+
+// ================================================================
+// Function : NbElements
+// Purpose  :
+// ================================================================
+int FeMesh::NbElements() const {
+  int aNbElements = 0;
+  for (const FeElementBlock& aBlock : Blocks) {
+    aNbElements += aBlock.NbElements();
+  }
+  return aNbElements;
+}
+
+// ================================================================
+// Function : BoundingBox
+// Purpose  :
+// ================================================================
+Bnd_Box FeMesh::BoundingBox() const {
+  Bnd_Box aBox;
+  if (X.empty()) {
+    return aBox;
+  }
+  const auto [aMinX, aMaxX] = std::minmax_element(X.begin(), X.end());
+  const auto [aMinY, aMaxY] = std::minmax_element(Y.begin(), Y.end());
+  const auto [aMinZ, aMaxZ] = std::minmax_element(Z.begin(), Z.end());
+  aBox.Update(*aMinX, *aMinY, *aMinZ, *aMaxX, *aMaxY, *aMaxZ);
+  return aBox;
+}
+
+// ================================================================
+// Function : ChangeBlock
+// Purpose  :
+// ================================================================
+FeElementBlock& FeMesh::ChangeBlock(FeElementType theType) {
+  if (Blocks.empty() || Blocks.back().Type != theType) {
+    Blocks.emplace_back();
+    Blocks.back().Type = theType;
+  }
+  return Blocks.back();
+}
+
+// ================================================================
+// Function : ResolveNodeIds
+// Purpose  :
+// ================================================================
+bool FeMesh::ResolveNodeIds() {
+  if (NodeIds.empty()) {
+    return NbElements() == 0;
+  }
+
+  const auto [aMinIter, aMaxIter] =
+      std::minmax_element(NodeIds.begin(), NodeIds.end());
+  const int64_t aMinId = *aMinIter;
+  const int64_t aRange = int64_t(*aMaxIter) - aMinId + 1;
+  std::vector<int> aTable, aSorted;
+  if (aRange <= 4 * int64_t(NodeIds.size()) + 1024) {
+    aTable.assign(size_t(aRange), -1);
+    for (int aNodeIter = 0; aNodeIter < NbNodes(); ++aNodeIter) {
+      aTable[size_t(NodeIds[aNodeIter] - aMinId)] = aNodeIter;
+    }
+  } else {
+    aSorted.resize(NodeIds.size());
+    std::iota(aSorted.begin(), aSorted.end(), 0);
+    std::sort(aSorted.begin(), aSorted.end(),
+              [this](int theLeft, int theRight) {
+                return NodeIds[theLeft] < NodeIds[theRight];
+              });
+  }
+
+  for (FeElementBlock& aBlock : Blocks) {
+    for (int& aNode : aBlock.Nodes) {
+      const int64_t anId = aNode;
+      if (!aTable.empty()) {
+        aNode = anId >= aMinId && anId - aMinId < aRange
+                    ? aTable[size_t(anId - aMinId)]
+                    : -1;
+      } else {
+        const auto aFound = std::lower_bound(
+            aSorted.begin(), aSorted.end(), anId,
+            [this](int theIndex, int64_t theId) {
+              return NodeIds[theIndex] < theId;
+            });
+        aNode = aFound != aSorted.end() && NodeIds[*aFound] == anId
+                    ? *aFound
+                    : -1;
+      }
+      if (aNode < 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// ================================================================
+// Function : ComputeSkin
+// Purpose  :
+// ================================================================
+bool FeMesh::ComputeSkin(FeMeshSkin& theSkin,
+                         const Message_ProgressRange& theProgress) const {
+  theSkin = FeMeshSkin();
+  if (NbNodes() == 0 || NbElements() >= (1 << 29)) {
+    return NbElements() == 0;
+  }
+
+  // histogram of volume faces by their smallest node defines passes
+  const int aNbBins = std::min(NbNodes(), THE_NB_BINS);
+  const auto aBinOf = [this, aNbBins](int theNode) {
+    return int(int64_t(theNode) * aNbBins / NbNodes());
+  };
+  std::vector<size_t> aBinCounts(size_t(aNbBins), 0);
+  forEachVolumeFace(*this, [&](const FaceKey& theKey) {
+    ++aBinCounts[size_t(aBinOf(theKey.Nodes[0]))];
+  });
+  std::vector<int> aPassBins(1, 0);
+  for (int aBinIter = 0, aNbFaces = 0; aBinIter < aNbBins; ++aBinIter) {
+    if (aNbFaces > 0 && aNbFaces + aBinCounts[aBinIter] > THE_PASS_FACES) {
+      aPassBins.push_back(aBinIter);
+      aNbFaces = 0;
+    }
+    aNbFaces += int(aBinCounts[aBinIter]);
+  }
+  aPassBins.push_back(aNbBins);
+
+  // faces met once are exterior
+  Message_ProgressScope aPS(theProgress, "Extracting skin",
+                            double(aPassBins.size()));
+  std::vector<uint32_t> anExterior;
+  std::vector<FaceKey> aKeys;
+  for (size_t aPassIter = 0; aPassIter + 1 < aPassBins.size(); ++aPassIter) {
+    const int aBinFrom = aPassBins[aPassIter];
+    const int aBinTo = aPassBins[aPassIter + 1];
+    aKeys.clear();
+    forEachVolumeFace(*this, [&](const FaceKey& theKey) {
+      const int aBin = aBinOf(theKey.Nodes[0]);
+      if (aBin >= aBinFrom && aBin < aBinTo) {
+        aKeys.push_back(theKey);
+      }
+    });
+    std::sort(aKeys.begin(), aKeys.end());
+    for (size_t aKeyIter = 0; aKeyIter < aKeys.size();) {
+      size_t aNextIter = aKeyIter + 1;
+      while (aNextIter < aKeys.size() &&
+             aKeys[aNextIter].IsSame(aKeys[aKeyIter])) {
+        ++aNextIter;
+      }
+      if (aNextIter - aKeyIter == 1) {
+        anExterior.push_back(aKeys[aKeyIter].Ref);
+      }
+      aKeyIter = aNextIter;
+    }
+    aPS.Next();
+    if (aPS.UserBreak()) {
+      return false;
+    }
+  }
+  std::vector<FaceKey>().swap(aKeys);
+  std::sort(anExterior.begin(), anExterior.end());
+
+  // skin vertices are numbered in the order of appearance
+  std::vector<int> aNodeToVertex(size_t(NbNodes()), -1);
+  const auto addFace = [&](int theElem, const int* theNodes, int theNbNodes) {
+    int aVerts[4];
+    for (int aNodeIter = 0; aNodeIter < theNbNodes; ++aNodeIter) {
+      int& aVert = aNodeToVertex[size_t(theNodes[aNodeIter])];
+      if (aVert < 0) {
+        aVert = int(theSkin.Nodes.size());
+        theSkin.Nodes.push_back(theNodes[aNodeIter]);
+      }
+      aVerts[aNodeIter] = aVert;
+    }
+    for (int aTriIter = 0; aTriIter < theNbNodes - 2; ++aTriIter) {
+      theSkin.Triangles.push_back(aVerts[0]);
+      theSkin.Triangles.push_back(aVerts[aTriIter + 1]);
+      theSkin.Triangles.push_back(aVerts[aTriIter + 2]);
+      theSkin.Elements.push_back(theElem);
+    }
+  };
+
+  std::vector<int> aBlockFirst(Blocks.size() + 1, 0);
+  for (size_t aBlockIter = 0; aBlockIter < Blocks.size(); ++aBlockIter) {
+    const FeElementBlock& aBlock = Blocks[aBlockIter];
+    aBlockFirst[aBlockIter + 1] = aBlockFirst[aBlockIter] + aBlock.NbElements();
+    if (IsVolume(aBlock.Type)) {
+      continue;
+    }
+    const int aNbElemNodes = NbElementNodes(aBlock.Type);
+    for (int anElemIter = 0; anElemIter < aBlock.NbElements(); ++anElemIter) {
+      addFace(aBlockFirst[aBlockIter] + anElemIter,
+              aBlock.Nodes.data() + size_t(anElemIter) * aNbElemNodes,
+              aNbElemNodes);
+    }
+  }
+
+  for (const uint32_t aRef : anExterior) {
+    const int anElem = int(aRef / 8);
+    const size_t aBlockIndex =
+        size_t(std::upper_bound(aBlockFirst.begin(), aBlockFirst.end(),
+                                anElem) -
+               aBlockFirst.begin()) -
+        1;
+    const FeElementBlock& aBlock = Blocks[aBlockIndex];
+    const int aNbElemNodes = NbElementNodes(aBlock.Type);
+    const int* anElemNodes =
+        aBlock.Nodes.data() +
+        size_t(anElem - aBlockFirst[aBlockIndex]) * aNbElemNodes;
+    const int* aDef = faceDefs(aBlock.Type).Faces[aRef % 8];
+    const int aNbFaceNodes = aDef[3] >= 0 ? 4 : 3;
+    int aFaceNodes[4];
+    for (int aNodeIter = 0; aNodeIter < aNbFaceNodes; ++aNodeIter) {
+      aFaceNodes[aNodeIter] = anElemNodes[aDef[aNodeIter]];
+    }
+
+    // orient the face outwards of the element centroid, as node order
+    // conventions of volume elements differ between solvers
+    float aCenter[3] = {0.0f, 0.0f, 0.0f}, aFaceCenter[3] = {0.0f, 0.0f, 0.0f};
+    for (int aNodeIter = 0; aNodeIter < aNbElemNodes; ++aNodeIter) {
+      aCenter[0] += X[anElemNodes[aNodeIter]] / aNbElemNodes;
+      aCenter[1] += Y[anElemNodes[aNodeIter]] / aNbElemNodes;
+      aCenter[2] += Z[anElemNodes[aNodeIter]] / aNbElemNodes;
+    }
+    for (int aNodeIter = 0; aNodeIter < aNbFaceNodes; ++aNodeIter) {
+      aFaceCenter[0] += X[aFaceNodes[aNodeIter]] / aNbFaceNodes;
+      aFaceCenter[1] += Y[aFaceNodes[aNodeIter]] / aNbFaceNodes;
+      aFaceCenter[2] += Z[aFaceNodes[aNodeIter]] / aNbFaceNodes;
+    }
+    const int aLast = aNbFaceNodes - 1;
+    const float aD1[3] = {X[aFaceNodes[2]] - X[aFaceNodes[0]],
+                          Y[aFaceNodes[2]] - Y[aFaceNodes[0]],
+                          Z[aFaceNodes[2]] - Z[aFaceNodes[0]]};
+    const float aD2[3] = {X[aFaceNodes[aLast]] - X[aFaceNodes[1]],
+                          Y[aFaceNodes[aLast]] - Y[aFaceNodes[1]],
+                          Z[aFaceNodes[aLast]] - Z[aFaceNodes[1]]};
+    // for triangles aD2 is (n2 - n1), giving the same orientation sign
+    const float aNorm[3] = {aD1[1] * aD2[2] - aD1[2] * aD2[1],
+                            aD1[2] * aD2[0] - aD1[0] * aD2[2],
+                            aD1[0] * aD2[1] - aD1[1] * aD2[0]};
+    const float aDot = aNorm[0] * (aFaceCenter[0] - aCenter[0]) +
+                       aNorm[1] * (aFaceCenter[1] - aCenter[1]) +
+                       aNorm[2] * (aFaceCenter[2] - aCenter[2]);
+    if (aDot < 0.0f) {
+      std::reverse(aFaceNodes, aFaceNodes + aNbFaceNodes);
+    }
+    addFace(anElem, aFaceNodes, aNbFaceNodes);
+  }
+  aPS.Next();
+  return true;
+}
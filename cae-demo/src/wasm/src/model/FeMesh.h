@@ -0,0 +1,122 @@
+#ifndef _FeMesh_HeaderFile
+#define _FeMesh_HeaderFile
+
+#include <Bnd_Box.hxx>
+#include <Message_ProgressRange.hxx>
+#include <Standard_Transient.hxx>
+
+#include <vector>
+
+#include "FeResult.h"
+
+//! Types of finite elements.
+//! Quadratic elements are stored by their corner nodes.
+enum FeElementType {
+  FeElementType_Tri3,
+  FeElementType_Quad4,
+  FeElementType_Tet4,
+  FeElementType_Pyramid5,
+  FeElementType_Wedge6,
+  FeElementType_Hex8,
+};
+
+//! Block of elements of the same type.
+struct FeElementBlock {
+  FeElementType Type = FeElementType_Tet4;  //!< element type
+  std::vector<int> Ids;    //!< external element ids
+  //! Node indices, NbElementNodes() per element. Nodes follow Nastran and
+  //! Abaqus order: the first face of volume elements (the base of wedges and
+  //! pyramids) is oriented towards the remaining nodes; readers of other
+  //! formats reorder nodes on reading.
+  std::vector<int> Nodes;
+
+  //! Return number of elements.
+  int NbElements() const { return int(Ids.size()); }
+};
+
+//! Exterior faces of the mesh triangulated for rendering.
+struct FeMeshSkin {
+  std::vector<int> Nodes;      //!< mesh node index of every skin vertex
+  std::vector<int> Triangles;  //!< skin vertex indices, 3 per triangle
+  std::vector<int> Elements;   //!< mesh element index of every triangle
+
+  //! Return number of triangles.
+  int NbTriangles() const { return int(Elements.size()); }
+};
+
+//! Finite-element mesh of a solver model in structure-of-arrays layout.
+//!
+//! Node coordinates are kept in separate single-precision arrays, and
+//! elements are grouped into blocks of the same type with fixed number of
+//! nodes per element, so that no per-element offsets or types are stored.
+//! Elements are indexed globally in the order of blocks. External node and
+//! element ids are kept for mapping solver results.
+class FeMesh : public Standard_Transient {
+  DEFINE_STANDARD_RTTI_INLINE(FeMesh, Standard_Transient)
+ public:
+  //! Return number of corner nodes of the element type.
+  static int NbElementNodes(FeElementType theType);
+
+  //! Return number of faces of the element type, 1 for surface elements.
+  static int NbElementFaces(FeElementType theType);
+
+  //! Return corner indices of the element face oriented outwards;
+  //! the 4th index is -1 for triangular faces.
+  static const int* ElementFace(FeElementType theType, int theFace);
+
+  //! Return TRUE for volume elements.
+  static bool IsVolume(FeElementType theType) {
+    return theType >= FeElementType_Tet4;
+  }
+
+ public:
+  //! Return number of nodes.
+  int NbNodes() const { return int(NodeIds.size()); }
+
+  //! Return number of elements in all blocks.
+  int NbElements() const;
+
+  //! Return bounding box of nodes.
+  Bnd_Box BoundingBox() const;
+
+  //! Append node.
+  void AddNode(int theId, float theX, float theY, float theZ) {
+    NodeIds.push_back(theId);
+    X.push_back(theX);
+    Y.push_back(theY);
+    Z.push_back(theZ);
+  }
+
+  //! Return block of elements of specified type, the last one is reused.
+  FeElementBlock& ChangeBlock(FeElementType theType);
+
+  //! Replace external node ids in element blocks by node indices.
+  //! Ids are looked up in a direct table when they are dense enough,
+  //! otherwise by binary search over sorted ids.
+  //! @return FALSE if some element refers to unknown node
+  bool ResolveNodeIds();
+
+  //! Extract exterior faces: faces of volume elements not shared with
+  //! another volume element, and all surface elements. Faces are oriented
+  //! outwards of their elements, quadrangles are split into triangles.
+  //!
+  //! Shared faces are found by sorting face keys within ranges of their
+  //! smallest node, so that memory used for matching stays bounded on
+  //! meshes with tens of millions of faces.
+  //! @param theSkin     [out] extracted skin
+  //! @param theProgress [in] progress range
+  //! @return FALSE if cancelled
+  bool ComputeSkin(FeMeshSkin& theSkin,
+                   const Message_ProgressRange& theProgress =
+                       Message_ProgressRange()) const;
+
+ public:
+  std::vector<float> X;  //!< node X coordinates
+  std::vector<float> Y;  //!< node Y coordinates
+  std::vector<float> Z;  //!< node Z coordinates
+  std::vector<int> NodeIds;  //!< external node ids
+  std::vector<FeElementBlock> Blocks;  //!< element blocks
+  std::vector<FeResultField> Fields;  //!< result fields read with the mesh
+};
+
+#endif  // _FeMesh_HeaderFile
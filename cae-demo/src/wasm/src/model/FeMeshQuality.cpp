@@ -0,0 +1,451 @@
+#include "FeMeshQuality.h"
+
+#include <OSD_Parallel.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+//! Number of elements gathered into a chunk.
+static const int THE_CHUNK_SIZE = 256;
+
+//! Pi as float.
+static const float THE_PI = 3.14159265f;
+
+//! Element topology used by quality metrics.
+struct FeTopology {
+  int NbEdges;
+  int Edges[12][2];
+  int NbFaces;
+  int Faces[6][4];  //!< corners of faces, -1 for the last of triangles
+  int NbCorners;
+  //! Corner followed by its neighbors: two for shell elements, which
+  //! Jacobian is taken along the element normal, and three for volume ones.
+  int Corners[8][4];
+  float JacobianScale;  //!< scale of Jacobian making ideal element 1
+};
+
+//! Return topology of the element type.
+const FeTopology& topology(FeElementType theType) {
+  static const FeTopology THE_TOPOLOGIES[6] = {
+      // Tri3
+      {3,
+       {{0, 1}, {1, 2}, {2, 0}},
+       1,
+       {{0, 1, 2, -1}},
+       3,
+       {{0, 1, 2}, {1, 2, 0}, {2, 0, 1}},
+       1.1547005f},
+      // Quad4
+      {4,
+       {{0, 1}, {1, 2}, {2, 3}, {3, 0}},
+       1,
+       {{0, 1, 2, 3}},
+       4,
+       {{0, 1, 3}, {1, 2, 0}, {2, 3, 1}, {3, 0, 2}},
+       1.0f},
+      // Tet4
+      {6,
+       {{0, 1}, {1, 2}, {2, 0}, {0, 3}, {1, 3}, {2, 3}},
+       4,
+       {{0, 2, 1, -1}, {0, 1, 3, -1}, {1, 2, 3, -1}, {0, 3, 2, -1}},
+       4,
+       {{0, 1, 2, 3}, {1, 2, 0, 3}, {2, 0, 1, 3}, {3, 0, 2, 1}},
+       1.4142136f},
+      // Pyramid5, Jacobian is taken at base corners
+      {8,
+       {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {0, 4}, {1, 4}, {2, 4}, {3, 4}},
+       5,
+       {{0, 3, 2, 1},
+        {0, 1, 4, -1},
+        {1, 2, 4, -1},
+        {2, 3, 4, -1},
+        {3, 0, 4, -1}},
+       4,
+       {{0, 1, 3, 4}, {1, 2, 0, 4}, {2, 3, 1, 4}, {3, 0, 2, 4}},
+       1.4142136f},
+      // Wedge6
+      {9,
+       {{0, 1},
+        {1, 2},
+        {2, 0},
+        {3, 4},
+        {4, 5},
+        {5, 3},
+        {0, 3},
+        {1, 4},
+        {2, 5}},
+       5,
+       {{0, 2, 1, -1},
+        {3, 4, 5, -1},
+        {0, 1, 4, 3},
+        {1, 2, 5, 4},
+        {2, 0, 3, 5}},
+       6,
+       {{0, 1, 2, 3},
+        {1, 2, 0, 4},
+        {2, 0, 1, 5},
+        {3, 5, 4, 0},
+        {4, 3, 5, 1},
+        {5, 4, 3, 2}},
+       1.1547005f},
+      // Hex8
+      {12,
+       {{0, 1},
+        {1, 2},
+        {2, 3},
+        {3, 0},
+        {4, 5},
+        {5, 6},
+        {6, 7},
+        {7, 4},
+        {0, 4},
+        {1, 5},
+        {2, 6},
+        {3, 7}},
+       6,
+       {{0, 3, 2, 1},
+        {4, 5, 6, 7},
+        {0, 1, 5, 4},
+        {1, 2, 6, 5},
+        {2, 3, 7, 6},
+        {3, 0, 4, 7}},
+       8,
+       {{0, 1, 3, 4},
+        {1, 2, 0, 5},
+        {2, 3, 1, 6},
+        {3, 0, 2, 7},
+        {4, 7, 5, 0},
+        {5, 4, 6, 1},
+        {6, 5, 7, 2},
+        {7, 6, 4, 3}},
+       1.0f}};
+  return THE_TOPOLOGIES[theType];
+}
+
+//! Arc cosine in degrees by polynomial approximation (absolute error below
+//! 0.005 degree), which unlike std::acos() is vectorized.
+inline float acosDegrees(float theCos) {
+  const float anAbs = std::fmin(std::fabs(theCos), 1.0f);
+  const float anAcos =
+      std::sqrt(1.0f - anAbs) *
+      (((-0.0187293f * anAbs + 0.0742610f) * anAbs - 0.2121144f) * anAbs +
+       1.5707288f);
+  // PI - acos(-x) for negative values, without branching
+  const float aSign = std::copysign(1.0f, theCos);
+  return (THE_PI * 0.5f + aSign * (anAcos - THE_PI * 0.5f)) *
+         (180.0f / THE_PI);
+}
+
+//! Corner coordinates of a chunk of elements.
+struct ElementChunk {
+  float X[8][THE_CHUNK_SIZE];
+  float Y[8][THE_CHUNK_SIZE];
+  float Z[8][THE_CHUNK_SIZE];
+  int NbElements;
+};
+
+//! Compute ratio of the longest edge to the shortest one.
+void aspectRatio(const FeTopology& theTopo, const ElementChunk& theChunk,
+                 float* theValues) {
+  float aMin[THE_CHUNK_SIZE], aMax[THE_CHUNK_SIZE];
+  std::fill(aMin, aMin + theChunk.NbElements,
+            std::numeric_limits<float>::max());
+  std::fill(aMax, aMax + theChunk.NbElements, 0.0f);
+  for (int anEdgeIter = 0; anEdgeIter < theTopo.NbEdges; ++anEdgeIter) {
+    const int aFrom = theTopo.Edges[anEdgeIter][0];
+    const int aTo = theTopo.Edges[anEdgeIter][1];
+    for (int anElem = 0; anElem < theChunk.NbElements; ++anElem) {
+      const float aDX = theChunk.X[aTo][anElem] - theChunk.X[aFrom][anElem];
+      const float aDY = theChunk.Y[aTo][anElem] - theChunk.Y[aFrom][anElem];
+      const float aDZ = theChunk.Z[aTo][anElem] - theChunk.Z[aFrom][anElem];
+      const float aSquare = aDX * aDX + aDY * aDY + aDZ * aDZ;
+      aMin[anElem] = std::min(aMin[anElem], aSquare);
+      aMax[anElem] = std::max(aMax[anElem], aSquare);
+    }
+  }
+  for (int anElem = 0; anElem < theChunk.NbElements; ++anElem) {
+    theValues[anElem] = std::sqrt(aMax[anElem] / aMin[anElem]);
+  }
+}
+
+//! Compute maximal equiangle skew of element faces.
+void skew(const FeTopology& theTopo, const ElementChunk& theChunk,
+          float* theValues) {
+  std::fill(theValues, theValues + theChunk.NbElements, 0.0f);
+  for (int aFaceIter = 0; aFaceIter < theTopo.NbFaces; ++aFaceIter) {
+    const int* aFace = theTopo.Faces[aFaceIter];
+    const int aNbCorners = aFace[3] < 0 ? 3 : 4;
+    const float anIdeal = aNbCorners == 3 ? 60.0f : 90.0f;
+    for (int aCornerIter = 0; aCornerIter < aNbCorners; ++aCornerIter) {
+      const int aCorner = aFace[aCornerIter];
+      const int aPrev = aFace[(aCornerIter + aNbCorners - 1) % aNbCorners];
+      const int aNext = aFace[(aCornerIter + 1) % aNbCorners];
+      for (int anElem = 0; anElem < theChunk.NbElements; ++anElem) {
+        const float aX = theChunk.X[aCorner][anElem];
+        const float aY = theChunk.Y[aCorner][anElem];
+        const float aZ = theChunk.Z[aCorner][anElem];
+        const float aX1 = theChunk.X[aPrev][anElem] - aX;
+        const float aY1 = theChunk.Y[aPrev][anElem] - aY;
+        const float aZ1 = theChunk.Z[aPrev][anElem] - aZ;
+        const float aX2 = theChunk.X[aNext][anElem] - aX;
+        const float aY2 = theChunk.Y[aNext][anElem] - aY;
+        const float aZ2 = theChunk.Z[aNext][anElem] - aZ;
+        const float anAngle = acosDegrees(
+            (aX1 * aX2 + aY1 * aY2 + aZ1 * aZ2) /
+            std::sqrt((aX1 * aX1 + aY1 * aY1 + aZ1 * aZ1) *
+                      (aX2 * aX2 + aY2 * aY2 + aZ2 * aZ2)));
+        const float aSkew = std::max((anAngle - anIdeal) / (180.0f - anIdeal),
+                                     (anIdeal - anAngle) / anIdeal);
+        theValues[anElem] = std::max(theValues[anElem], aSkew);
+      }
+    }
+  }
+}
+
+//! Compute minimal scaled Jacobian at element corners.
+//! Orientation is taken from the sign of the element volume (or of its
+//! normal for shell elements), so that node order conventions of different
+//! formats give the same values, while a corner inverted relative to the
+//! others gives a negative value.
+void jacobian(const FeTopology& theTopo, bool theIsVolume,
+              const ElementChunk& theChunk, float* theValues) {
+  float aMin[THE_CHUNK_SIZE];
+  float aNX[THE_CHUNK_SIZE] = {}, aNY[THE_CHUNK_SIZE] = {},
+        aNZ[THE_CHUNK_SIZE] = {};
+  std::fill(aMin, aMin + theChunk.NbElements,
+            std::numeric_limits<float>::max());
+  if (!theIsVolume) {
+    // normal by diagonals of quadrangle or by edges of triangle
+    const int aCorners[4] = {0, 2, 1, theTopo.NbCorners == 4 ? 3 : 0};
+    for (int anElem = 0; anElem < theChunk.NbElements; ++anElem) {
+      const float aX1 = theChunk.X[aCorners[1]][anElem] -
+                        theChunk.X[aCorners[0]][anElem];
+      const float aY1 = theChunk.Y[aCorners[1]][anElem] -
+                        theChunk.Y[aCorners[0]][anElem];
+      const float aZ1 = theChunk.Z[aCorners[1]][anElem] -
+                        theChunk.Z[aCorners[0]][anElem];
+      const float aX2 = theChunk.X[aCorners[3]][anElem] -
+                        theChunk.X[aCorners[2]][anElem];
+      const float aY2 = theChunk.Y[aCorners[3]][anElem] -
+                        theChunk.Y[aCorners[2]][anElem];
+      const float aZ2 = theChunk.Z[aCorners[3]][anElem] -
+                        theChunk.Z[aCorners[2]][anElem];
+      const float aNX1 = aY1 * aZ2 - aZ1 * aY2;
+      const float aNY1 = aZ1 * aX2 - aX1 * aZ2;
+      const float aNZ1 = aX1 * aY2 - aY1 * aX2;
+      const float aLen = std::sqrt(aNX1 * aNX1 + aNY1 * aNY1 + aNZ1 * aNZ1);
+      aNX[anElem] = aNX1 / aLen;
+      aNY[anElem] = aNY1 / aLen;
+      aNZ[anElem] = aNZ1 / aLen;
+    }
+  }
+
+  const float aVolume = theIsVolume ? 1.0f : 0.0f;
+  for (int aCornerIter = 0; aCornerIter < theTopo.NbCorners; ++aCornerIter) {
+    const int* aCorner = theTopo.Corners[aCornerIter];
+    for (int anElem = 0; anElem < theChunk.NbElements; ++anElem) {
+      const float aX = theChunk.X[aCorner[0]][anElem];
+      const float aY = theChunk.Y[aCorner[0]][anElem];
+      const float aZ = theChunk.Z[aCorner[0]][anElem];
+      const float aX1 = theChunk.X[aCorner[1]][anElem] - aX;
+      const float aY1 = theChunk.Y[aCorner[1]][anElem] - aY;
+      const float aZ1 = theChunk.Z[aCorner[1]][anElem] - aZ;
+      const float aX2 = theChunk.X[aCorner[2]][anElem] - aX;
+      const float aY2 = theChunk.Y[aCorner[2]][anElem] - aY;
+      const float aZ2 = theChunk.Z[aCorner[2]][anElem] - aZ;
+      // the third direction is either edge or normal
+      const float aX3 =
+          aNX[anElem] + aVolume * (theChunk.X[aCorner[3]][anElem] - aX);
+      const float aY3 =
+          aNY[anElem] + aVolume * (theChunk.Y[aCorner[3]][anElem] - aY);
+      const float aZ3 =
+          aNZ[anElem] + aVolume * (theChunk.Z[aCorner[3]][anElem] - aZ);
+      const float aDet = aX1 * (aY2 * aZ3 - aZ2 * aY3) +
+                         aY1 * (aZ2 * aX3 - aX2 * aZ3) +
+                         aZ1 * (aX2 * aY3 - aY2 * aX3);
+      const float aScaled =
+          aDet / std::sqrt((aX1 * aX1 + aY1 * aY1 + aZ1 * aZ1) *
+                           (aX2 * aX2 + aY2 * aY2 + aZ2 * aZ2) *
+                           (aX3 * aX3 + aY3 * aY3 + aZ3 * aZ3));
+      aMin[anElem] = std::min(aMin[anElem], aScaled);
+    }
+  }
+  // node order is normalized by readers, see FeElementBlock, so that
+  // negative values mark inverted elements; the scale making the ideal corner
+  // 1 pushes other corners beyond it, so the value is clamped to [-1, 1]
+  for (int anElem = 0; anElem < theChunk.NbElements; ++anElem) {
+    theValues[anElem] =
+        std::clamp(aMin[anElem] * theTopo.JacobianScale, -1.0f, 1.0f);
+  }
+}
+
+//! Compute maximal warpage of quadrangle faces.
+void warpage(const FeTopology& theTopo, const ElementChunk& theChunk,
+             float* theValues) {
+  std::fill(theValues, theValues + theChunk.NbElements, 0.0f);
+  for (int aFaceIter = 0; aFaceIter < theTopo.NbFaces; ++aFaceIter) {
+    const int* aFace = theTopo.Faces[aFaceIter];
+    if (aFace[3] < 0) {
+      continue;
+    }
+
+    // angle between triangles split by either diagonal
+    for (int aDiagIter = 0; aDiagIter < 2; ++aDiagIter) {
+      const int aC0 = aFace[aDiagIter], aC1 = aFace[aDiagIter + 1];
+      const int aC2 = aFace[aDiagIter + 2], aC3 = aFace[(aDiagIter + 3) % 4];
+      for (int anElem = 0; anElem < theChunk.NbElements; ++anElem) {
+        const float aX = theChunk.X[aC0][anElem];
+        const float aY = theChunk.Y[aC0][anElem];
+        const float aZ = theChunk.Z[aC0][anElem];
+        const float aX1 = theChunk.X[aC1][anElem] - aX;
+        const float aY1 = theChunk.Y[aC1][anElem] - aY;
+        const float aZ1 = theChunk.Z[aC1][anElem] - aZ;
+        const float aX2 = theChunk.X[aC2][anElem] - aX;
+        const float aY2 = theChunk.Y[aC2][anElem] - aY;
+        const float aZ2 = theChunk.Z[aC2][anElem] - aZ;
+        const float aX3 = theChunk.X[aC3][anElem] - aX;
+        const float aY3 = theChunk.Y[aC3][anElem] - aY;
+        const float aZ3 = theChunk.Z[aC3][anElem] - aZ;
+        const float aNX1 = aY1 * aZ2 - aZ1 * aY2;
+        const float aNY1 = aZ1 * aX2 - aX1 * aZ2;
+        const float aNZ1 = aX1 * aY2 - aY1 * aX2;
+        const float aNX2 = aY2 * aZ3 - aZ2 * aY3;
+        const float aNY2 = aZ2 * aX3 - aX2 * aZ3;
+        const float aNZ2 = aX2 * aY3 - aY2 * aX3;
+        const float anAngle = acosDegrees(
+            (aNX1 * aNX2 + aNY1 * aNY2 + aNZ1 * aNZ2) /
+            std::sqrt((aNX1 * aNX1 + aNY1 * aNY1 + aNZ1 * aNZ1) *
+                      (aNX2 * aNX2 + aNY2 * aNY2 + aNZ2 * aNZ2)));
+        theValues[anElem] = std::max(theValues[anElem], anAngle);
+      }
+    }
+  }
+}
+}  // namespace
+
+// ================================================================
+// Function : MetricFromName
+// Purpose  :
+// ================================================================
+bool FeMeshQuality::MetricFromName(const std::string& theName,
+                                   FeQualityMetric& theMetric) {
+  static const struct {
+    const char* Name;
+    FeQualityMetric Metric;
+  } THE_METRICS[] = {{"aspect", FeQualityMetric_AspectRatio},
+                     {"skew", FeQualityMetric_Skew},
+                     {"jacobian", FeQualityMetric_Jacobian},
+                     {"warpage", FeQualityMetric_Warpage}};
+  for (const auto& aMetric : THE_METRICS) {
+    if (theName == aMetric.Name) {
+      theMetric = aMetric.Metric;
+      return true;
+    }
+  }
+  return false;
+}
+
+// ================================================================
+// Function : Compute
+// Purpose  :
+// ================================================================
+void FeMeshQuality::Compute(const FeMesh& theMesh, FeQualityMetric theMetric,
+                            std::vector<float>& theValues) {
+  theValues.resize(size_t(theMesh.NbElements()));
+  size_t aBlockFirst = 0;
+  for (const FeElementBlock& aBlock : theMesh.Blocks) {
+    const FeTopology& aTopo = topology(aBlock.Type);
+    const bool isVolume = FeMesh::IsVolume(aBlock.Type);
+    const int aNbElemNodes = FeMesh::NbElementNodes(aBlock.Type);
+    const int aNbElems = aBlock.NbElements();
+    const int aNbChunks = (aNbElems + THE_CHUNK_SIZE - 1) / THE_CHUNK_SIZE;
+    float* aBlockValues = theValues.data() + aBlockFirst;
+    OSD_Parallel::For(0, aNbChunks, [&](int theChunkIndex) {
+      // corner coordinates are gathered once, so that kernels read
+      // contiguous arrays
+      const int aFirst = theChunkIndex * THE_CHUNK_SIZE;
+      ElementChunk aChunk;
+      aChunk.NbElements = std::min(THE_CHUNK_SIZE, aNbElems - aFirst);
+      for (int aCornerIter = 0; aCornerIter < aNbElemNodes; ++aCornerIter) {
+        const int* aNodes =
+            aBlock.Nodes.data() + size_t(aFirst) * aNbElemNodes + aCornerIter;
+        for (int anElem = 0; anElem < aChunk.NbElements; ++anElem) {
+          const int aNode = aNodes[size_t(anElem) * aNbElemNodes];
+          aChunk.X[aCornerIter][anElem] = theMesh.X[aNode];
+          aChunk.Y[aCornerIter][anElem] = theMesh.Y[aNode];
+          aChunk.Z[aCornerIter][anElem] = theMesh.Z[aNode];
+        }
+      }
+
+      float* aValues = aBlockValues + aFirst;
+      switch (theMetric) {
+        case FeQualityMetric_AspectRatio:
+          aspectRatio(aTopo, aChunk, aValues);
+          break;
+        case FeQualityMetric_Skew:
+          skew(aTopo, aChunk, aValues);
+          break;
+        case FeQualityMetric_Jacobian:
+          jacobian(aTopo, isVolume, aChunk, aValues);
+          break;
+        case FeQualityMetric_Warpage:
+          warpage(aTopo, aChunk, aValues);
+          break;
+      }
+    });
+    aBlockFirst += size_t(aNbElems);
+  }
+}
+
+// ================================================================
+// Function : Histogram
+// Purpose  :
+// ================================================================
+FeQualityHistogram FeMeshQuality::Histogram(
+    const std::vector<float>& theValues, int theNbBins) {
+  FeQualityHistogram aHistogram;
+  aHistogram.Min = std::numeric_limits<float>::max();
+  aHistogram.Max = -std::numeric_limits<float>::max();
+  for (const float aValue : theValues) {
+    if (std::isfinite(aValue)) {
+      aHistogram.Min = std::min(aHistogram.Min, aValue);
+      aHistogram.Max = std::max(aHistogram.Max, aValue);
+    } else {
+      ++aHistogram.NbInvalid;
+    }
+  }
+  if (aHistogram.Min > aHistogram.Max) {
+    aHistogram.Min = aHistogram.Max = 0.0f;
+  }
+  if (theNbBins <= 0) {
+    return aHistogram;
+  }
+
+  aHistogram.Counts.assign(size_t(theNbBins), 0);
+  const float aScale = aHistogram.Max > aHistogram.Min
+                           ? float(theNbBins) /
+                                 (aHistogram.Max - aHistogram.Min)
+                           : 0.0f;
+  for (const float aValue : theValues) {
+    if (std::isfinite(aValue)) {
+      const int aBin = int((aValue - aHistogram.Min) * aScale);
+      ++aHistogram.Counts[size_t(std::min(aBin, theNbBins - 1))];
+    }
+  }
+  return aHistogram;
+}
+
+// ================================================================
+// Function : Values
+// Purpose  :
+// ================================================================
+const std::vector<float>& FeMeshQuality::Values(const FeMesh& theMesh,
+                                                FeQualityMetric theMetric) {
+  std::vector<float>& aValues = myValues[theMetric];
+  if (aValues.size() != size_t(theMesh.NbElements())) {
+    Compute(theMesh, theMetric, aValues);
+  }
+  return aValues;
+}
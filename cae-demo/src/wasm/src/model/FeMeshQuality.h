@@ -0,0 +1,74 @@
+#ifndef _FeMeshQuality_HeaderFile
+#define _FeMeshQuality_HeaderFile
+
+#include <string>
+#include <vector>
+
+#include "FeMesh.h"
+
+//! Element quality metric.
+enum FeQualityMetric {
+  FeQualityMetric_AspectRatio,  //!< longest to shortest edge, 1 is ideal
+  FeQualityMetric_Skew,  //!< equiangle skew of faces, 0 is ideal, 1 is flat
+  FeQualityMetric_Jacobian,  //!< minimal scaled Jacobian at corners in
+                             //!< [-1, 1], 1 is ideal, negative for inverted
+                             //!< elements
+  FeQualityMetric_Warpage,  //!< angle in degrees between halves of quad
+                            //!< faces, 0 is ideal
+};
+
+//! Number of quality metrics.
+static const int FeQualityMetric_NB = FeQualityMetric_Warpage + 1;
+
+//! Histogram of quality values.
+struct FeQualityHistogram {
+  float Min = 0.0f;         //!< minimal finite value
+  float Max = 0.0f;         //!< maximal finite value
+  int NbInvalid = 0;        //!< number of NaN and infinite values
+  std::vector<int> Counts;  //!< counts of values within equal bins
+};
+
+//! Cache of element quality metrics of a finite-element mesh.
+//!
+//! Corner coordinates of elements are gathered by chunks into
+//! structure-of-arrays buffers, one per corner and coordinate, and metric
+//! kernels loop over the chunk with straight-line code which the compiler
+//! vectorizes (with SIMD128 in WebAssembly builds with SIMD enabled).
+//! Chunks are computed in parallel where threads are available.
+//! Values of every metric are computed on first request and cached,
+//! so the cache should be owned by the model of the mesh.
+class FeMeshQuality {
+ public:
+  //! Find metric by name: "aspect", "skew", "jacobian" or "warpage".
+  //! @return FALSE if name is unknown
+  static bool MetricFromName(const std::string& theName,
+                             FeQualityMetric& theMetric);
+
+  //! Compute metric of all elements in the order of mesh blocks.
+  static void Compute(const FeMesh& theMesh, FeQualityMetric theMetric,
+                      std::vector<float>& theValues);
+
+  //! Build histogram of finite values.
+  //! @param theValues [in] values
+  //! @param theNbBins [in] number of bins
+  static FeQualityHistogram Histogram(const std::vector<float>& theValues,
+                                      int theNbBins);
+
+ public:
+  //! Return metric values of all elements of the mesh, computed on first
+  //! request.
+  const std::vector<float>& Values(const FeMesh& theMesh,
+                                   FeQualityMetric theMetric);
+
+  //! Release cached values.
+  void Clear() {
+    for (std::vector<float>& aValues : myValues) {
+      aValues = std::vector<float>();
+    }
+  }
+
+ private:
+  std::vector<float> myValues[FeQualityMetric_NB];  //!< cached values
+};
+
+#endif  // _FeMeshQuality_HeaderFile
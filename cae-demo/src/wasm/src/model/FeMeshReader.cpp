@@ -0,0 +1,803 @@
+#include "FeMeshReader.h"
+
+#include <Message_ProgressScope.hxx>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <numeric>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "DecompressStreamBuffer.h"
+#include "ModelFormat.h"
+
+namespace {
+//! Number of lines or values read between progress updates.
+static const int THE_PROGRESS_STEP = 1 << 16;
+
+//! Progress of reading file of unknown length.
+class ReadProgress {
+ public:
+  //! Main constructor.
+  ReadProgress(const Message_ProgressRange& theRange)
+      : myPS(theRange, "Reading mesh", 1, true) {}
+
+  //! Count read items.
+  //! @return FALSE if reading has been cancelled
+  bool Next(int theNbItems = 1) {
+    myNbItems += theNbItems;
+    if (myNbItems < THE_PROGRESS_STEP) {
+      return true;
+    }
+    myNbItems = 0;
+    myPS.Next();
+    return !myPS.UserBreak();
+  }
+
+ private:
+  Message_ProgressScope myPS;
+  int myNbItems = 0;
+};
+
+//! Return string without leading and trailing spaces.
+std::string trimmed(const std::string& theStr) {
+  size_t aFrom = 0, aTo = theStr.size();
+  while (aFrom < aTo && std::isspace((unsigned char)theStr[aFrom])) {
+    ++aFrom;
+  }
+  while (aTo > aFrom && std::isspace((unsigned char)theStr[aTo - 1])) {
+    --aTo;
+  }
+  return theStr.substr(aFrom, aTo - aFrom);
+}
+
+//! Return upper-case string.
+std::string upperCase(std::string theStr) {
+  std::transform(theStr.begin(), theStr.end(), theStr.begin(),
+                 [](unsigned char theChar) { return std::toupper(theChar); });
+  return theStr;
+}
+
+//! Split line by separator into trimmed fields, reusing their storage.
+void splitFields(const std::string& theLine, char theSep,
+                 std::vector<std::string>& theFields) {
+  theFields.clear();
+  size_t aFrom = 0;
+  for (;;) {
+    const size_t aTo = theLine.find(theSep, aFrom);
+    theFields.push_back(trimmed(theLine.substr(aFrom, aTo - aFrom)));
+    if (aTo == std::string::npos) {
+      break;
+    }
+    aFrom = aTo + 1;
+  }
+}
+
+//! Parse integer field.
+bool parseInt(const std::string& theField, int& theValue) {
+  char* anEnd = nullptr;
+  theValue = int(std::strtol(theField.c_str(), &anEnd, 10));
+  return !theField.empty() && anEnd != theField.c_str();
+}
+
+//! Parse real field, allowing Fortran "D" exponent.
+bool parseReal(std::string theField, double& theValue) {
+  std::replace(theField.begin(), theField.end(), 'D', 'E');
+  std::replace(theField.begin(), theField.end(), 'd', 'E');
+  char* anEnd = nullptr;
+  theValue = std::strtod(theField.c_str(), &anEnd);
+  return !theField.empty() && anEnd != theField.c_str();
+}
+
+//! Strip carriage return and text after comment character.
+void stripComment(std::string& theLine, char theComment) {
+  const size_t aPos = theLine.find_first_of(std::string("\r") + theComment);
+  if (aPos != std::string::npos) {
+    theLine.resize(aPos);
+  }
+}
+
+//! Reader of legacy VTK unstructured grid.
+class VtkReader {
+ public:
+  //! Main constructor.
+  VtkReader(std::istream& theStream, FeMesh& theMesh,
+            ReadProgress& theProgress)
+      : myStream(theStream), myMesh(theMesh), myProgress(theProgress) {}
+
+  //! Read mesh.
+  bool Perform();
+
+ private:
+  //! Read next non-empty line.
+  bool nextLine(std::string& theLine) {
+    while (std::getline(myStream, theLine)) {
+      theLine = trimmed(theLine);
+      if (!theLine.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  //! Read array of values of the VTK data type.
+  template <typename T>
+  bool readValues(const std::string& theType, size_t theNb,
+                  std::vector<T>& theValues);
+
+  //! Append cell of VTK type; unsupported cells are skipped.
+  bool addCell(int theIndex, int theType, const int* theNodes,
+               int theNbNodes);
+
+  //! Read data array of point or cell data section; arrays with other than
+  //! 1 or 3 components are skipped.
+  bool readField(const std::string& theName, const std::string& theType,
+                 int theNbComponents);
+
+ private:
+  std::istream& myStream;
+  FeMesh& myMesh;
+  ReadProgress& myProgress;
+  bool myIsBinary = false;
+  FeResultLocation myLocation = FeResultLocation_Node;
+  size_t myNbTuples = 0;  //!< size of current data section, 0 outside
+};
+
+// ================================================================
+// Function : readValues
+// Purpose  : binary data is big-endian
+// ================================================================
+template <typename T>
+bool VtkReader::readValues(const std::string& theType, size_t theNb,
+                           std::vector<T>& theValues) {
+  theValues.resize(theNb);
+  if (!myIsBinary) {
+    for (T& aValue : theValues) {
+      if (!(myStream >> aValue) || !myProgress.Next()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const std::string aType = theType.compare(0, 9, "unsigned_") == 0
+                                ? theType.substr(9)
+                                : theType;
+  const bool isSigned = aType == theType && theType != "vtktypeuint64";
+  size_t aSize = 0;
+  if (aType == "char") {
+    aSize = 1;
+  } else if (aType == "short") {
+    aSize = 2;
+  } else if (aType == "int" || aType == "float") {
+    aSize = 4;
+  } else if (aType == "long" || aType == "double" ||
+             aType == "vtktypeint64" || aType == "vtktypeuint64") {
+    aSize = 8;
+  } else {
+    return false;
+  }
+
+  std::vector<unsigned char> aChunk(aSize * THE_PROGRESS_STEP);
+  for (size_t aFrom = 0; aFrom < theNb; aFrom += THE_PROGRESS_STEP) {
+    const size_t aNbChunk = std::min(theNb - aFrom, size_t(THE_PROGRESS_STEP));
+    if (!myStream.read((char*)aChunk.data(), aNbChunk * aSize)) {
+      return false;
+    }
+    for (size_t aValIter = 0; aValIter < aNbChunk; ++aValIter) {
+      const unsigned char* aBytes = aChunk.data() + aValIter * aSize;
+      uint64_t aBits = 0;
+      for (size_t aByteIter = 0; aByteIter < aSize; ++aByteIter) {
+        aBits = (aBits << 8) | aBytes[aByteIter];
+      }
+      T& aValue = theValues[aFrom + aValIter];
+      if (aType == "float") {
+        const uint32_t aBits32 = uint32_t(aBits);
+        float aReal;
+        std::memcpy(&aReal, &aBits32, sizeof(aReal));
+        aValue = T(aReal);
+      } else if (aType == "double") {
+        double aReal;
+        std::memcpy(&aReal, &aBits, sizeof(aReal));
+        aValue = T(aReal);
+      } else if (isSigned) {
+        const int aShift = int(64 - 8 * aSize);
+        aValue = T(int64_t(aBits << aShift) >> aShift);
+      } else {
+        aValue = T(aBits);
+      }
+    }
+    if (!myProgress.Next(int(aNbChunk))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ================================================================
+// Function : addCell
+// Purpose  :
+// ================================================================
+bool VtkReader::addCell(int theIndex, int theType, const int* theNodes,
+                        int theNbNodes) {
+  // pixel and voxel are ordered as a grid rather than around faces
+  static const int THE_PIXEL_ORDER[4] = {0, 1, 3, 2};
+  static const int THE_VOXEL_ORDER[8] = {0, 1, 3, 2, 4, 5, 7, 6};
+  // VTK wedge base triangle is oriented away from the opposite one
+  static const int THE_WEDGE_ORDER[6] = {0, 2, 1, 3, 5, 4};
+  const int* anOrder = nullptr;
+  FeElementType aType = FeElementType_Tri3;
+  switch (theType) {
+    case 5:   // triangle
+    case 22:  // quadratic triangle
+      aType = FeElementType_Tri3;
+      break;
+    case 8:  // pixel
+      aType = FeElementType_Quad4;
+      anOrder = THE_PIXEL_ORDER;
+      break;
+    case 9:   // quad
+    case 23:  // quadratic quad
+    case 28:  // biquadratic quad
+      aType = FeElementType_Quad4;
+      break;
+    case 10:  // tetra
+    case 24:  // quadratic tetra
+      aType = FeElementType_Tet4;
+      break;
+    case 11:  // voxel
+      aType = FeElementType_Hex8;
+      anOrder = THE_VOXEL_ORDER;
+      break;
+    case 12:  // hexahedron
+    case 25:  // quadratic hexahedron
+    case 29:  // triquadratic hexahedron
+      aType = FeElementType_Hex8;
+      break;
+    case 13:  // wedge
+    case 26:  // quadratic wedge
+      aType = FeElementType_Wedge6;
+      anOrder = THE_WEDGE_ORDER;
+      break;
+    case 14:  // pyramid
+    case 27:  // quadratic pyramid
+      aType = FeElementType_Pyramid5;
+      break;
+    default:
+      return true;
+  }
+
+  const int aNbElemNodes = FeMesh::NbElementNodes(aType);
+  if (theNbNodes < aNbElemNodes) {
+    return false;
+  }
+  FeElementBlock& aBlock = myMesh.ChangeBlock(aType);
+  aBlock.Ids.push_back(theIndex);
+  for (int aNodeIter = 0; aNodeIter < aNbElemNodes; ++aNodeIter) {
+    const int aNode = theNodes[anOrder ? anOrder[aNodeIter] : aNodeIter];
+    if (aNode < 0 || aNode >= myMesh.NbNodes()) {
+      return false;
+    }
+    aBlock.Nodes.push_back(aNode);
+  }
+  return true;
+}
+
+// ================================================================
+// Function : readField
+// Purpose  :
+// ================================================================
+bool VtkReader::readField(const std::string& theName,
+                          const std::string& theType, int theNbComponents) {
+  FeResultField aField;
+  aField.Name = theName;
+  aField.Location = myLocation;
+  aField.NbComponents = theNbComponents;
+  if (theNbComponents <= 0 ||
+      !readValues(theType, myNbTuples * size_t(theNbComponents),
+                  aField.Values)) {
+    return false;
+  }
+  if (myNbTuples != 0 && (theNbComponents == 1 || theNbComponents == 3)) {
+    myMesh.Fields.push_back(std::move(aField));
+  }
+  return true;
+}
+
+// ================================================================
+// Function : Perform
+// Purpose  :
+// ================================================================
+bool VtkReader::Perform() {
+  std::string aLine;
+  if (!std::getline(myStream, aLine) ||
+      aLine.compare(0, 22, "# vtk DataFile Version") != 0) {
+    return false;
+  }
+  // version 5.1 stores cells as offsets and connectivity arrays
+  const bool hasOffsets = std::atof(aLine.c_str() + 22) >= 5.0;
+  std::getline(myStream, aLine);  // title
+  if (!nextLine(aLine)) {
+    return false;
+  }
+  myIsBinary = upperCase(aLine) == "BINARY";
+  if ((!myIsBinary && upperCase(aLine) != "ASCII") || !nextLine(aLine)) {
+    return false;
+  }
+  std::istringstream aDataSet(upperCase(aLine));
+  std::string aKey, aValue;
+  if (!(aDataSet >> aKey >> aValue) || aKey != "DATASET" ||
+      aValue != "UNSTRUCTURED_GRID") {
+    return false;
+  }
+
+  std::vector<int> aCells, anOffsets, aTypes;
+  size_t aNbOffsets = 0, aNbConnectivity = 0;
+  while (nextLine(aLine)) {
+    std::istringstream aKeyLine(aLine);
+    aKeyLine >> aKey;
+    aKey = upperCase(aKey);
+    size_t aNb = 0;
+    std::string aType;
+    if (aKey == "POINTS") {
+      std::vector<float> aCoords;
+      if (!(aKeyLine >> aNb >> aType) ||
+          !readValues(aType, aNb * 3, aCoords)) {
+        return false;
+      }
+      myMesh.X.resize(aNb);
+      myMesh.Y.resize(aNb);
+      myMesh.Z.resize(aNb);
+      for (size_t aNodeIter = 0; aNodeIter < aNb; ++aNodeIter) {
+        myMesh.X[aNodeIter] = aCoords[aNodeIter * 3 + 0];
+        myMesh.Y[aNodeIter] = aCoords[aNodeIter * 3 + 1];
+        myMesh.Z[aNodeIter] = aCoords[aNodeIter * 3 + 2];
+      }
+      myMesh.NodeIds.resize(aNb);
+      std::iota(myMesh.NodeIds.begin(), myMesh.NodeIds.end(), 0);
+    } else if (aKey == "CELLS") {
+      if (!(aKeyLine >> aNbOffsets >> aNbConnectivity) ||
+          (!hasOffsets && !readValues("int", aNbConnectivity, aCells))) {
+        return false;
+      }
+    } else if (aKey == "OFFSETS") {
+      if (!(aKeyLine >> aType) || !readValues(aType, aNbOffsets, anOffsets)) {
+        return false;
+      }
+    } else if (aKey == "CONNECTIVITY") {
+      if (!(aKeyLine >> aType) ||
+          !readValues(aType, aNbConnectivity, aCells)) {
+        return false;
+      }
+    } else if (aKey == "CELL_TYPES") {
+      if (!(aKeyLine >> aNb) || !readValues("int", aNb, aTypes)) {
+        return false;
+      }
+    } else if (aKey == "POINT_DATA" || aKey == "CELL_DATA") {
+      myLocation = aKey == "POINT_DATA" ? FeResultLocation_Node
+                                        : FeResultLocation_Element;
+      if (!(aKeyLine >> myNbTuples)) {
+        return false;
+      }
+    } else if (aKey == "SCALARS") {
+      std::string aName;
+      int aNbComps = 1;
+      if (!(aKeyLine >> aName >> aType)) {
+        return false;
+      }
+      aKeyLine >> aNbComps;
+      if (!nextLine(aLine) ||
+          upperCase(aLine).compare(0, 12, "LOOKUP_TABLE") != 0 ||
+          !readField(aName, aType, aNbComps)) {
+        return false;
+      }
+    } else if (aKey == "VECTORS" || aKey == "NORMALS") {
+      std::string aName;
+      const size_t aNbFields = myMesh.Fields.size();
+      if (!(aKeyLine >> aName >> aType) || !readField(aName, aType, 3)) {
+        return false;
+      }
+      if (aKey == "NORMALS") {
+        myMesh.Fields.resize(aNbFields);
+      }
+    } else if (aKey == "FIELD") {
+      // arrays of dataset-level field data have no location and are skipped
+      int aNbArrays = 0;
+      aKeyLine >> aType >> aNbArrays;
+      const size_t aNbSectionTuples = myNbTuples;
+      for (int anArrayIter = 0; anArrayIter < aNbArrays; ++anArrayIter) {
+        std::string aName;
+        int aNbComps = 0;
+        size_t aNbArrayTuples = 0;
+        if (!nextLine(aLine)) {
+          return false;
+        }
+        std::istringstream anArrayLine(aLine);
+        if (!(anArrayLine >> aName >> aNbComps >> aNbArrayTuples >> aType)) {
+          return false;
+        }
+        myNbTuples = aNbArrayTuples;
+        const size_t aNbFields = myMesh.Fields.size();
+        if (!readField(aName, aType, aNbComps)) {
+          return false;
+        }
+        if (aNbArrayTuples != aNbSectionTuples) {
+          myMesh.Fields.resize(aNbFields);
+        }
+      }
+      myNbTuples = aNbSectionTuples;
+    } else if (aKey == "METADATA") {
+      while (std::getline(myStream, aLine) && !trimmed(aLine).empty()) {
+      }
+    } else {
+      // other attributes (tensors, texture coordinates) are not needed
+      break;
+    }
+  }
+
+  // legacy layout prefixes every cell with its number of nodes
+  const int aNbCells = int(aTypes.size());
+  size_t aPos = 0;
+  for (int aCellIter = 0; aCellIter < aNbCells; ++aCellIter) {
+    size_t aFrom = 0, aTo = 0;
+    if (hasOffsets) {
+      if (size_t(aCellIter) + 1 >= anOffsets.size()) {
+        return false;
+      }
+      aFrom = size_t(anOffsets[aCellIter]);
+      aTo = size_t(anOffsets[aCellIter + 1]);
+    } else if (aPos < aCells.size()) {
+      aFrom = aPos + 1;
+      aTo = aFrom + size_t(aCells[aPos]);
+      aPos = aTo;
+    }
+    if (aTo > aCells.size() || aFrom >= aTo ||
+        !addCell(aCellIter, aTypes[aCellIter], aCells.data() + aFrom,
+                 int(aTo - aFrom))) {
+      return false;
+    }
+  }
+
+  // cell data of skipped cells is dropped, keeping values of elements only
+  for (size_t aFieldIter = 0; aFieldIter < myMesh.Fields.size();) {
+    FeResultField& aField = myMesh.Fields[aFieldIter];
+    const size_t aNbValues =
+        size_t(aField.Location == FeResultLocation_Node ? myMesh.NbNodes()
+                                                        : aNbCells) *
+        size_t(aField.NbComponents);
+    if (aField.Values.size() != aNbValues) {
+      myMesh.Fields.erase(myMesh.Fields.begin() + aFieldIter);
+      continue;
+    }
+    if (aField.Location == FeResultLocation_Element &&
+        myMesh.NbElements() != aNbCells) {
+      std::vector<float> aValues;
+      aValues.reserve(size_t(myMesh.NbElements()) * aField.NbComponents);
+      for (const FeElementBlock& aBlock : myMesh.Blocks) {
+        for (const int aCell : aBlock.Ids) {
+          const auto aFrom =
+              aField.Values.begin() + size_t(aCell) * aField.NbComponents;
+          aValues.insert(aValues.end(), aFrom, aFrom + aField.NbComponents);
+        }
+      }
+      aField.Values.swap(aValues);
+    }
+    ++aFieldIter;
+  }
+  return aNbCells > 0;
+}
+
+//! Nastran card split into name and data fields.
+typedef std::vector<std::string> NastranCard;
+
+// ================================================================
+// Function : parseNastranReal
+// Purpose  : blank field is zero; exponent letter may be omitted,
+//            e.g. "1.5-3" stands for 1.5E-3
+// ================================================================
+bool parseNastranReal(const std::string& theField, double& theValue) {
+  if (theField.empty()) {
+    theValue = 0.0;
+    return true;
+  }
+  std::string aField = theField;
+  if (aField.find_first_of("EeDd") == std::string::npos) {
+    const size_t aSignPos = aField.find_first_of("+-", 1);
+    if (aSignPos != std::string::npos) {
+      aField.insert(aSignPos, 1, 'E');
+    }
+  }
+  return parseReal(aField, theValue);
+}
+
+// ================================================================
+// Function : addNastranCard
+// Purpose  :
+// ================================================================
+bool addNastranCard(const NastranCard& theCard, FeMesh& theMesh) {
+  struct ElementCard {
+    const char* Name;
+    FeElementType Type;
+  };
+  static const ElementCard THE_ELEMENTS[] = {
+      {"CTRIA3", FeElementType_Tri3},     {"CTRIA6", FeElementType_Tri3},
+      {"CTRIAR", FeElementType_Tri3},     {"CQUAD4", FeElementType_Quad4},
+      {"CQUAD8", FeElementType_Quad4},    {"CQUADR", FeElementType_Quad4},
+      {"CTETRA", FeElementType_Tet4},     {"CPYRAM", FeElementType_Pyramid5},
+      {"CPENTA", FeElementType_Wedge6},   {"CHEXA", FeElementType_Hex8},
+  };
+
+  int anId = 0;
+  if (theCard.size() < 2 || !parseInt(theCard[1], anId)) {
+    return true;
+  }
+  if (theCard[0] == "GRID") {
+    // coordinate systems (CP field) are not supported
+    double aXYZ[3] = {0.0, 0.0, 0.0};
+    for (size_t aCoordIter = 0; aCoordIter < 3; ++aCoordIter) {
+      const size_t aField = 3 + aCoordIter;
+      if (aField < theCard.size() &&
+          !parseNastranReal(theCard[aField], aXYZ[aCoordIter])) {
+        return false;
+      }
+    }
+    theMesh.AddNode(anId, float(aXYZ[0]), float(aXYZ[1]), float(aXYZ[2]));
+    return true;
+  }
+
+  for (const ElementCard& anElem : THE_ELEMENTS) {
+    if (theCard[0] != anElem.Name) {
+      continue;
+    }
+    // nodes follow element and property ids
+    const int aNbNodes = FeMesh::NbElementNodes(anElem.Type);
+    int aNodes[8];
+    for (int aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter) {
+      const size_t aField = 3 + size_t(aNodeIter);
+      if (aField >= theCard.size() ||
+          !parseInt(theCard[aField], aNodes[aNodeIter])) {
+        return false;
+      }
+    }
+    FeElementBlock& aBlock = theMesh.ChangeBlock(anElem.Type);
+    aBlock.Ids.push_back(anId);
+    aBlock.Nodes.insert(aBlock.Nodes.end(), aNodes, aNodes + aNbNodes);
+    break;
+  }
+  return true;
+}
+
+// ================================================================
+// Function : readNastran
+// Purpose  : small, large and free field formats with continuations
+// ================================================================
+bool readNastran(std::istream& theStream, FeMesh& theMesh,
+                 ReadProgress& theProgress) {
+  NastranCard aCard, aFields;
+  std::string aLine;
+  bool isEnd = false;
+  while (!isEnd && theProgress.Next()) {
+    isEnd = !std::getline(theStream, aLine);
+    stripComment(aLine, '$');
+    if (!isEnd && trimmed(aLine).empty()) {
+      continue;
+    }
+
+    bool isContinuation = false;
+    if (isEnd) {
+      aFields.clear();
+    } else if (aLine.find(',') != std::string::npos) {
+      splitFields(aLine, ',', aFields);
+      const bool isLarge = !aFields[0].empty() && aFields[0].back() == '*';
+      // the last field of the line is the continuation mark
+      aFields.resize(std::min(aFields.size(), size_t(isLarge ? 5 : 9)));
+      isContinuation = aFields[0].empty() || aFields[0][0] == '+' ||
+                       aFields[0][0] == '*';
+    } else {
+      aFields.assign(1, trimmed(aLine.substr(0, 8)));
+      const std::string& aName = aFields[0];
+      isContinuation = aName.empty() || aName[0] == '+' || aName[0] == '*';
+      const bool isLarge = isContinuation ? !aName.empty() && aName[0] == '*'
+                                          : aName.back() == '*';
+      const size_t aWidth = isLarge ? 16 : 8;
+      for (size_t aPos = 8; aPos < std::min(aLine.size(), size_t(72));
+           aPos += aWidth) {
+        aFields.push_back(trimmed(aLine.substr(aPos, aWidth)));
+      }
+    }
+
+    if (isContinuation) {
+      aCard.insert(aCard.end(), aFields.begin() + 1, aFields.end());
+      continue;
+    }
+    if (!aCard.empty() && !addNastranCard(aCard, theMesh)) {
+      return false;
+    }
+    aCard.swap(aFields);
+    if (!aCard.empty()) {
+      aCard[0] = upperCase(aCard[0]);
+      if (!aCard[0].empty() && aCard[0].back() == '*') {
+        aCard[0].pop_back();
+      }
+      isEnd = aCard[0] == "ENDDATA";
+    }
+  }
+  return isEnd;
+}
+
+// ================================================================
+// Function : abaqusElementType
+// Purpose  : number of nodes is the last group of digits of the name
+// ================================================================
+bool abaqusElementType(const std::string& theName, FeElementType& theType,
+                       int& theNbNodes) {
+  const size_t aLast = theName.find_last_of("0123456789");
+  if (aLast == std::string::npos) {
+    return false;
+  }
+  size_t aFirst = aLast;
+  while (aFirst > 0 && std::isdigit((unsigned char)theName[aFirst - 1])) {
+    --aFirst;
+  }
+  theNbNodes = std::atoi(theName.c_str() + aFirst);
+
+  const bool isVolume = theName.compare(0, 3, "C3D") == 0 ||
+                        theName.compare(0, 4, "DC3D") == 0 ||
+                        theName.compare(0, 4, "AC3D") == 0 ||
+                        theName.compare(0, 2, "SC") == 0;
+  switch (theNbNodes) {
+    case 3:
+      theType = FeElementType_Tri3;
+      return !isVolume;
+    case 4:
+      theType = isVolume ? FeElementType_Tet4 : FeElementType_Quad4;
+      return true;
+    case 5:
+    case 13:
+      theType = FeElementType_Pyramid5;
+      return isVolume;
+    case 6:
+      theType = isVolume ? FeElementType_Wedge6 : FeElementType_Tri3;
+      return true;
+    case 8:
+      theType = isVolume ? FeElementType_Hex8 : FeElementType_Quad4;
+      return true;
+    case 9:
+      theType = FeElementType_Quad4;
+      return !isVolume;
+    case 10:
+      theType = FeElementType_Tet4;
+      return isVolume;
+    case 15:
+      theType = FeElementType_Wedge6;
+      return isVolume;
+    case 20:
+    case 27:
+      theType = FeElementType_Hex8;
+      return isVolume;
+  }
+  return false;
+}
+
+// ================================================================
+// Function : readAbaqus
+// Purpose  : node and element ids are expected to be unique within
+//            the file, instance transformations are ignored
+// ================================================================
+bool readAbaqus(std::istream& theStream, FeMesh& theMesh,
+                ReadProgress& theProgress) {
+  enum Section { Section_Other, Section_Node, Section_Element };
+  Section aSection = Section_Other;
+  FeElementType aType = FeElementType_Tet4;
+  int aNbNodes = 0;
+  std::vector<std::string> aFields;
+  std::vector<int> anElemValues;
+  std::string aLine;
+  while (std::getline(theStream, aLine)) {
+    if (!theProgress.Next()) {
+      return false;
+    }
+    aLine = trimmed(aLine);
+    if (aLine.empty() || aLine.compare(0, 2, "**") == 0) {
+      continue;
+    }
+
+    if (aLine[0] == '*') {
+      splitFields(upperCase(aLine), ',', aFields);
+      aSection = Section_Other;
+      anElemValues.clear();
+      if (aFields[0] == "*NODE") {
+        aSection = Section_Node;
+      } else if (aFields[0] == "*ELEMENT") {
+        for (const std::string& aParam : aFields) {
+          if (aParam.compare(0, 5, "TYPE=") == 0 &&
+              abaqusElementType(trimmed(aParam.substr(5)), aType, aNbNodes)) {
+            aSection = Section_Element;
+          }
+        }
+      }
+      continue;
+    }
+
+    splitFields(aLine, ',', aFields);
+    if (aSection == Section_Node) {
+      int anId = 0;
+      double aXYZ[3] = {0.0, 0.0, 0.0};
+      if (!parseInt(aFields[0], anId)) {
+        return false;
+      }
+      for (size_t aCoordIter = 0;
+           aCoordIter < 3 && aCoordIter + 1 < aFields.size(); ++aCoordIter) {
+        if (!parseReal(aFields[aCoordIter + 1], aXYZ[aCoordIter])) {
+          return false;
+        }
+      }
+      theMesh.AddNode(anId, float(aXYZ[0]), float(aXYZ[1]), float(aXYZ[2]));
+    } else if (aSection == Section_Element) {
+      // long element definitions continue on the next line after comma
+      for (const std::string& aField : aFields) {
+        int aValue = 0;
+        if (parseInt(aField, aValue)) {
+          anElemValues.push_back(aValue);
+        }
+      }
+      if (int(anElemValues.size()) <= aNbNodes && aLine.back() == ',') {
+        continue;
+      }
+      if (int(anElemValues.size()) <= aNbNodes) {
+        return false;
+      }
+      FeElementBlock& aBlock = theMesh.ChangeBlock(aType);
+      aBlock.Ids.push_back(anElemValues[0]);
+      aBlock.Nodes.insert(aBlock.Nodes.end(), anElemValues.begin() + 1,
+                          anElemValues.begin() + 1 +
+                              FeMesh::NbElementNodes(aType));
+      anElemValues.clear();
+    }
+  }
+  return true;
+}
+}  // namespace
+
+// ================================================================
+// Function : Read
+// Purpose  :
+// ================================================================
+bool FeMeshReader::Read(const std::string& theName, const char* theData,
+                        size_t theLen, FeMesh& theMesh,
+                        const Message_ProgressRange& theProgress) {
+  theMesh.X.clear();
+  theMesh.Y.clear();
+  theMesh.Z.clear();
+  theMesh.NodeIds.clear();
+  theMesh.Blocks.clear();
+  theMesh.Fields.clear();
+
+  const ModelFormat aFormat = ModelFormatTool::Detect(theName, theData, theLen);
+  DecompressStreamBuffer aStreamBuffer(theData, theLen);
+  std::istream aStream(&aStreamBuffer);
+  ReadProgress aProgress(theProgress);
+  bool isRead = false;
+  switch (aFormat) {
+    case ModelFormat_VTK: {
+      // VTK cells refer to node indices directly
+      VtkReader aReader(aStream, theMesh, aProgress);
+      return aReader.Perform() && aStreamBuffer.IsGood();
+    }
+    case ModelFormat_Nastran:
+      isRead = readNastran(aStream, theMesh, aProgress);
+      break;
+    case ModelFormat_Abaqus:
+      isRead = readAbaqus(aStream, theMesh, aProgress);
+      break;
+    default:
+      return false;
+  }
+  return isRead && aStreamBuffer.IsGood() && theMesh.NbElements() > 0 &&
+         theMesh.ResolveNodeIds();
+}
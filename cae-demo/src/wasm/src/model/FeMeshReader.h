@@ -0,0 +1,35 @@
+#ifndef _FeMeshReader_HeaderFile
+#define _FeMeshReader_HeaderFile
+
+#include <Message_ProgressRange.hxx>
+
+#include <cstddef>
+#include <string>
+
+#include "FeMesh.h"
+
+//! Readers of finite-element meshes: legacy VTK unstructured grid (ASCII or
+//! binary), Nastran bulk data (small, large and free fields) and Abaqus
+//! input files. Compressed data is inflated while parsing.
+//!
+//! Only mesh nodes and linear, quadratic or bilinear solid and shell
+//! elements are read; other cards and keywords are skipped. Quadratic
+//! elements keep their corner nodes. Scalar and vector point and cell data
+//! of VTK files are read as result fields.
+class FeMeshReader {
+ public:
+  //! Read mesh from memory.
+  //! @param theName     [in] file name
+  //! @param theData     [in] file data
+  //! @param theLen      [in] data length
+  //! @param theMesh     [out] read mesh with resolved node indices
+  //! @param theProgress [in] progress range
+  //! @return FALSE if data is not a supported mesh, cannot be read,
+  //!         or reading has been cancelled
+  static bool Read(const std::string& theName, const char* theData,
+                   size_t theLen, FeMesh& theMesh,
+                   const Message_ProgressRange& theProgress =
+                       Message_ProgressRange());
+};
+
+#endif  // _FeMeshReader_HeaderFile
@@ -0,0 +1,61 @@
+#include "FeResult.h"
+
+#include <algorithm>
+
+// ================================================================
+// Function : FeColormap
+// Purpose  :
+// ================================================================
+FeColormap::FeColormap() : myUndefined(128, 128, 128, 255) {
+  FromName("rainbow", *this);
+}
+
+// ================================================================
+// Function : FromName
+// Purpose  :
+// ================================================================
+bool FeColormap::FromName(const std::string& theName,
+                          FeColormap& theColormap) {
+  static const Graphic3d_Vec4ub THE_RAINBOW[] = {
+      {0, 0, 255, 255},   {0, 255, 255, 255}, {0, 255, 0, 255},
+      {255, 255, 0, 255}, {255, 0, 0, 255}};
+  static const Graphic3d_Vec4ub THE_VIRIDIS[] = {
+      {68, 1, 84, 255},   {59, 82, 139, 255},  {33, 145, 140, 255},
+      {94, 201, 98, 255}, {253, 231, 37, 255}};
+  static const Graphic3d_Vec4ub THE_COOLWARM[] = {
+      {59, 76, 192, 255}, {221, 221, 221, 255}, {180, 4, 38, 255}};
+  static const Graphic3d_Vec4ub THE_GRAYSCALE[] = {{0, 0, 0, 255},
+                                                   {255, 255, 255, 255}};
+  if (theName == "rainbow") {
+    theColormap.fill(THE_RAINBOW, 5);
+  } else if (theName == "viridis") {
+    theColormap.fill(THE_VIRIDIS, 5);
+  } else if (theName == "coolwarm") {
+    theColormap.fill(THE_COOLWARM, 3);
+  } else if (theName == "grayscale") {
+    theColormap.fill(THE_GRAYSCALE, 2);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// ================================================================
+// Function : fill
+// Purpose  :
+// ================================================================
+void FeColormap::fill(const Graphic3d_Vec4ub* theColors, int theNbColors) {
+  for (int aColorIter = 0; aColorIter < THE_NB_COLORS; ++aColorIter) {
+    const float aPos =
+        float(aColorIter) * float(theNbColors - 1) / float(THE_NB_COLORS - 1);
+    const int aLower = std::min(int(aPos), theNbColors - 2);
+    const float aFrac = aPos - float(aLower);
+    Graphic3d_Vec4ub& aColor = myTable[aColorIter];
+    for (int aCompIter = 0; aCompIter < 3; ++aCompIter) {
+      aColor[aCompIter] = Standard_Byte(
+          float(theColors[aLower][aCompIter]) * (1.0f - aFrac) +
+          float(theColors[aLower + 1][aCompIter]) * aFrac + 0.5f);
+    }
+    aColor.a() = 255;
+  }
+}
@@ -0,0 +1,88 @@
+#ifndef _FeResult_HeaderFile
+#define _FeResult_HeaderFile
+
+#include <Graphic3d_Vec4.hxx>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+//! Location of result values.
+enum FeResultLocation {
+  FeResultLocation_Node,     //!< value per mesh node
+  FeResultLocation_Element,  //!< value per mesh element
+};
+
+//! Result field of a mesh at single time step.
+struct FeResultField {
+  std::string Name;  //!< field name
+  FeResultLocation Location = FeResultLocation_Node;  //!< values location
+  int NbComponents = 1;  //!< 1 for scalars, 3 for vectors
+  std::vector<float> Values;  //!< NbComponents values per node or element
+};
+
+//! Range of scalar values mapped to colormap.
+struct FeResultRange {
+  float Min = 0.0f;  //!< value mapped to the first color
+  float Max = 0.0f;  //!< value mapped to the last color
+
+  //! Return TRUE if range is empty, i.e. should be computed from values.
+  bool IsEmpty() const { return !(Min < Max); }
+};
+
+//! Lookup table mapping scalar values to colors.
+class FeColormap {
+ public:
+  //! Find colormap by name: "rainbow", "viridis", "coolwarm" or
+  //! "grayscale".
+  //! @return FALSE if name is unknown
+  static bool FromName(const std::string& theName, FeColormap& theColormap);
+
+  //! Return scalar of value: component of scalar field or magnitude of
+  //! vector.
+  static float Scalar(const float* theValues, size_t theIndex,
+                      int theNbComponents) {
+    const float* aValue = theValues + theIndex * theNbComponents;
+    if (theNbComponents == 1) {
+      return aValue[0];
+    }
+    float aSquare = 0.0f;
+    for (int aCompIter = 0; aCompIter < theNbComponents; ++aCompIter) {
+      aSquare += aValue[aCompIter] * aValue[aCompIter];
+    }
+    return std::sqrt(aSquare);
+  }
+
+ public:
+  //! Create rainbow colormap.
+  FeColormap();
+
+  //! Return color of value within range; NaN is shown gray.
+  const Graphic3d_Vec4ub& Color(float theValue,
+                                const FeResultRange& theRange) const {
+    if (std::isnan(theValue)) {
+      return myUndefined;
+    }
+    const float aScale = theRange.IsEmpty()
+                             ? 0.0f
+                             : float(THE_NB_COLORS - 1) /
+                                   (theRange.Max - theRange.Min);
+    const float anIndex = (theValue - theRange.Min) * aScale;
+    return myTable[anIndex <= 0.0f ? 0
+                   : anIndex >= float(THE_NB_COLORS - 1)
+                       ? THE_NB_COLORS - 1
+                       : int(anIndex + 0.5f)];
+  }
+
+ private:
+  //! Fill table by linear interpolation of control colors.
+  void fill(const Graphic3d_Vec4ub* theColors, int theNbColors);
+
+ private:
+  static const int THE_NB_COLORS = 256;
+
+  Graphic3d_Vec4ub myTable[THE_NB_COLORS];  //!< colors
+  Graphic3d_Vec4ub myUndefined;             //!< color of undefined values
+};
+
+#endif  // _FeResult_HeaderFile
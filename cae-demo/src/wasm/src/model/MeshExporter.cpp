@@ -0,0 +1,279 @@
+#include "MeshExporter.h"
+
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <BinTools.hxx>
+#include <Message_ProgressScope.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+//! Store 32-bit value with the given byte order.
+void putUInt32(char* theDst, uint32_t theValue, bool theIsBigEndian) {
+  for (int aByteIter = 0; aByteIter < 4; ++aByteIter) {
+    const int aShift = theIsBigEndian ? (3 - aByteIter) * 8 : aByteIter * 8;
+    theDst[aByteIter] = char((theValue >> aShift) & 0xFF);
+  }
+}
+
+//! Store float with the given byte order.
+void putFloat(char* theDst, float theValue, bool theIsBigEndian) {
+  uint32_t aBits = 0;
+  std::memcpy(&aBits, &theValue, sizeof(aBits));
+  putUInt32(theDst, aBits, theIsBigEndian);
+}
+}  // namespace
+
+// ================================================================
+// Function : FormatFromName
+// Purpose  :
+// ================================================================
+bool MeshExporter::FormatFromName(const std::string& theName,
+                                  MeshExportFormat& theFormat) {
+  if (theName == "stl") {
+    theFormat = MeshExportFormat_STL;
+  } else if (theName == "vtk") {
+    theFormat = MeshExportFormat_VTK;
+  } else if (theName == "brep") {
+    theFormat = MeshExportFormat_BinBRep;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// ================================================================
+// Function : Part::NbNodes
+// Purpose  :
+// ================================================================
+int MeshExporter::Part::NbNodes() const {
+  return Skin != nullptr ? int(Skin->Nodes.size())
+                         : Triangulation->NbNodes();
+}
+
+// ================================================================
+// Function : Part::NbTriangles
+// Purpose  :
+// ================================================================
+int MeshExporter::Part::NbTriangles() const {
+  return Skin != nullptr ? Skin->NbTriangles()
+                         : Triangulation->NbTriangles();
+}
+
+// ================================================================
+// Function : Part::Node
+// Purpose  :
+// ================================================================
+gp_Pnt MeshExporter::Part::Node(int theIndex) const {
+  if (Skin != nullptr) {
+    const int aNode = Skin->Nodes[theIndex];
+    return gp_Pnt(Mesh->X[aNode], Mesh->Y[aNode], Mesh->Z[aNode]);
+  }
+  gp_Pnt aPnt = Triangulation->Node(theIndex + 1);
+  if (Trsf.Form() != gp_Identity) {
+    aPnt.Transform(Trsf);
+  }
+  return aPnt;
+}
+
+// ================================================================
+// Function : Part::Triangle
+// Purpose  :
+// ================================================================
+void MeshExporter::Part::Triangle(int theIndex, int& theNode1, int& theNode2,
+                                  int& theNode3) const {
+  if (Skin != nullptr) {
+    theNode1 = Skin->Triangles[size_t(theIndex) * 3];
+    theNode2 = Skin->Triangles[size_t(theIndex) * 3 + 1];
+    theNode3 = Skin->Triangles[size_t(theIndex) * 3 + 2];
+    return;
+  }
+  Triangulation->Triangle(theIndex + 1).Get(theNode1, theNode2, theNode3);
+  if (IsReversed) {
+    std::swap(theNode2, theNode3);
+  }
+  --theNode1;
+  --theNode2;
+  --theNode3;
+}
+
+// ================================================================
+// Function : AddShape
+// Purpose  :
+// ================================================================
+void MeshExporter::AddShape(const TopoDS_Shape& theShape) {
+  if (theShape.IsNull()) {
+    return;
+  }
+  myShapes.Append(theShape);
+  for (TopExp_Explorer aFaceIter(theShape, TopAbs_FACE); aFaceIter.More();
+       aFaceIter.Next()) {
+    const TopoDS_Face& aFace = TopoDS::Face(aFaceIter.Current());
+    TopLoc_Location aLoc;
+    Part aPart;
+    aPart.Triangulation = BRep_Tool::Triangulation(aFace, aLoc);
+    if (aPart.Triangulation.IsNull() ||
+        aPart.Triangulation->NbTriangles() == 0) {
+      continue;
+    }
+    aPart.Trsf = aLoc.Transformation();
+    aPart.IsReversed = aFace.Orientation() == TopAbs_REVERSED;
+    myNbNodes += aPart.NbNodes();
+    myNbTriangles += aPart.NbTriangles();
+    myParts.push_back(aPart);
+  }
+}
+
+// ================================================================
+// Function : AddSkin
+// Purpose  :
+// ================================================================
+void MeshExporter::AddSkin(const FeMesh& theMesh, const FeMeshSkin& theSkin) {
+  if (theSkin.NbTriangles() == 0) {
+    return;
+  }
+  Part aPart;
+  aPart.Mesh = &theMesh;
+  aPart.Skin = &theSkin;
+  myNbNodes += aPart.NbNodes();
+  myNbTriangles += aPart.NbTriangles();
+  myParts.push_back(aPart);
+}
+
+// ================================================================
+// Function : Write
+// Purpose  :
+// ================================================================
+bool MeshExporter::Write(std::ostream& theStream, MeshExportFormat theFormat,
+                         const Message_ProgressRange& theProgress) const {
+  switch (theFormat) {
+    case MeshExportFormat_STL:
+      return myNbTriangles > 0 && writeStl(theStream, theProgress);
+    case MeshExportFormat_VTK:
+      return myNbTriangles > 0 && writeVtk(theStream, theProgress);
+    case MeshExportFormat_BinBRep: {
+      if (myShapes.IsEmpty()) {
+        return false;
+      }
+      TopoDS_Shape aShape = myShapes.First();
+      if (myShapes.Size() > 1) {
+        TopoDS_Compound aCompound;
+        BRep_Builder aBuilder;
+        aBuilder.MakeCompound(aCompound);
+        for (NCollection_Sequence<TopoDS_Shape>::Iterator aShapeIter(
+                 myShapes);
+             aShapeIter.More(); aShapeIter.Next()) {
+          aBuilder.Add(aCompound, aShapeIter.Value());
+        }
+        aShape = aCompound;
+      }
+      BinTools::Write(aShape, theStream, true, false,
+                      BinTools_FormatVersion_CURRENT, theProgress);
+      return theStream.good() && !theProgress.UserBreak();
+    }
+  }
+  return false;
+}
+
+// ================================================================
+// Function : writeStl
+// Purpose  :
+// ================================================================
+bool MeshExporter::writeStl(std::ostream& theStream,
+                            const Message_ProgressRange& theProgress) const {
+  Message_ProgressScope aPS(theProgress, "Writing STL", double(myParts.size()));
+  char aHeader[84] = {};
+  std::strncpy(aHeader, "binary STL", 80);
+  putUInt32(aHeader + 80, uint32_t(myNbTriangles), false);
+  theStream.write(aHeader, sizeof(aHeader));
+
+  // normal, three vertices and attribute byte count
+  char aRecord[50] = {};
+  for (const Part& aPart : myParts) {
+    if (!aPS.More()) {
+      return false;
+    }
+    for (int aTriIter = 0; aTriIter < aPart.NbTriangles(); ++aTriIter) {
+      int aNodes[3];
+      aPart.Triangle(aTriIter, aNodes[0], aNodes[1], aNodes[2]);
+      const gp_Pnt aPnts[3] = {aPart.Node(aNodes[0]), aPart.Node(aNodes[1]),
+                               aPart.Node(aNodes[2])};
+      gp_XYZ aNormal = (aPnts[1].XYZ() - aPnts[0].XYZ())
+                           .Crossed(aPnts[2].XYZ() - aPnts[0].XYZ());
+      const double aModulus = aNormal.Modulus();
+      if (aModulus > 0.0) {
+        aNormal /= aModulus;
+      }
+      for (int aCoordIter = 0; aCoordIter < 3; ++aCoordIter) {
+        putFloat(aRecord + aCoordIter * 4, float(aNormal.Coord(aCoordIter + 1)),
+                 false);
+        for (int aPntIter = 0; aPntIter < 3; ++aPntIter) {
+          putFloat(aRecord + 12 + aPntIter * 12 + aCoordIter * 4,
+                   float(aPnts[aPntIter].Coord(aCoordIter + 1)), false);
+        }
+      }
+      theStream.write(aRecord, sizeof(aRecord));
+    }
+    aPS.Next();
+  }
+  return theStream.good();
+}
+
+// ================================================================
+// Function : writeVtk
+// Purpose  :
+// ================================================================
+bool MeshExporter::writeVtk(std::ostream& theStream,
+                            const Message_ProgressRange& theProgress) const {
+  // nodes and triangles are written in separate passes over the parts
+  Message_ProgressScope aPS(theProgress, "Writing VTK",
+                            double(myParts.size() * 2));
+  theStream << "# vtk DataFile Version 3.0\n"
+            << "Exported mesh\n"
+            << "BINARY\n"
+            << "DATASET POLYDATA\n"
+            << "POINTS " << myNbNodes << " float\n";
+  char aPoint[12];
+  for (const Part& aPart : myParts) {
+    if (!aPS.More()) {
+      return false;
+    }
+    for (int aNodeIter = 0; aNodeIter < aPart.NbNodes(); ++aNodeIter) {
+      const gp_Pnt aPnt = aPart.Node(aNodeIter);
+      putFloat(aPoint, float(aPnt.X()), true);
+      putFloat(aPoint + 4, float(aPnt.Y()), true);
+      putFloat(aPoint + 8, float(aPnt.Z()), true);
+      theStream.write(aPoint, sizeof(aPoint));
+    }
+    aPS.Next();
+  }
+
+  theStream << "\nPOLYGONS " << myNbTriangles << " " << myNbTriangles * 4
+            << "\n";
+  char aPolygon[16];
+  putUInt32(aPolygon, 3, true);
+  int aFirstNode = 0;
+  for (const Part& aPart : myParts) {
+    if (!aPS.More()) {
+      return false;
+    }
+    for (int aTriIter = 0; aTriIter < aPart.NbTriangles(); ++aTriIter) {
+      int aNodes[3];
+      aPart.Triangle(aTriIter, aNodes[0], aNodes[1], aNodes[2]);
+      for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter) {
+        putUInt32(aPolygon + 4 + aNodeIter * 4,
+                  uint32_t(aFirstNode + aNodes[aNodeIter]), true);
+      }
+      theStream.write(aPolygon, sizeof(aPolygon));
+    }
+    aFirstNode += aPart.NbNodes();
+    aPS.Next();
+  }
+  theStream << "\n";
+  return theStream.good();
+}
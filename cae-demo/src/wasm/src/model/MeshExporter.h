@@ -0,0 +1,100 @@
+#ifndef _MeshExporter_HeaderFile
+#define _MeshExporter_HeaderFile
+
+#include <Message_ProgressRange.hxx>
+#include <NCollection_Sequence.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopoDS_Shape.hxx>
+#include <gp_Trsf.hxx>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "FeMesh.h"
+
+//! Format of exported triangulation.
+enum MeshExportFormat {
+  MeshExportFormat_STL,      //!< binary STL
+  MeshExportFormat_VTK,      //!< legacy binary VTK polygonal data
+  MeshExportFormat_BinBRep,  //!< meshed binary BRep, shown by the viewer
+                             //!< without remeshing
+};
+
+//! Export of triangulations built for display.
+//!
+//! Triangles are written straight from the face triangulations of meshed
+//! shapes and from skins of FE meshes into the output stream, part by part,
+//! without assembling an intermediate mesh, so that memory use does not
+//! depend on the output size when the stream is flushed by chunks.
+//! Sources should be kept alive until writing is done.
+class MeshExporter {
+ public:
+  //! Find format by name: "stl", "vtk" or "brep".
+  //! @return FALSE if name is unknown
+  static bool FormatFromName(const std::string& theName,
+                             MeshExportFormat& theFormat);
+
+ public:
+  //! Empty constructor.
+  MeshExporter() : myNbNodes(0), myNbTriangles(0) {}
+
+  //! Add triangulated faces of the shape; faces without triangulation are
+  //! skipped.
+  void AddShape(const TopoDS_Shape& theShape);
+
+  //! Add skin of FE mesh.
+  void AddSkin(const FeMesh& theMesh, const FeMeshSkin& theSkin);
+
+  //! Return total number of nodes.
+  int NbNodes() const { return myNbNodes; }
+
+  //! Return total number of triangles.
+  int NbTriangles() const { return myNbTriangles; }
+
+  //! Write triangulation.
+  //! Binary BRep is written only for shapes, as FE skins have no surfaces.
+  //! @return FALSE on stream error, cancellation, or if there is nothing to
+  //!         write
+  bool Write(std::ostream& theStream, MeshExportFormat theFormat,
+             const Message_ProgressRange& theProgress) const;
+
+ private:
+  //! Triangulated part: face triangulation or FE skin.
+  struct Part {
+    Handle(Poly_Triangulation) Triangulation;  //!< face triangulation
+    gp_Trsf Trsf;             //!< face location
+    bool IsReversed = false;  //!< face orientation is reversed
+    const FeMesh* Mesh = nullptr;      //!< FE mesh
+    const FeMeshSkin* Skin = nullptr;  //!< FE mesh skin
+
+    //! Return number of nodes.
+    int NbNodes() const;
+
+    //! Return number of triangles.
+    int NbTriangles() const;
+
+    //! Return node by 0-based index.
+    gp_Pnt Node(int theIndex) const;
+
+    //! Return 0-based node indices of triangle oriented as the face.
+    void Triangle(int theIndex, int& theNode1, int& theNode2,
+                  int& theNode3) const;
+  };
+
+  //! Write binary STL.
+  bool writeStl(std::ostream& theStream,
+                const Message_ProgressRange& theProgress) const;
+
+  //! Write legacy binary VTK polygonal data.
+  bool writeVtk(std::ostream& theStream,
+                const Message_ProgressRange& theProgress) const;
+
+ private:
+  std::vector<Part> myParts;                  //!< triangulated parts
+  NCollection_Sequence<TopoDS_Shape> myShapes;  //!< added shapes
+  int myNbNodes;                              //!< total number of nodes
+  int myNbTriangles;                          //!< total number of triangles
+};
+
+#endif  // _MeshExporter_HeaderFile
@@ -0,0 +1,253 @@
+#include "ModelFingerprint.h"
+
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepTools.hxx>
+#include <BRepTools_ReShape.hxx>
+#include <BRep_Tool.hxx>
+#include <GeomAdaptor_Curve.hxx>
+#include <Precision.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+//! Coordinates are compared with this precision, so that round-trip
+//! through text formats does not change fingerprints.
+static const double THE_QUANTUM = 1.0e-6;
+
+//! Incremental FNV-1a hash of 64-bit words.
+class HashBuilder {
+ public:
+  //! Return hash value.
+  uint64_t Value() const { return myHash; }
+
+  //! Add integer value.
+  void Add(uint64_t theValue) {
+    for (int aByteIter = 0; aByteIter < 8; ++aByteIter) {
+      myHash ^= (theValue >> (aByteIter * 8)) & 0xFF;
+      myHash *= 0x100000001b3ULL;
+    }
+  }
+
+  //! Add real value rounded to THE_QUANTUM; infinite values are clamped.
+  void AddReal(double theValue) {
+    const double aValue = std::isnan(theValue)
+                              ? 0.0
+                              : std::max(-1.0e12, std::min(theValue, 1.0e12));
+    Add(uint64_t(std::llround(aValue / THE_QUANTUM)));
+  }
+
+  //! Add point coordinates.
+  void AddPoint(const gp_Pnt& thePnt) {
+    AddReal(thePnt.X());
+    AddReal(thePnt.Y());
+    AddReal(thePnt.Z());
+  }
+
+ private:
+  uint64_t myHash = 0xcbf29ce484222325ULL;
+};
+
+//! Return part without location and orientation.
+TopoDS_Shape unlocatedPart(const TopoDS_Shape& thePart) {
+  return thePart.Located(TopLoc_Location()).Oriented(TopAbs_FORWARD);
+}
+}  // namespace
+
+// ================================================================
+// Function : SplitParts
+// Purpose  :
+// ================================================================
+void ModelFingerprint::SplitParts(
+    const TopoDS_Shape& theShape,
+    NCollection_Sequence<TopoDS_Shape>& theParts) {
+  // solids, then shapes of lower dimension outside of higher ones
+  static const TopAbs_ShapeEnum THE_TYPES[4] = {TopAbs_SOLID, TopAbs_FACE,
+                                                TopAbs_EDGE, TopAbs_VERTEX};
+  for (int aTypeIter = 0; aTypeIter < 4; ++aTypeIter) {
+    for (TopExp_Explorer aPartIter(
+             theShape, THE_TYPES[aTypeIter],
+             aTypeIter == 0 ? TopAbs_SHAPE : THE_TYPES[aTypeIter - 1]);
+         aPartIter.More(); aPartIter.Next()) {
+      theParts.Append(aPartIter.Current());
+    }
+  }
+}
+
+// ================================================================
+// Function : computePart
+// Purpose  :
+// ================================================================
+uint64_t ModelFingerprint::computePart(const TopoDS_Shape& thePart) {
+  HashBuilder aHash;
+  aHash.Add(uint64_t(thePart.ShapeType()));
+
+  TopTools_IndexedMapOfShape aVertices, anEdges;
+  TopExp::MapShapes(thePart, TopAbs_VERTEX, aVertices);
+  TopExp::MapShapes(thePart, TopAbs_EDGE, anEdges);
+  aHash.Add(uint64_t(aVertices.Extent()));
+  for (int aVertIter = 1; aVertIter <= aVertices.Extent(); ++aVertIter) {
+    aHash.AddPoint(BRep_Tool::Pnt(TopoDS::Vertex(aVertices(aVertIter))));
+  }
+
+  aHash.Add(uint64_t(anEdges.Extent()));
+  for (int anEdgeIter = 1; anEdgeIter <= anEdges.Extent(); ++anEdgeIter) {
+    const TopoDS_Edge& anEdge = TopoDS::Edge(anEdges(anEdgeIter));
+    TopoDS_Vertex aFirstVert, aLastVert;
+    TopExp::Vertices(anEdge, aFirstVert, aLastVert);
+    aHash.Add(uint64_t(aVertices.FindIndex(aFirstVert)));
+    aHash.Add(uint64_t(aVertices.FindIndex(aLastVert)));
+
+    TopLoc_Location aLoc;
+    double aFirst = 0.0, aLast = 0.0;
+    const Handle(Geom_Curve) aCurve =
+        BRep_Tool::Curve(anEdge, aLoc, aFirst, aLast);
+    aHash.Add(aCurve.IsNull() ? uint64_t(-1)
+                              : uint64_t(GeomAdaptor_Curve(aCurve).GetType()));
+    if (!aCurve.IsNull()) {
+      aHash.AddReal(aFirst);
+      aHash.AddReal(aLast);
+      aHash.AddPoint(aCurve->Value(0.5 * (aFirst + aLast))
+                         .Transformed(aLoc.Transformation()));
+    }
+  }
+
+  for (TopExp_Explorer aFaceIter(thePart, TopAbs_FACE); aFaceIter.More();
+       aFaceIter.Next()) {
+    const TopoDS_Face& aFace = TopoDS::Face(aFaceIter.Current());
+    aHash.Add(uint64_t(aFace.Orientation()));
+    if (BRep_Tool::Surface(aFace).IsNull()) {
+      continue;
+    }
+
+    BRepAdaptor_Surface aSurf(aFace, false);
+    aHash.Add(uint64_t(aSurf.GetType()));
+    double aUMin = 0.0, aUMax = 0.0, aVMin = 0.0, aVMax = 0.0;
+    BRepTools::UVBounds(aFace, aUMin, aUMax, aVMin, aVMax);
+    aHash.AddReal(aUMin);
+    aHash.AddReal(aUMax);
+    aHash.AddReal(aVMin);
+    aHash.AddReal(aVMax);
+    if (Precision::IsInfinite(aUMin) || Precision::IsInfinite(aUMax) ||
+        Precision::IsInfinite(aVMin) || Precision::IsInfinite(aVMax)) {
+      continue;
+    }
+
+    // points at the corners and at the middle of the parametric range
+    for (int aUIter = 0; aUIter <= 2; ++aUIter) {
+      for (int aVIter = 0; aVIter <= 2; ++aVIter) {
+        aHash.AddPoint(aSurf.Value(aUMin + (aUMax - aUMin) * aUIter / 2,
+                                   aVMin + (aVMax - aVMin) * aVIter / 2));
+      }
+    }
+  }
+  return aHash.Value();
+}
+
+// ================================================================
+// Function : Part
+// Purpose  :
+// ================================================================
+uint64_t ModelFingerprint::Part(const TopoDS_Shape& thePart) {
+  const TopoDS_Shape aPart = unlocatedPart(thePart);
+  if (const uint64_t* aHash = myPartHashes.Seek(aPart)) {
+    return *aHash;
+  }
+  const uint64_t aHash = computePart(aPart);
+  myPartHashes.Bind(aPart, aHash);
+  return aHash;
+}
+
+// ================================================================
+// Function : Shape
+// Purpose  :
+// ================================================================
+uint64_t ModelFingerprint::Shape(const TopoDS_Shape& theShape) {
+  NCollection_Sequence<TopoDS_Shape> aParts;
+  SplitParts(theShape, aParts);
+
+  HashBuilder aHash;
+  aHash.Add(uint64_t(aParts.Size()));
+  for (NCollection_Sequence<TopoDS_Shape>::Iterator aPartIter(aParts);
+       aPartIter.More(); aPartIter.Next()) {
+    const TopoDS_Shape& aPart = aPartIter.Value();
+    aHash.Add(Part(aPart));
+    aHash.Add(uint64_t(aPart.Orientation()));
+    const gp_Trsf aTrsf = aPart.Location().Transformation();
+    for (int aRowIter = 1; aRowIter <= 3; ++aRowIter) {
+      for (int aColIter = 1; aColIter <= 4; ++aColIter) {
+        aHash.AddReal(aTrsf.Value(aRowIter, aColIter));
+      }
+    }
+  }
+  return aHash.Value();
+}
+
+// ================================================================
+// Function : AddKnownParts
+// Purpose  :
+// ================================================================
+void ModelFingerprint::AddKnownParts(const TopoDS_Shape& theShape) {
+  NCollection_Sequence<TopoDS_Shape> aParts;
+  SplitParts(theShape, aParts);
+  for (NCollection_Sequence<TopoDS_Shape>::Iterator aPartIter(aParts);
+       aPartIter.More(); aPartIter.Next()) {
+    myKnownParts.emplace(Part(aPartIter.Value()),
+                         unlocatedPart(aPartIter.Value()));
+  }
+}
+
+// ================================================================
+// Function : AddKnownParts
+// Purpose  :
+// ================================================================
+void ModelFingerprint::AddKnownParts(const TopoDS_Shape& theShape,
+                                     const ModelFingerprint& theSource) {
+  NCollection_Sequence<TopoDS_Shape> aParts;
+  SplitParts(theShape, aParts);
+  for (NCollection_Sequence<TopoDS_Shape>::Iterator aPartIter(aParts);
+       aPartIter.More(); aPartIter.Next()) {
+    const TopoDS_Shape aPart = unlocatedPart(aPartIter.Value());
+    if (const uint64_t* aHash = theSource.myPartHashes.Seek(aPart)) {
+      myPartHashes.Bind(aPart, *aHash);
+    }
+    myKnownParts.emplace(Part(aPart), aPart);
+  }
+}
+
+// ================================================================
+// Function : ReuseParts
+// Purpose  :
+// ================================================================
+TopoDS_Shape ModelFingerprint::ReuseParts(const TopoDS_Shape& theShape,
+                                          const ModelFingerprint& thePrev,
+                                          int& theNbParts, int& theNbReused) {
+  NCollection_Sequence<TopoDS_Shape> aParts;
+  SplitParts(theShape, aParts);
+
+  Handle(BRepTools_ReShape) aReShape = new BRepTools_ReShape();
+  bool isModified = false;
+  for (NCollection_Sequence<TopoDS_Shape>::Iterator aPartIter(aParts);
+       aPartIter.More(); aPartIter.Next()) {
+    ++theNbParts;
+    const uint64_t aHash = Part(aPartIter.Value());
+    const auto aKnownIter = thePrev.myKnownParts.find(aHash);
+    if (aKnownIter == thePrev.myKnownParts.end()) {
+      continue;
+    }
+
+    ++theNbReused;
+    const TopoDS_Shape aPart = unlocatedPart(aPartIter.Value());
+    myPartHashes.Bind(aKnownIter->second, aHash);
+    if (!aPart.IsSame(aKnownIter->second) && !aReShape->IsRecorded(aPart)) {
+      // occurrences keep their locations and orientations
+      aReShape->Replace(aPart, aKnownIter->second);
+      isModified = true;
+    }
+  }
+  return isModified ? aReShape->Apply(theShape) : theShape;
+}
@@ -0,0 +1,67 @@
+#ifndef _ModelFingerprint_HeaderFile
+#define _ModelFingerprint_HeaderFile
+
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Sequence.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <cstdint>
+#include <unordered_map>
+
+//! Geometric and topological fingerprints of model parts, used to find
+//! parts which have not changed between revisions of the same model.
+//!
+//! Part is a solid, or a face outside of solids. Part fingerprint is
+//! computed in the part coordinate system from its topology (numbers and
+//! orientations of sub-shapes), vertex coordinates, curve and surface types
+//! and surface points, so that it does not depend on TShape identity or on
+//! placement of the part. Fingerprint of a shape combines fingerprints of
+//! its parts with their locations and orientations.
+//!
+//! Fingerprints of parts are cached by TShape, so that instanced parts are
+//! processed once.
+class ModelFingerprint {
+ public:
+  //! Split shape into parts (located as within the shape).
+  static void SplitParts(const TopoDS_Shape& theShape,
+                         NCollection_Sequence<TopoDS_Shape>& theParts);
+
+ public:
+  //! Return fingerprint of the part, ignoring its location and orientation.
+  uint64_t Part(const TopoDS_Shape& thePart);
+
+  //! Return fingerprint of the shape.
+  uint64_t Shape(const TopoDS_Shape& theShape);
+
+  //! Remember parts of the shape to be reused by ReuseParts() of
+  //! the next model revision.
+  void AddKnownParts(const TopoDS_Shape& theShape);
+
+  //! Remember parts of the shape already fingerprinted by another object,
+  //! without computing their fingerprints again.
+  void AddKnownParts(const TopoDS_Shape& theShape,
+                     const ModelFingerprint& theSource);
+
+  //! Return the shape with parts equal to known parts of the previous
+  //! revision replaced by them, so that their triangulation is reused.
+  //! @param theShape    [in] shape to process
+  //! @param thePrev     [in] fingerprints of the previous revision
+  //! @param theNbParts  [in,out] incremented by number of parts
+  //! @param theNbReused [in,out] incremented by number of replaced parts
+  TopoDS_Shape ReuseParts(const TopoDS_Shape& theShape,
+                          const ModelFingerprint& thePrev, int& theNbParts,
+                          int& theNbReused);
+
+ private:
+  //! Compute fingerprint of the part at identity location.
+  static uint64_t computePart(const TopoDS_Shape& thePart);
+
+ private:
+  NCollection_DataMap<TopoDS_Shape, uint64_t, TopTools_ShapeMapHasher>
+      myPartHashes;  //!< fingerprints of unlocated parts
+  std::unordered_map<uint64_t, TopoDS_Shape>
+      myKnownParts;  //!< unlocated known parts by fingerprints
+};
+
+#endif  // _ModelFingerprint_HeaderFile
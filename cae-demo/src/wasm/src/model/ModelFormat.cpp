@@ -0,0 +1,95 @@
+#include "ModelFormat.h"
+
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+#include "DecompressStreamBuffer.h"
+
+// ================================================================
+// Function : IsIgesFileName
+// Purpose  :
+// ================================================================
+bool ModelFormatTool::IsIgesFileName(const std::string& theName) {
+  const auto ext = std::filesystem::path(theName).extension();
+  return ext == ".iges" || ext == ".igs";
+}
+
+// ================================================================
+// Function : DetectPlain
+// Purpose  :
+// ================================================================
+ModelFormat ModelFormatTool::DetectPlain(const std::string& theName,
+                                         const char* theData, size_t theLen) {
+  size_t aPos = 0;
+  // Function to check if data starts with specified header at current
+  // position; moves position past the header on success.
+  const auto skipHeader = [theData, theLen, &aPos](const char* theHeader) {
+    const size_t aLen = ::strlen(theHeader);
+    if (theLen - aPos < aLen || ::strncmp(theData + aPos, theHeader, aLen)) {
+      return false;
+    }
+    aPos += aLen;
+    return true;
+  };
+  const auto skipSpaces = [theData, theLen, &aPos]() {
+    while (aPos < theLen && std::isspace((unsigned char)theData[aPos])) {
+      ++aPos;
+    }
+  };
+
+  // BinTools writes "Open CASCADE Topology V<N> (c)"
+  if (skipHeader("Open CASCADE Topology V")) {
+    return ModelFormat_BinBRep;
+  }
+
+  // BRepTools writes an empty line followed by "CASCADE Topology V<N>, (c)",
+  // DRAW prepends it with "DBRep_DrawableShape"
+  skipSpaces();
+  const bool isDrawShape = skipHeader("DBRep_DrawableShape");
+  skipSpaces();
+  if (isDrawShape || skipHeader("CASCADE Topology V")) {
+    return ModelFormat_BRep;
+  }
+
+  aPos = 0;
+  if (skipHeader("ISO-10303-21")) {
+    // header is authoritative, whatever the file extension is
+    return ModelFormat_STEP;
+  } else if (skipHeader("# vtk DataFile Version")) {
+    return ModelFormat_VTK;
+  } else if (IsIgesFileName(theName)) {
+    return ModelFormat_IGES;
+  }
+
+  // solver input decks have no signature
+  const auto anExt = std::filesystem::path(theName).extension();
+  if (anExt == ".bdf" || anExt == ".nas" || anExt == ".dat" ||
+      anExt == ".fem") {
+    return ModelFormat_Nastran;
+  } else if (anExt == ".inp") {
+    return ModelFormat_Abaqus;
+  }
+  return ModelFormat_Unknown;
+}
+
+// ================================================================
+// Function : Detect
+// Purpose  :
+// ================================================================
+ModelFormat ModelFormatTool::Detect(const std::string& theName,
+                                    const char* theData, size_t theLen) {
+  if (DecompressStreamBuffer::DetectCodec(theData, theLen) ==
+      DecompressStreamBuffer::Codec_None) {
+    return DetectPlain(theName, theData, theLen);
+  }
+
+  char aHeader[64];
+  DecompressStreamBuffer aStreamBuffer(theData, theLen, sizeof(aHeader));
+  const std::streamsize aNbRead = aStreamBuffer.sgetn(aHeader, sizeof(aHeader));
+  if (!aStreamBuffer.IsGood()) {
+    return ModelFormat_Unknown;
+  }
+  return DetectPlain(DecompressStreamBuffer::StripCodecExtension(theName),
+                     aHeader, size_t(aNbRead));
+}
@@ -0,0 +1,49 @@
+#ifndef _ModelFormat_HeaderFile
+#define _ModelFormat_HeaderFile
+
+#include <cstddef>
+#include <string>
+
+//! Supported model formats.
+enum ModelFormat {
+  ModelFormat_Unknown,
+  ModelFormat_BRep,     //!< ASCII BRep (BRepTools)
+  ModelFormat_BinBRep,  //!< binary BRep (BinTools)
+  ModelFormat_STEP,
+  ModelFormat_IGES,
+  ModelFormat_VTK,      //!< legacy VTK unstructured grid
+  ModelFormat_Nastran,  //!< Nastran bulk data
+  ModelFormat_Abaqus,   //!< Abaqus input file
+};
+
+//! Tool detecting model format from the file header.
+class ModelFormatTool {
+ public:
+  //! Number of first bytes enough to detect model format,
+  //! including compressed data.
+  static const size_t THE_HEADER_SIZE = 256;
+
+  //! Detect model format from file header and name.
+  //! Compressed data is recognized by its magic number, and the format is
+  //! then detected from the first decompressed bytes.
+  //! @param theName [in] file name
+  //! @param theData [in] file data (at least first bytes)
+  //! @param theLen  [in] length of theData
+  static ModelFormat Detect(const std::string& theName, const char* theData,
+                            size_t theLen);
+
+  //! Detect format of uncompressed model from file header and name.
+  static ModelFormat DetectPlain(const std::string& theName,
+                                 const char* theData, size_t theLen);
+
+  //! Return TRUE if file name has IGES extension.
+  static bool IsIgesFileName(const std::string& theName);
+
+  //! Return TRUE for finite-element mesh formats.
+  static bool IsMeshFormat(ModelFormat theFormat) {
+    return theFormat == ModelFormat_VTK || theFormat == ModelFormat_Nastran ||
+           theFormat == ModelFormat_Abaqus;
+  }
+};
+
+#endif  // _ModelFormat_HeaderFile
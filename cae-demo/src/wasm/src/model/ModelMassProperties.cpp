@@ -0,0 +1,141 @@
+#include "ModelMassProperties.h"
+
+#include <BRepBndLib.hxx>
+#include <BRepGProp.hxx>
+#include <OSD_Parallel.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_MapOfShape.hxx>
+#include <gp_Mat.hxx>
+
+#include <vector>
+
+#include "ModelMesher.h"
+
+// ================================================================
+// Function : computeChunk
+// Purpose  :
+// ================================================================
+ModelMassProperties::Entry ModelMassProperties::computeChunk(
+    const TopoDS_Shape& theChunk) {
+  Entry anEntry;
+  // volume of open shells is meaningless
+  if (TopExp_Explorer(theChunk, TopAbs_SOLID).More()) {
+    BRepGProp::VolumeProperties(theChunk, anEntry.VolumeProps);
+  }
+  BRepGProp::SurfaceProperties(theChunk, anEntry.SurfaceProps);
+  BRepBndLib::AddOptimal(theChunk, anEntry.Box, false, false);
+  return anEntry;
+}
+
+// ================================================================
+// Function : addEntry
+// Purpose  :
+// ================================================================
+void ModelMassProperties::addEntry(Entry& theTotal, const Entry& theItem) {
+  // items without mass would produce undefined center of mass
+  if (theItem.VolumeProps.Mass() > 0.0) {
+    theTotal.VolumeProps.Add(theItem.VolumeProps);
+  }
+  if (theItem.SurfaceProps.Mass() > 0.0) {
+    theTotal.SurfaceProps.Add(theItem.SurfaceProps);
+  }
+  theTotal.Box.Add(theItem.Box);
+}
+
+// ================================================================
+// Function : Compute
+// Purpose  :
+// ================================================================
+ModelMassProps ModelMassProperties::Compute(const TopoDS_Shape& theShape) {
+  NCollection_Sequence<TopoDS_Shape> aShapes;
+  aShapes.Append(theShape);
+  return Compute(aShapes);
+}
+
+// ================================================================
+// Function : Compute
+// Purpose  :
+// ================================================================
+ModelMassProps ModelMassProperties::Compute(
+    const NCollection_Sequence<TopoDS_Shape>& theShapes) {
+  // chunks of all shapes not cached yet are computed in one parallel pass
+  TopTools_MapOfShape aNewShapeMap, aNewChunkMap;
+  NCollection_Sequence<TopoDS_Shape> aNewShapes;
+  std::vector<NCollection_Sequence<TopoDS_Shape>> aShapeChunks;
+  std::vector<TopoDS_Shape> aNewChunks;
+  for (NCollection_Sequence<TopoDS_Shape>::Iterator aShapeIter(theShapes);
+       aShapeIter.More(); aShapeIter.Next()) {
+    const TopoDS_Shape& aShape = aShapeIter.Value();
+    if (aShape.IsNull() || myCache.IsBound(aShape) ||
+        !aNewShapeMap.Add(aShape)) {
+      continue;
+    }
+
+    aNewShapes.Append(aShape);
+    aShapeChunks.emplace_back();
+    ModelMesher::SplitShape(aShape, aShapeChunks.back());
+    for (NCollection_Sequence<TopoDS_Shape>::Iterator aChunkIter(
+             aShapeChunks.back());
+         aChunkIter.More(); aChunkIter.Next()) {
+      if (!myCache.IsBound(aChunkIter.Value()) &&
+          aNewChunkMap.Add(aChunkIter.Value())) {
+        aNewChunks.push_back(aChunkIter.Value());
+      }
+    }
+  }
+
+  std::vector<Entry> aChunkEntries(aNewChunks.size());
+  OSD_Parallel::For(0, int(aNewChunks.size()),
+                    [&aNewChunks, &aChunkEntries](int theIndex) {
+                      aChunkEntries[theIndex] =
+                          computeChunk(aNewChunks[theIndex]);
+                    });
+  for (size_t aChunkIter = 0; aChunkIter < aNewChunks.size(); ++aChunkIter) {
+    myCache.Bind(aNewChunks[aChunkIter], aChunkEntries[aChunkIter]);
+  }
+
+  int aShapeIndex = 0;
+  for (NCollection_Sequence<TopoDS_Shape>::Iterator aShapeIter(aNewShapes);
+       aShapeIter.More(); aShapeIter.Next(), ++aShapeIndex) {
+    Entry aShapeEntry;
+    for (NCollection_Sequence<TopoDS_Shape>::Iterator aChunkIter(
+             aShapeChunks[aShapeIndex]);
+         aChunkIter.More(); aChunkIter.Next()) {
+      addEntry(aShapeEntry, myCache.Find(aChunkIter.Value()));
+    }
+    myCache.Bind(aShapeIter.Value(), aShapeEntry);
+  }
+
+  Entry aTotal;
+  for (NCollection_Sequence<TopoDS_Shape>::Iterator aShapeIter(theShapes);
+       aShapeIter.More(); aShapeIter.Next()) {
+    if (!aShapeIter.Value().IsNull()) {
+      addEntry(aTotal, myCache.Find(aShapeIter.Value()));
+    }
+  }
+
+  ModelMassProps aProps;
+  aProps.IsDone = true;
+  aProps.Volume = aTotal.VolumeProps.Mass();
+  aProps.Area = aTotal.SurfaceProps.Mass();
+  const GProp_GProps& aMassProps =
+      aProps.Volume > 0.0 ? aTotal.VolumeProps : aTotal.SurfaceProps;
+  if (aMassProps.Mass() > 0.0) {
+    const gp_Pnt aCenter = aMassProps.CentreOfMass();
+    const gp_Mat anInertia = aMassProps.MatrixOfInertia();
+    aProps.CenterX = aCenter.X();
+    aProps.CenterY = aCenter.Y();
+    aProps.CenterZ = aCenter.Z();
+    aProps.Ixx = anInertia(1, 1);
+    aProps.Iyy = anInertia(2, 2);
+    aProps.Izz = anInertia(3, 3);
+    aProps.Ixy = anInertia(1, 2);
+    aProps.Ixz = anInertia(1, 3);
+    aProps.Iyz = anInertia(2, 3);
+  }
+  if (!aTotal.Box.IsVoid()) {
+    aTotal.Box.Get(aProps.MinX, aProps.MinY, aProps.MinZ, aProps.MaxX,
+                   aProps.MaxY, aProps.MaxZ);
+  }
+  return aProps;
+}
@@ -0,0 +1,63 @@
+#ifndef _ModelMassProperties_HeaderFile
+#define _ModelMassProperties_HeaderFile
+
+#include <Bnd_Box.hxx>
+#include <GProp_GProps.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Sequence.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+#include <TopoDS_Shape.hxx>
+
+//! Mass properties of a shape with unit density.
+struct ModelMassProps {
+  bool IsDone = false;  //!< properties have been computed
+  double Volume = 0.0;  //!< volume of solids
+  double Area = 0.0;    //!< area of all faces
+  //! Center of mass of solids, or of faces if there are no solids.
+  double CenterX = 0.0, CenterY = 0.0, CenterZ = 0.0;
+  //! Elements of the inertia tensor at the center of mass.
+  double Ixx = 0.0, Iyy = 0.0, Izz = 0.0, Ixy = 0.0, Ixz = 0.0, Iyz = 0.0;
+  //! Bounding box, all zeros for an empty shape.
+  double MinX = 0.0, MinY = 0.0, MinZ = 0.0;
+  double MaxX = 0.0, MaxY = 0.0, MaxZ = 0.0;
+};
+
+//! Cache of mass properties computed by BRepGProp.
+//!
+//! Shapes are split into chunks in the same way as for meshing (solids and
+//! a compound of free faces, see ModelMesher), chunks not cached yet are
+//! computed in parallel, and then combined. Properties of every chunk and
+//! of every requested shape are cached, so that repeated queries of the
+//! same shape, or of a model consisting of already queried objects, are not
+//! computed again. Cached shapes are kept alive by the cache, so it should
+//! be owned by the model.
+class ModelMassProperties {
+ public:
+  //! Return properties of the shape.
+  ModelMassProps Compute(const TopoDS_Shape& theShape);
+
+  //! Return combined properties of the shapes.
+  ModelMassProps Compute(const NCollection_Sequence<TopoDS_Shape>& theShapes);
+
+  //! Release cached properties.
+  void Clear() { myCache.Clear(); }
+
+ private:
+  //! Cached properties.
+  struct Entry {
+    GProp_GProps VolumeProps;   //!< volume properties of solids
+    GProp_GProps SurfaceProps;  //!< surface properties of faces
+    Bnd_Box Box;                //!< bounding box
+  };
+
+  //! Compute properties of a single chunk.
+  static Entry computeChunk(const TopoDS_Shape& theChunk);
+
+  //! Add properties of the item to the total.
+  static void addEntry(Entry& theTotal, const Entry& theItem);
+
+ private:
+  NCollection_DataMap<TopoDS_Shape, Entry, TopTools_ShapeMapHasher> myCache;
+};
+
+#endif  // _ModelMassProperties_HeaderFile
@@ -0,0 +1,141 @@
+#include "ModelMesher.h"
+
+#include <BRepBndLib.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepMesh_ShapeTool.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
+#include <Message_ProgressScope.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Prs3d.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+
+#include <vector>
+
+// ================================================================
+// Function : SplitShape
+// Purpose  :
+// ================================================================
+void ModelMesher::SplitShape(const TopoDS_Shape& theShape,
+                             NCollection_Sequence<TopoDS_Shape>& theChunks) {
+  for (TopExp_Explorer aSolidIter(theShape, TopAbs_SOLID); aSolidIter.More();
+       aSolidIter.Next()) {
+    theChunks.Append(aSolidIter.Current());
+  }
+  if (theChunks.IsEmpty()) {
+    theChunks.Append(theShape);
+    return;
+  }
+
+  // faces outside of solids are meshed together
+  TopoDS_Compound aFreeFaces;
+  BRep_Builder aBuilder;
+  bool hasFreeFaces = false;
+  for (TopExp_Explorer aFaceIter(theShape, TopAbs_FACE, TopAbs_SOLID);
+       aFaceIter.More(); aFaceIter.Next()) {
+    if (!hasFreeFaces) {
+      aBuilder.MakeCompound(aFreeFaces);
+      hasFreeFaces = true;
+    }
+    aBuilder.Add(aFreeFaces, aFaceIter.Current());
+  }
+  if (hasFreeFaces) {
+    theChunks.Append(aFreeFaces);
+  }
+}
+
+// ================================================================
+// Function : MeshParameters
+// Purpose  :
+// ================================================================
+IMeshTools_Parameters ModelMesher::MeshParameters(
+    const TopoDS_Shape& theChunk, const Handle(Prs3d_Drawer) & theDrawer) {
+  IMeshTools_Parameters aParams;
+  aParams.Deflection = theDrawer->MaximalChordialDeviation();
+  if (theDrawer->TypeOfDeflection() == Aspect_TOD_RELATIVE) {
+    Bnd_Box aBox;
+    BRepBndLib::Add(theChunk, aBox, false);
+    if (!aBox.IsVoid()) {
+      aParams.Deflection =
+          Prs3d::GetDeflection(aBox, theDrawer->DeviationCoefficient(),
+                               theDrawer->MaximalChordialDeviation());
+    }
+  }
+  aParams.Angle = theDrawer->DeviationAngle();
+  aParams.InParallel = true;
+  return aParams;
+}
+
+// ================================================================
+// Function : MeshChunk
+// Purpose  :
+// ================================================================
+void ModelMesher::MeshChunk(const TopoDS_Shape& theChunk,
+                            const Handle(Prs3d_Drawer) & theDrawer,
+                            double theMinRatio, bool theToRemeshAll,
+                            ModelMeshStats& theStats,
+                            const Message_ProgressRange& theProgress) {
+  const IMeshTools_Parameters aParams = MeshParameters(theChunk, theDrawer);
+  TopTools_IndexedMapOfShape aFaces;
+  TopExp::MapShapes(theChunk, TopAbs_FACE, aFaces);
+  std::vector<Handle(Poly_Triangulation)> anOldTris(aFaces.Extent());
+  for (int aFaceIter = 1; aFaceIter <= aFaces.Extent(); ++aFaceIter) {
+    const TopoDS_Face& aFace = TopoDS::Face(aFaces.FindKey(aFaceIter));
+    TopLoc_Location aLoc;
+    const Handle(Poly_Triangulation)& aTris =
+        BRep_Tool::Triangulation(aFace, aLoc);
+    if (aTris.IsNull()) {
+      continue;
+    }
+
+    // too coarse faces are detected and remeshed by BRepMesh itself,
+    // while too fine ones would be kept
+    if (theToRemeshAll ||
+        aTris->Deflection() < theMinRatio * aParams.Deflection) {
+      for (TopExp_Explorer anEdgeIter(aFace, TopAbs_EDGE); anEdgeIter.More();
+           anEdgeIter.Next()) {
+        BRepMesh_ShapeTool::NullifyEdge(TopoDS::Edge(anEdgeIter.Current()),
+                                        aTris, aLoc);
+      }
+      BRepMesh_ShapeTool::NullifyFace(aFace);
+      continue;
+    }
+    anOldTris[aFaceIter - 1] = aTris;
+  }
+
+  BRepMesh_IncrementalMesh aMesher(theChunk, aParams, theProgress);
+
+  // face is reused if its triangulation has not been replaced
+  theStats.NbFaces += aFaces.Extent();
+  for (int aFaceIter = 1; aFaceIter <= aFaces.Extent(); ++aFaceIter) {
+    TopLoc_Location aLoc;
+    const Handle(Poly_Triangulation)& aTris =
+        BRep_Tool::Triangulation(TopoDS::Face(aFaces.FindKey(aFaceIter)), aLoc);
+    if (!aTris.IsNull() && aTris == anOldTris[aFaceIter - 1]) {
+      ++theStats.NbReused;
+    }
+  }
+}
+
+// ================================================================
+// Function : MeshShape
+// Purpose  :
+// ================================================================
+bool ModelMesher::MeshShape(const TopoDS_Shape& theShape,
+                            const Handle(Prs3d_Drawer) & theDrawer,
+                            ModelMeshStats& theStats,
+                            const Message_ProgressRange& theProgress) {
+  NCollection_Sequence<TopoDS_Shape> aChunks;
+  SplitShape(theShape, aChunks);
+  Message_ProgressScope aPS(theProgress, "Meshing", aChunks.Size());
+  for (NCollection_Sequence<TopoDS_Shape>::Iterator aChunkIter(aChunks);
+       aChunkIter.More() && aPS.More(); aChunkIter.Next()) {
+    MeshChunk(aChunkIter.Value(), theDrawer, 0.0, false, theStats, aPS.Next());
+  }
+  return !aPS.UserBreak();
+}
@@ -0,0 +1,65 @@
+#ifndef _ModelMesher_HeaderFile
+#define _ModelMesher_HeaderFile
+
+#include <IMeshTools_Parameters.hxx>
+#include <Message_ProgressRange.hxx>
+#include <NCollection_Sequence.hxx>
+#include <Prs3d_Drawer.hxx>
+#include <TopoDS_Shape.hxx>
+
+//! Statistics of meshed faces.
+struct ModelMeshStats {
+  int NbFaces = 0;   //!< number of meshed faces
+  int NbReused = 0;  //!< number of faces which triangulation has been kept
+};
+
+//! Chunked meshing of model shapes shared by the viewer and native tools.
+//!
+//! Shapes are meshed by chunks: solids, plus a compound of faces outside of
+//! solids, or the whole shape if it has no solids.
+//!
+//! Mesh quality is defined by presentation attributes in the same way as for
+//! AIS: deflection type, deviation coefficient or maximal chordal deviation,
+//! and deviation angle. Relative deflection is computed from the bounding
+//! box of every chunk rather than of the whole shape, so that small parts
+//! within a large assembly are not meshed too coarsely.
+class ModelMesher {
+ public:
+  //! Split shape into chunks meshed at once.
+  static void SplitShape(const TopoDS_Shape& theShape,
+                         NCollection_Sequence<TopoDS_Shape>& theChunks);
+
+  //! Compute meshing parameters of the chunk from attributes.
+  static IMeshTools_Parameters MeshParameters(
+      const TopoDS_Shape& theChunk, const Handle(Prs3d_Drawer) & theDrawer);
+
+  //! Mesh the chunk reusing triangulation of faces within tolerance.
+  //! @param theChunk       [in] shape to mesh
+  //! @param theDrawer      [in] attributes defining mesh quality
+  //! @param theMinRatio    [in] faces meshed finer than theMinRatio of
+  //!                            deflection are remeshed; 0 keeps them
+  //! @param theToRemeshAll [in] remesh all faces
+  //! @param theStats       [in,out] statistics of meshed faces
+  //! @param theProgress    [in] progress range
+  static void MeshChunk(const TopoDS_Shape& theChunk,
+                        const Handle(Prs3d_Drawer) & theDrawer,
+                        double theMinRatio, bool theToRemeshAll,
+                        ModelMeshStats& theStats,
+                        const Message_ProgressRange& theProgress =
+                            Message_ProgressRange());
+
+  //! Mesh all chunks of the shape, keeping any existing triangulation
+  //! which is fine enough.
+  //! @param theShape    [in] shape to mesh
+  //! @param theDrawer   [in] attributes defining mesh quality
+  //! @param theStats    [in,out] statistics of meshed faces
+  //! @param theProgress [in] progress range
+  //! @return FALSE if meshing has been cancelled
+  static bool MeshShape(const TopoDS_Shape& theShape,
+                        const Handle(Prs3d_Drawer) & theDrawer,
+                        ModelMeshStats& theStats,
+                        const Message_ProgressRange& theProgress =
+                            Message_ProgressRange());
+};
+
+#endif  // _ModelMesher_HeaderFile
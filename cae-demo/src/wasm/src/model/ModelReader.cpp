@@ -0,0 +1,323 @@
+// Copyright (c) 2019 OPEN CASCADE SAS
+//
+// This file is part of the examples of the Open CASCADE Technology software
+// library.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE
+
+#include "ModelReader.h"
+
+#include <BRepTools.hxx>
+#include <BRep_Builder.hxx>
+#include <BinTools.hxx>
+#include <IGESCAFControl_Reader.hxx>
+#include <Interface_Check.hxx>
+#include <Interface_CheckIterator.hxx>
+#include <Interface_InterfaceModel.hxx>
+#include <Message.hxx>
+#include <Message_ProgressScope.hxx>
+#include <STEPCAFControl_Reader.hxx>
+#include <Standard_Failure.hxx>
+#include <Standard_Version.hxx>
+#include <Transfer_TransientProcess.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+#include <XSControl_TransferReader.hxx>
+#include <XSControl_WorkSession.hxx>
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <random>
+#include <sstream>
+
+#include "DecompressStreamBuffer.h"
+#include "ModelFormat.h"
+
+namespace {
+//! Maximum number of attempts to create a unique temporary file.
+static const int THE_MAX_TMP_ATTEMPTS = 16;
+
+//! Create a new empty temporary file with a random name ending with the given
+//! file name; the file is created exclusively, so that the name is never
+//! shared with another thread or process. Returns empty path on failure.
+static std::filesystem::path createTmpFile(const std::string& theName) {
+  static std::atomic<unsigned int> THE_COUNTER(0);
+  std::error_code anErr;
+  const std::filesystem::path aTmpDir =
+      std::filesystem::temp_directory_path(anErr);
+  if (anErr) {
+    return std::filesystem::path();
+  }
+  std::random_device aRandom;
+  const std::string aFileName =
+      std::filesystem::path(theName).filename().string();
+  for (int anAttempt = 0; anAttempt < THE_MAX_TMP_ATTEMPTS; ++anAttempt) {
+    const std::filesystem::path aPath =
+        aTmpDir / (std::to_string(aRandom()) + "-" +
+                   std::to_string(THE_COUNTER++) + "-" + aFileName);
+    if (FILE* aFile = std::fopen(aPath.string().c_str(), "wbx")) {
+      std::fclose(aFile);
+      return aPath;
+    }
+  }
+  return std::filesystem::path();
+}
+
+//! Maximum number of failed entities reported one by one.
+static const int THE_MAX_REPORTED_FAILS = 10;
+
+//! Report entities which failed to transfer and were skipped, including
+//! exceptions caught by the transfer process for every single entity.
+static void reportTransferFails(const Handle(XSControl_WorkSession) & theWS,
+                                const std::string& theName) {
+  const Handle(Transfer_TransientProcess)& aTP =
+      theWS->TransferReader()->TransientProcess();
+  if (aTP.IsNull()) {
+    return;
+  }
+
+  const Handle(Interface_InterfaceModel)& aModel = theWS->Model();
+  int aNbFails = 0;
+  const Interface_CheckIterator aChecks = aTP->CheckList(true);
+  for (aChecks.Start(); aChecks.More(); aChecks.Next()) {
+    const Handle(Interface_Check)& aCheck = aChecks.Value();
+    if (!aCheck->HasFailed() || ++aNbFails > THE_MAX_REPORTED_FAILS) {
+      continue;
+    }
+
+    TCollection_AsciiString anEntity("?");
+    if (aChecks.Number() > 0 && !aModel.IsNull()) {
+      const Handle(TCollection_HAsciiString) aLabel =
+          aModel->StringLabel(aModel->Value(aChecks.Number()));
+      if (!aLabel.IsNull()) {
+        anEntity = aLabel->String();
+      }
+    }
+    Message::SendWarning() << "Warning: entity " << anEntity << " of '"
+                           << theName.c_str()
+                           << "' is skipped: " << aCheck->CFail(1);
+  }
+  if (aNbFails > 0) {
+    Message::SendWarning() << "Warning: " << aNbFails << " entities of '"
+                           << theName.c_str()
+                           << "' failed to transfer and are skipped";
+  }
+}
+
+//! Transfer STEP model into the document. Malformed entities are skipped by
+//! the transfer process itself; if an exception still escapes before any
+//! shape is added to the document, roots are transferred one by one, so that
+//! a single failing part does not discard the rest of the model.
+static void transferStep(STEPCAFControl_Reader& theReader,
+                         const std::string& theName,
+                         const Handle(TDocStd_Document) & theDoc,
+                         const Message_ProgressRange& theRange) {
+  Message_ProgressScope aPS(theRange, "Transferring", 2);
+  try {
+    theReader.Transfer(theDoc, aPS.Next());
+    return;
+  } catch (const Standard_Failure& theFailure) {
+    Message::SendWarning() << "Warning: transfer of '" << theName.c_str()
+                           << "' failed: " << theFailure.GetMessageString();
+  }
+
+  TDF_LabelSequence aFreeShapes;
+  XCAFDoc_DocumentTool::ShapeTool(theDoc->Main())->GetFreeShapes(aFreeShapes);
+  if (!aFreeShapes.IsEmpty()) {
+    // shapes are already in the document, failure happened on attributes
+    return;
+  }
+
+  const int aNbRoots = theReader.ChangeReader().NbRootsForTransfer();
+  Message_ProgressScope aRootPS(aPS.Next(), "Transferring", aNbRoots);
+  for (int aRootIter = 1; aRootIter <= aNbRoots && aRootPS.More();
+       ++aRootIter) {
+    try {
+      theReader.TransferOneRoot(aRootIter, theDoc, aRootPS.Next());
+    } catch (const Standard_Failure& theFailure) {
+      Message::SendWarning() << "Warning: root " << aRootIter << " of '"
+                             << theName.c_str() << "' is skipped: "
+                             << theFailure.GetMessageString();
+    }
+  }
+}
+
+//! Transfer IGES model into the document. The reader adds shapes to the
+//! document only after all roots are transferred, so if an exception
+//! escapes, roots are transferred one by one and successfully transferred
+//! shapes are added to the document without names and colors.
+static void transferIges(IGESCAFControl_Reader& theReader,
+                         const std::string& theName,
+                         const Handle(TDocStd_Document) & theDoc,
+                         const Message_ProgressRange& theRange) {
+  Message_ProgressScope aPS(theRange, "Transferring", 2);
+  try {
+    theReader.Transfer(theDoc, aPS.Next());
+    return;
+  } catch (const Standard_Failure& theFailure) {
+    Message::SendWarning() << "Warning: transfer of '" << theName.c_str()
+                           << "' failed: " << theFailure.GetMessageString();
+  }
+
+  TDF_LabelSequence aFreeShapes;
+  const Handle(XCAFDoc_ShapeTool) aShapeTool =
+      XCAFDoc_DocumentTool::ShapeTool(theDoc->Main());
+  aShapeTool->GetFreeShapes(aFreeShapes);
+  if (!aFreeShapes.IsEmpty()) {
+    // shapes are already in the document, failure happened on attributes
+    return;
+  }
+
+  theReader.ClearShapes();
+  const int aNbRoots = theReader.NbRootsForTransfer();
+  Message_ProgressScope aRootPS(aPS.Next(), "Transferring", aNbRoots);
+  for (int aRootIter = 1; aRootIter <= aNbRoots && aRootPS.More();
+       ++aRootIter) {
+    try {
+      theReader.TransferOneRoot(aRootIter, aRootPS.Next());
+    } catch (const Standard_Failure& theFailure) {
+      Message::SendWarning() << "Warning: root " << aRootIter << " of '"
+                             << theName.c_str() << "' is skipped: "
+                             << theFailure.GetMessageString();
+    }
+  }
+  for (int aShapeIter = 1; aShapeIter <= theReader.NbShapes(); ++aShapeIter) {
+    aShapeTool->AddShape(theReader.Shape(aShapeIter), false);
+  }
+}
+}  // namespace
+
+// ================================================================
+// Function : ReadFile
+// Purpose  :
+// ================================================================
+bool ModelReader::ReadFile(const std::string& thePath, std::string& theData) {
+  std::ifstream aFile(thePath, std::ios::binary);
+  if (!aFile) {
+    return false;
+  }
+  std::ostringstream aStream;
+  aStream << aFile.rdbuf();
+  theData = aStream.str();
+  return true;
+}
+
+// ================================================================
+// Function : ReadBRep
+// Purpose  :
+// ================================================================
+bool ModelReader::ReadBRep(const std::string& theName, const char* theData,
+                           size_t theLen, TopoDS_Shape& theShape,
+                           const Message_ProgressRange& theRange) {
+  theShape.Nullify();
+  const ModelFormat aFormat = ModelFormatTool::Detect(theName, theData, theLen);
+  if (aFormat != ModelFormat_BRep && aFormat != ModelFormat_BinBRep) {
+    return false;
+  }
+
+  DecompressStreamBuffer aStreamBuffer(theData, theLen);
+  std::istream aStream(&aStreamBuffer);
+  if (aFormat == ModelFormat_BinBRep) {
+    BinTools::Read(theShape, aStream, theRange);
+  } else {
+    BRep_Builder aBuilder;
+    BRepTools::Read(theShape, aStream, aBuilder, theRange);
+  }
+  if (!aStreamBuffer.IsGood()) {
+    theShape.Nullify();
+    return false;
+  }
+  return !theShape.IsNull();
+}
+
+// ================================================================
+// Function : ReadXCaf
+// Purpose  :
+// ================================================================
+bool ModelReader::ReadXCaf(const std::string& theName, const char* theData,
+                           size_t theLen,
+                           const Handle(TDocStd_Document) & theDoc,
+                           const Message_ProgressRange& theRange) {
+  const std::string aPlainName =
+      DecompressStreamBuffer::StripCodecExtension(theName);
+  Message_ProgressScope aPS(theRange, "Loading", 70);
+
+  // compressed data is inflated chunk by chunk while the reader consumes it
+  DecompressStreamBuffer aStreamBuffer(theData, theLen);
+  std::istream aStream(&aStreamBuffer);
+  std::filesystem::path aTmpPath;
+  std::error_code anErr;
+  const auto writeTmpFile = [&aStream, &aTmpPath, &aPlainName]() {
+    aTmpPath = createTmpFile(aPlainName);
+    if (aTmpPath.empty()) {
+      Message::SendFail() << "Error: unable to create temporary file for '"
+                          << aPlainName.c_str() << "'";
+      return;
+    }
+    std::ofstream aFile(aTmpPath, std::ios::binary);
+    aFile << aStream.rdbuf();
+  };
+
+  // readers are destroyed right after transfer to release the model
+  // of the file before meshing
+  bool isRead = false;
+  Message_ProgressScope aReadPS(aPS.Next(20), "Reading", 1);
+  if (ModelFormatTool::Detect(theName, theData, theLen) != ModelFormat_IGES) {
+    STEPCAFControl_Reader aReader;
+    aReader.SetColorMode(true);
+    aReader.SetNameMode(true);
+    aReader.SetLayerMode(true);
+#if OCC_VERSION_HEX >= 0x070700
+    // STEP is parsed directly from the stream without temporary file
+    const IFSelect_ReturnStatus aStatus =
+        aReader.ReadStream(aPlainName.c_str(), aStream);
+#else
+    writeTmpFile();
+    const IFSelect_ReturnStatus aStatus =
+        aReader.ReadFile(aTmpPath.string().c_str());
+    std::filesystem::remove(aTmpPath, anErr);
+#endif
+    if (aStatus == IFSelect_RetDone && aStreamBuffer.IsGood()) {
+      isRead = true;
+      aReadPS.Next();
+      transferStep(aReader, aPlainName, theDoc, aPS.Next(50));
+      reportTransferFails(aReader.Reader().WS(), aPlainName);
+    }
+  } else {
+    // IGES reader supports only files - data is written in chunks,
+    // without inflating the whole file in memory first
+    writeTmpFile();
+    IGESCAFControl_Reader aReader;
+    aReader.SetColorMode(true);
+    aReader.SetNameMode(true);
+    aReader.SetLayerMode(true);
+    if (aStreamBuffer.IsGood() && !aTmpPath.empty() &&
+        aReader.ReadFile(aTmpPath.string().c_str()) == IFSelect_RetDone) {
+      isRead = true;
+      aReadPS.Next();
+      transferIges(aReader, aPlainName, theDoc, aPS.Next(50));
+      reportTransferFails(aReader.WS(), aPlainName);
+    }
+    std::filesystem::remove(aTmpPath, anErr);
+  }
+  return isRead;
+}
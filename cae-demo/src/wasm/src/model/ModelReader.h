@@ -0,0 +1,71 @@
+// Copyright (c) 2019 OPEN CASCADE SAS
+//
+// This file is part of the examples of the Open CASCADE Technology software
+// library.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE
+
+#ifndef _ModelReader_HeaderFile
+#define _ModelReader_HeaderFile
+
+#include <Message_ProgressRange.hxx>
+#include <TDocStd_Document.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <cstddef>
+#include <string>
+
+//! Readers of model files shared by the viewer and native tools.
+class ModelReader {
+ public:
+  //! Read whole file into memory.
+  static bool ReadFile(const std::string& thePath, std::string& theData);
+
+  //! Read ASCII or binary BRep from memory; compressed data is inflated
+  //! while parsing.
+  //! @param theName  [in] file name
+  //! @param theData  [in] file data
+  //! @param theLen   [in] data length
+  //! @param theShape [out] read shape
+  //! @param theRange [in] progress range
+  //! @return FALSE if data is not BRep, cannot be decompressed or read
+  static bool ReadBRep(const std::string& theName, const char* theData,
+                       size_t theLen, TopoDS_Shape& theShape,
+                       const Message_ProgressRange& theRange =
+                           Message_ProgressRange());
+
+  //! Read STEP or IGES file from memory into XCAF document with assembly
+  //! structure, names, colors and layers; compressed data is inflated while
+  //! parsing. Files which cannot be parsed from stream are written into
+  //! a new uniquely named temporary file. Entities and parts which
+  //! fail to transfer (including OCCT exceptions, when the build can catch
+  //! them) are skipped and reported by Message warnings.
+  //! @param theName  [in] file name, format is detected from data and name
+  //! @param theData  [in] file data
+  //! @param theLen   [in] data length
+  //! @param theDoc   [in] XCAF document to fill
+  //! @param theRange [in] progress range
+  //! @return FALSE if data cannot be decompressed or read
+  static bool ReadXCaf(const std::string& theName, const char* theData,
+                       size_t theLen, const Handle(TDocStd_Document) & theDoc,
+                       const Message_ProgressRange& theRange =
+                           Message_ProgressRange());
+};
+
+#endif  // _ModelReader_HeaderFile
@@ -0,0 +1,340 @@
+#include "ModelTree.h"
+
+#include <TCollection_AsciiString.hxx>
+#include <TDF_ChildIterator.hxx>
+#include <TDF_LabelMap.hxx>
+#include <TDF_Tool.hxx>
+#include <TDataStd_Name.hxx>
+#include <XCAFApp_Application.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+//! Return label entry.
+std::string labelEntry(const TDF_Label& theLabel) {
+  TCollection_AsciiString anEntry;
+  TDF_Tool::Entry(theLabel, anEntry);
+  return anEntry.ToCString();
+}
+
+//! Return UTF-8 name of the label, or empty string.
+std::string labelName(const TDF_Label& theLabel) {
+  Handle(TDataStd_Name) aNameAttr;
+  if (!theLabel.FindAttribute(TDataStd_Name::GetID(), aNameAttr)) {
+    return std::string();
+  }
+  return TCollection_AsciiString(aNameAttr->Get()).ToCString();
+}
+
+//! Return string with ASCII letters in lower case.
+std::string toLowerCase(const std::string& theString) {
+  std::string aResult = theString;
+  for (char& aChar : aResult) {
+    aChar = (char)std::tolower((unsigned char)aChar);
+  }
+  return aResult;
+}
+}  // namespace
+
+// ================================================================
+// Function : ModelTree
+// Purpose  :
+// ================================================================
+ModelTree::ModelTree(const Handle(TDocStd_Document) & theDoc)
+    : myDoc(theDoc), myHasNameIndex(false) {
+  myShapeTool = XCAFDoc_DocumentTool::ShapeTool(myDoc->Main());
+  myShapeTool->GetFreeShapes(myRoots);
+  int aRootIndex = 0;
+  for (TDF_LabelSequence::Iterator aRootIter(myRoots); aRootIter.More();
+       aRootIter.Next(), ++aRootIndex) {
+    myRootIndices.Bind(aRootIter.Value(), aRootIndex);
+  }
+}
+
+// ================================================================
+// Function : ~ModelTree
+// Purpose  :
+// ================================================================
+ModelTree::~ModelTree() {
+  if (!myDoc.IsNull() && myDoc->IsOpened()) {
+    XCAFApp_Application::GetApplication()->Close(myDoc);
+  }
+}
+
+// ================================================================
+// Function : referredLabel
+// Purpose  :
+// ================================================================
+TDF_Label ModelTree::referredLabel(const TDF_Label& theLabel) const {
+  TDF_Label aReferred;
+  if (XCAFDoc_ShapeTool::GetReferredShape(theLabel, aReferred)) {
+    return aReferred;
+  }
+  return theLabel;
+}
+
+// ================================================================
+// Function : findNode
+// Purpose  :
+// ================================================================
+bool ModelTree::findNode(const std::string& theNodeId, int& theRootIndex,
+                         TDF_Label& theLabel,
+                         TopLoc_Location* theLocation) const {
+  theLabel.Nullify();
+  for (size_t aStart = 0; aStart <= theNodeId.size();) {
+    const size_t anEnd =
+        std::min(theNodeId.find('/', aStart), theNodeId.size());
+    TDF_Label aLabel;
+    TDF_Tool::Label(myDoc->GetData(),
+                    theNodeId.substr(aStart, anEnd - aStart).c_str(), aLabel,
+                    false);
+    if (aLabel.IsNull()) {
+      return false;
+    }
+
+    if (theLabel.IsNull()) {
+      const int* aRootIndex = myRootIndices.Seek(aLabel);
+      if (aRootIndex == nullptr) {
+        return false;
+      }
+      theRootIndex = *aRootIndex;
+      if (theLocation != nullptr) {
+        *theLocation = XCAFDoc_ShapeTool::GetShape(aLabel).Location();
+      }
+    } else if (!XCAFDoc_ShapeTool::IsComponent(aLabel) ||
+               aLabel.Father() != referredLabel(theLabel)) {
+      return false;
+    } else if (theLocation != nullptr) {
+      *theLocation = *theLocation * XCAFDoc_ShapeTool::GetLocation(aLabel);
+    }
+    theLabel = aLabel;
+    aStart = anEnd + 1;
+  }
+  return !theLabel.IsNull();
+}
+
+// ================================================================
+// Function : makeNode
+// Purpose  :
+// ================================================================
+ModelTreeNode ModelTree::makeNode(const std::string& theId, int theRootIndex,
+                                  const TDF_Label& theLabel) const {
+  const TDF_Label aReferred = referredLabel(theLabel);
+  ModelTreeNode aNode;
+  aNode.Id = theId;
+  aNode.Name = labelName(theLabel);
+  if (aNode.Name.empty()) {
+    aNode.Name = labelName(aReferred);
+  }
+  aNode.ObjectIndex = theRootIndex;
+  aNode.IsAssembly = XCAFDoc_ShapeTool::IsAssembly(aReferred);
+  aNode.NbChildren =
+      aNode.IsAssembly ? XCAFDoc_ShapeTool::NbComponents(aReferred) : 0;
+  return aNode;
+}
+
+// ================================================================
+// Function : NbChildren
+// Purpose  :
+// ================================================================
+int ModelTree::NbChildren(const std::string& theNodeId) const {
+  if (theNodeId.empty()) {
+    return myRoots.Size();
+  }
+
+  int aRootIndex = -1;
+  TDF_Label aLabel;
+  if (!findNode(theNodeId, aRootIndex, aLabel)) {
+    return -1;
+  }
+  const TDF_Label aReferred = referredLabel(aLabel);
+  return XCAFDoc_ShapeTool::IsAssembly(aReferred)
+             ? XCAFDoc_ShapeTool::NbComponents(aReferred)
+             : 0;
+}
+
+// ================================================================
+// Function : Children
+// Purpose  :
+// ================================================================
+std::vector<ModelTreeNode> ModelTree::Children(const std::string& theNodeId,
+                                               int theOffset,
+                                               int theCount) const {
+  std::vector<ModelTreeNode> aNodes;
+  if (theOffset < 0 || theCount <= 0) {
+    return aNodes;
+  }
+
+  if (theNodeId.empty()) {
+    for (int aRootIter = theOffset;
+         aRootIter < std::min(myRoots.Size(), theOffset + theCount);
+         ++aRootIter) {
+      const TDF_Label& aRoot = myRoots.Value(aRootIter + 1);
+      aNodes.push_back(makeNode(labelEntry(aRoot), aRootIter, aRoot));
+    }
+    return aNodes;
+  }
+
+  int aRootIndex = -1;
+  TDF_Label aLabel;
+  if (!findNode(theNodeId, aRootIndex, aLabel)) {
+    return aNodes;
+  }
+
+  // components are sub-labels of the assembly label
+  int aChildIndex = 0;
+  for (TDF_ChildIterator aChildIter(referredLabel(aLabel));
+       aChildIter.More() && int(aNodes.size()) < theCount;
+       aChildIter.Next()) {
+    const TDF_Label aChild = aChildIter.Value();
+    if (!XCAFDoc_ShapeTool::IsComponent(aChild) ||
+        aChildIndex++ < theOffset) {
+      continue;
+    }
+    aNodes.push_back(
+        makeNode(theNodeId + "/" + labelEntry(aChild), aRootIndex, aChild));
+  }
+  return aNodes;
+}
+
+// ================================================================
+// Function : NodeShape
+// Purpose  :
+// ================================================================
+TopoDS_Shape ModelTree::NodeShape(const std::string& theNodeId,
+                                  int& theRootIndex) const {
+  TDF_Label aLabel;
+  TopLoc_Location aLocation;
+  if (!findNode(theNodeId, theRootIndex, aLabel, &aLocation)) {
+    return TopoDS_Shape();
+  }
+  if (!XCAFDoc_ShapeTool::IsComponent(aLabel)) {
+    return XCAFDoc_ShapeTool::GetShape(aLabel);
+  }
+  // component location already includes the location of the referred shape;
+  // the same location is composed while exploring the root compound
+  return XCAFDoc_ShapeTool::GetShape(referredLabel(aLabel))
+      .Located(aLocation);
+}
+
+// ================================================================
+// Function : buildNameIndex
+// Purpose  :
+// ================================================================
+void ModelTree::buildNameIndex() {
+  myHasNameIndex = true;
+  for (TDF_ChildIterator aLabelIter(myShapeTool->Label(), true);
+       aLabelIter.More(); aLabelIter.Next()) {
+    const std::string aName = toLowerCase(labelName(aLabelIter.Value()));
+    // non-ASCII bytes of UTF-8 sequences are kept within words
+    size_t aWordStart = std::string::npos;
+    for (size_t aCharIter = 0; aCharIter <= aName.size(); ++aCharIter) {
+      const unsigned char aChar =
+          aCharIter < aName.size() ? (unsigned char)aName[aCharIter] : ' ';
+      const bool isWordChar = aChar >= 0x80 || std::isalnum(aChar);
+      if (isWordChar && aWordStart == std::string::npos) {
+        aWordStart = aCharIter;
+      } else if (!isWordChar && aWordStart != std::string::npos) {
+        myNameIndex.emplace_back(
+            aName.substr(aWordStart, aCharIter - aWordStart),
+            aLabelIter.Value());
+        aWordStart = std::string::npos;
+      }
+    }
+  }
+  std::sort(myNameIndex.begin(), myNameIndex.end(),
+            [](const std::pair<std::string, TDF_Label>& theLeft,
+               const std::pair<std::string, TDF_Label>& theRight) {
+              return theLeft.first < theRight.first;
+            });
+}
+
+// ================================================================
+// Function : collectOccurrences
+// Purpose  :
+// ================================================================
+void ModelTree::collectOccurrences(const TDF_Label& theLabel,
+                                   const std::string& theSuffix,
+                                   const TDF_Label& theNodeLabel,
+                                   std::vector<ModelTreeNode>& theNodes,
+                                   int theMaxResults) const {
+  if (int(theNodes.size()) >= theMaxResults) {
+    return;
+  }
+
+  const std::string aPath =
+      labelEntry(theLabel) + (theSuffix.empty() ? "" : "/" + theSuffix);
+  if (const int* aRootIndex = myRootIndices.Seek(theLabel)) {
+    theNodes.push_back(makeNode(aPath, *aRootIndex, theNodeLabel));
+    return;
+  }
+  if (!XCAFDoc_ShapeTool::IsComponent(theLabel)) {
+    return;
+  }
+
+  // component belongs to every occurrence of its assembly
+  const TDF_Label anAssembly = theLabel.Father();
+  if (myRootIndices.IsBound(anAssembly)) {
+    collectOccurrences(anAssembly, aPath, theNodeLabel, theNodes,
+                       theMaxResults);
+    return;
+  }
+  TDF_LabelSequence aUsers;
+  XCAFDoc_ShapeTool::GetUsers(anAssembly, aUsers, false);
+  for (TDF_LabelSequence::Iterator aUserIter(aUsers); aUserIter.More();
+       aUserIter.Next()) {
+    collectOccurrences(aUserIter.Value(), aPath, theNodeLabel, theNodes,
+                       theMaxResults);
+  }
+}
+
+// ================================================================
+// Function : Find
+// Purpose  :
+// ================================================================
+std::vector<ModelTreeNode> ModelTree::Find(const std::string& theQuery,
+                                           int theMaxResults) {
+  std::vector<ModelTreeNode> aNodes;
+  const std::string aQuery = toLowerCase(theQuery);
+  if (aQuery.empty() || theMaxResults <= 0) {
+    return aNodes;
+  }
+  if (!myHasNameIndex) {
+    buildNameIndex();
+  }
+
+  const auto isLess = [](const std::pair<std::string, TDF_Label>& theItem,
+                         const std::string& theValue) {
+    return theItem.first < theValue;
+  };
+  TDF_LabelMap aFoundLabels;
+  for (auto aWordIter = std::lower_bound(myNameIndex.begin(),
+                                         myNameIndex.end(), aQuery, isLess);
+       aWordIter != myNameIndex.end() &&
+       aWordIter->first.compare(0, aQuery.size(), aQuery) == 0 &&
+       int(aNodes.size()) < theMaxResults;
+       ++aWordIter) {
+    const TDF_Label& aLabel = aWordIter->second;
+    if (!aFoundLabels.Add(aLabel)) {
+      continue;
+    }
+
+    // products are found through the components referring to them
+    if (myRootIndices.IsBound(aLabel) ||
+        XCAFDoc_ShapeTool::IsComponent(aLabel)) {
+      collectOccurrences(aLabel, std::string(), aLabel, aNodes,
+                         theMaxResults);
+      continue;
+    }
+    TDF_LabelSequence aUsers;
+    XCAFDoc_ShapeTool::GetUsers(aLabel, aUsers, false);
+    for (TDF_LabelSequence::Iterator aUserIter(aUsers); aUserIter.More();
+         aUserIter.Next()) {
+      collectOccurrences(aUserIter.Value(), std::string(), aUserIter.Value(),
+                         aNodes, theMaxResults);
+    }
+  }
+  return aNodes;
+}
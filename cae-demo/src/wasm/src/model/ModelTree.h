@@ -0,0 +1,126 @@
+#ifndef _ModelTree_HeaderFile
+#define _ModelTree_HeaderFile
+
+#include <NCollection_DataMap.hxx>
+#include <TDF_Label.hxx>
+#include <TDF_LabelMapHasher.hxx>
+#include <TDF_LabelSequence.hxx>
+#include <TDocStd_Document.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Shape.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+//! Node of the model tree.
+struct ModelTreeNode {
+  std::string Id;           //!< stable node id, see ModelTree
+  std::string Name;         //!< instance name, or name of the product
+  int NbChildren = 0;       //!< number of child nodes
+  int ObjectIndex = -1;     //!< index of the model object of the root
+                            //!< containing the node, see NodeShape()
+  bool IsAssembly = false;  //!< node is an assembly
+};
+
+//! Assembly tree of XCAF document, expanded lazily by pages.
+//!
+//! Nodes are occurrences of shapes: roots are free shapes of the document
+//! (displayed as model objects in the same order), and children of an
+//! assembly node are its components. Node id is the path of label entries
+//! from the root, separated by '/', e.g. "0:1:1:1/0:1:1:1:3", so that ids
+//! are stable for the same document and are resolved without keeping any
+//! per-node state. Only the requested page of nodes is materialized.
+//!
+//! Roots are displayed as whole objects, so a nested node is displayed as
+//! a located sub-shape of its root object; NodeShape() resolves the node id
+//! into this occurrence shape.
+//!
+//! Name search uses an index of words of TDataStd_Name attributes built on
+//! the first search; found labels are mapped to occurrence node ids by
+//! walking up through assemblies using them.
+class ModelTree : public Standard_Transient {
+  DEFINE_STANDARD_RTTI_INLINE(ModelTree, Standard_Transient)
+ public:
+  //! Main constructor taking ownership of the document,
+  //! which is closed on destruction.
+  ModelTree(const Handle(TDocStd_Document) & theDoc);
+
+  //! Destructor.
+  virtual ~ModelTree();
+
+  //! Return document.
+  const Handle(TDocStd_Document) & Document() const { return myDoc; }
+
+  //! Return free shapes of the document.
+  const TDF_LabelSequence& Roots() const { return myRoots; }
+
+  //! Return number of children of the node, or -1 if node is not found.
+  //! @param theNodeId [in] node id, empty string for the roots
+  int NbChildren(const std::string& theNodeId) const;
+
+  //! Return page of children of the node.
+  //! @param theNodeId [in] node id, empty string for the roots
+  //! @param theOffset [in] index of the first child
+  //! @param theCount  [in] maximum number of children to return
+  std::vector<ModelTreeNode> Children(const std::string& theNodeId,
+                                      int theOffset, int theCount) const;
+
+  //! Find nodes which name has a word starting with the query
+  //! (case-insensitive).
+  //! @param theQuery      [in] word prefix
+  //! @param theMaxResults [in] maximum number of nodes to return
+  std::vector<ModelTreeNode> Find(const std::string& theQuery,
+                                  int theMaxResults);
+
+  //! Return shape of the node occurrence, located within the shape of its
+  //! root as displayed by the root object.
+  //! @param theNodeId    [in] node id
+  //! @param theRootIndex [out] index of the root containing the node
+  //! @return NULL shape if node is not found
+  TopoDS_Shape NodeShape(const std::string& theNodeId,
+                         int& theRootIndex) const;
+
+ private:
+  //! Resolve node id into root index and label of the last path element.
+  //! @param theLocation [out] optional location of the node occurrence,
+  //!                          composed of the root and component locations
+  bool findNode(const std::string& theNodeId, int& theRootIndex,
+                TDF_Label& theLabel,
+                TopLoc_Location* theLocation = nullptr) const;
+
+  //! Return shape label referred by the node label.
+  TDF_Label referredLabel(const TDF_Label& theLabel) const;
+
+  //! Fill in node description.
+  ModelTreeNode makeNode(const std::string& theId, int theRootIndex,
+                         const TDF_Label& theLabel) const;
+
+  //! Build index of words of label names.
+  void buildNameIndex();
+
+  //! Append occurrences of the node through the root or component label.
+  //! @param theLabel      [in] root or component label
+  //! @param theSuffix     [in] path of the node below theLabel
+  //! @param theNodeLabel  [in] label of the node
+  //! @param theNodes      [in,out] found nodes
+  //! @param theMaxResults [in] maximum number of nodes
+  void collectOccurrences(const TDF_Label& theLabel,
+                          const std::string& theSuffix,
+                          const TDF_Label& theNodeLabel,
+                          std::vector<ModelTreeNode>& theNodes,
+                          int theMaxResults) const;
+
+ private:
+  Handle(TDocStd_Document) myDoc;        //!< XCAF document
+  Handle(XCAFDoc_ShapeTool) myShapeTool;  //!< shape tool of the document
+  TDF_LabelSequence myRoots;              //!< free shapes
+  NCollection_DataMap<TDF_Label, int, TDF_LabelMapHasher>
+      myRootIndices;  //!< map of free shapes to their indices
+  std::vector<std::pair<std::string, TDF_Label>>
+      myNameIndex;  //!< sorted lowercase words of names
+  bool myHasNameIndex;  //!< name index has been built
+};
+
+#endif  // _ModelTree_HeaderFile
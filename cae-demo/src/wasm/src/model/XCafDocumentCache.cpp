@@ -0,0 +1,248 @@
+#include "XCafDocumentCache.h"
+
+#include <BinXCAFDrivers.hxx>
+#include <Message.hxx>
+#include <PCDM_StoreStatus.hxx>
+#include <XCAFApp_Application.hxx>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace {
+//! Cache directory.
+static TCollection_AsciiString THE_CACHE_DIR("/cache");
+
+//! Maximum total size of cached documents in bytes.
+static size_t THE_MAX_SIZE = size_t(256) << 20;
+
+//! Prefix of cache entries; should be changed together with reader settings
+//! affecting transferred documents to invalidate old entries.
+static const char THE_ENTRY_PREFIX[] = "xcaf1-";
+
+//! Return XCAF application with binary format registered.
+Handle(XCAFApp_Application) binaryApplication() {
+  static std::once_flag THE_INIT_FLAG;
+  Handle(XCAFApp_Application) anApp = XCAFApp_Application::GetApplication();
+  std::call_once(THE_INIT_FLAG,
+                 [&anApp]() { BinXCAFDrivers::DefineFormat(anApp); });
+  return anApp;
+}
+}  // namespace
+
+// ================================================================
+// Function : Directory
+// Purpose  :
+// ================================================================
+const TCollection_AsciiString& XCafDocumentCache::Directory() {
+  return THE_CACHE_DIR;
+}
+
+// ================================================================
+// Function : SetDirectory
+// Purpose  :
+// ================================================================
+void XCafDocumentCache::SetDirectory(const TCollection_AsciiString& theDir) {
+  THE_CACHE_DIR = theDir;
+}
+
+// ================================================================
+// Function : MaxSize
+// Purpose  :
+// ================================================================
+size_t XCafDocumentCache::MaxSize() { return THE_MAX_SIZE; }
+
+// ================================================================
+// Function : SetMaxSize
+// Purpose  :
+// ================================================================
+void XCafDocumentCache::SetMaxSize(size_t theSize) { THE_MAX_SIZE = theSize; }
+
+// ================================================================
+// Function : Key
+// Purpose  :
+// ================================================================
+TCollection_AsciiString XCafDocumentCache::Key(ModelFormat theFormat,
+                                               const char* theData,
+                                               size_t theLen) {
+  // 64-bit FNV-1a over 8-byte words - not cryptographic, but fast enough
+  // to hash hundreds of megabytes within the time of STEP header parsing
+  const uint64_t THE_PRIME = 0x100000001b3ull;
+  uint64_t aHash = 0xcbf29ce484222325ull;
+  size_t aPos = 0;
+  for (; aPos + sizeof(uint64_t) <= theLen; aPos += sizeof(uint64_t)) {
+    uint64_t aWord = 0;
+    ::memcpy(&aWord, theData + aPos, sizeof(uint64_t));
+    aHash = (aHash ^ aWord) * THE_PRIME;
+    aHash ^= aHash >> 29;
+  }
+  for (; aPos < theLen; ++aPos) {
+    aHash = (aHash ^ uint8_t(theData[aPos])) * THE_PRIME;
+  }
+
+  // data length is a part of key to make collisions even less probable,
+  // and the same data read as another format gives another document
+  char aKey[64];
+  ::snprintf(aKey, sizeof(aKey), "%016llx-%llx-%d", (unsigned long long)aHash,
+             (unsigned long long)theLen, int(theFormat));
+  return TCollection_AsciiString(aKey);
+}
+
+// ================================================================
+// Function : filePath
+// Purpose  :
+// ================================================================
+TCollection_AsciiString XCafDocumentCache::filePath(
+    const TCollection_AsciiString& theKey) {
+  return THE_CACHE_DIR + "/" + THE_ENTRY_PREFIX + theKey + ".xbf";
+}
+
+// ================================================================
+// Function : Load
+// Purpose  :
+// ================================================================
+bool XCafDocumentCache::Load(const TCollection_AsciiString& theKey,
+                             Handle(TDocStd_Document) & theDoc) {
+  theDoc.Nullify();
+  if (THE_CACHE_DIR.IsEmpty()) {
+    return false;
+  }
+
+  const TCollection_AsciiString aPath = filePath(theKey);
+  std::ifstream aFile(aPath.ToCString(), std::ios::binary);
+  if (!aFile) {
+    return false;
+  }
+
+  // stream version doesn't register file path within application,
+  // so that the same entry might be opened again before closing
+  const PCDM_ReaderStatus aStatus =
+      binaryApplication()->Open(aFile, theDoc);
+  if (aStatus != PCDM_RS_OK || theDoc.IsNull()) {
+    Message::SendWarning() << "Warning: unable to read cached document '"
+                           << aPath << "', status " << (int)aStatus;
+    theDoc.Nullify();
+    aFile.close();
+    std::error_code anErr;
+    std::filesystem::remove(aPath.ToCString(), anErr);
+    return false;
+  }
+
+  // modification time marks recently used entries
+  std::error_code anErr;
+  std::filesystem::last_write_time(
+      aPath.ToCString(), std::filesystem::file_time_type::clock::now(), anErr);
+  return true;
+}
+
+// ================================================================
+// Function : Save
+// Purpose  :
+// ================================================================
+bool XCafDocumentCache::Save(const TCollection_AsciiString& theKey,
+                             const Handle(TDocStd_Document) & theDoc) {
+  if (THE_CACHE_DIR.IsEmpty() || theDoc.IsNull()) {
+    return false;
+  }
+
+  std::error_code anErr;
+  std::filesystem::create_directories(THE_CACHE_DIR.ToCString(), anErr);
+
+  // write into temporary file first to never leave truncated entries
+  const TCollection_AsciiString aPath = filePath(theKey);
+  const TCollection_AsciiString aTmpPath = aPath + ".tmp";
+  const TCollection_ExtendedString aPrevFormat = theDoc->StorageFormat();
+  theDoc->ChangeStorageFormat("BinXCAF");
+  PCDM_StoreStatus aStatus = PCDM_SS_Failure;
+  {
+    std::ofstream aFile(aTmpPath.ToCString(), std::ios::binary);
+    if (aFile) {
+      aStatus = binaryApplication()->SaveAs(theDoc, aFile);
+    }
+    aFile.close();
+    if (aStatus == PCDM_SS_OK && !aFile) {
+      aStatus = PCDM_SS_WriteFailure;
+    }
+  }
+  theDoc->ChangeStorageFormat(aPrevFormat);
+
+  if (aStatus != PCDM_SS_OK) {
+    Message::SendWarning() << "Warning: unable to cache document '" << aPath
+                           << "', status " << (int)aStatus;
+    std::filesystem::remove(aTmpPath.ToCString(), anErr);
+    return false;
+  }
+  std::filesystem::rename(aTmpPath.ToCString(), aPath.ToCString(), anErr);
+  if (anErr) {
+    return false;
+  }
+  evict(aPath);
+  return true;
+}
+
+// ================================================================
+// Function : evict
+// Purpose  :
+// ================================================================
+void XCafDocumentCache::evict(const TCollection_AsciiString& theKeptPath) {
+  struct Entry {
+    std::filesystem::path Path;
+    std::filesystem::file_time_type Time;
+    uintmax_t Size;
+  };
+
+  std::vector<Entry> anEntries;
+  uintmax_t aTotalSize = 0;
+  std::error_code anErr;
+  for (const std::filesystem::directory_entry& anEntry :
+       std::filesystem::directory_iterator(THE_CACHE_DIR.ToCString(), anErr)) {
+    if (anEntry.path().filename().string().rfind(THE_ENTRY_PREFIX, 0) != 0) {
+      continue;
+    }
+    std::error_code anEntryErr;
+    const uintmax_t aSize = anEntry.file_size(anEntryErr);
+    const std::filesystem::file_time_type aTime =
+        anEntry.last_write_time(anEntryErr);
+    if (!anEntryErr) {
+      anEntries.push_back({anEntry.path(), aTime, aSize});
+      aTotalSize += aSize;
+    }
+  }
+
+  std::sort(anEntries.begin(), anEntries.end(),
+            [](const Entry& theLeft, const Entry& theRight) {
+              return theLeft.Time < theRight.Time;
+            });
+  for (const Entry& anEntry : anEntries) {
+    if (aTotalSize <= THE_MAX_SIZE) {
+      break;
+    }
+    if (anEntry.Path.string() != theKeptPath.ToCString() &&
+        std::filesystem::remove(anEntry.Path, anErr)) {
+      aTotalSize -= anEntry.Size;
+    }
+  }
+}
+
+// ================================================================
+// Function : Clear
+// Purpose  :
+// ================================================================
+void XCafDocumentCache::Clear() {
+  if (THE_CACHE_DIR.IsEmpty()) {
+    return;
+  }
+
+  std::error_code anErr;
+  for (const std::filesystem::directory_entry& anEntry :
+       std::filesystem::directory_iterator(THE_CACHE_DIR.ToCString(), anErr)) {
+    if (anEntry.path().filename().string().rfind(THE_ENTRY_PREFIX, 0) == 0) {
+      std::filesystem::remove(anEntry.path(), anErr);
+    }
+  }
+}
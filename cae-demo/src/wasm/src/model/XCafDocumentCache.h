@@ -0,0 +1,70 @@
+#ifndef _XCafDocumentCache_HeaderFile
+#define _XCafDocumentCache_HeaderFile
+
+#include <TCollection_AsciiString.hxx>
+#include <TDocStd_Document.hxx>
+
+#include <cstddef>
+
+#include "ModelFormat.h"
+
+//! Cache of transferred XCAF documents stored in OCCT binary format
+//! (BinXCAF). Documents are keyed by hash, length and format of the input
+//! file data, so that re-opening the same file restores assembly structure,
+//! names, colors and layers without parsing and transferring the STEP/IGES
+//! file again.
+//!
+//! Documents are stored without triangulation - meshing parameters may
+//! differ between sessions, so the shapes are meshed again after loading.
+//! Total size of the cache is limited: least recently used entries (by file
+//! modification time, updated on every load) are removed on saving.
+class XCafDocumentCache {
+ public:
+  //! Return cache directory, "/cache" by default.
+  static const TCollection_AsciiString& Directory();
+
+  //! Set cache directory; empty string disables the cache.
+  static void SetDirectory(const TCollection_AsciiString& theDir);
+
+  //! Return maximum total size of cached documents in bytes, 256 MiB by
+  //! default.
+  static size_t MaxSize();
+
+  //! Set maximum total size of cached documents in bytes.
+  static void SetMaxSize(size_t theSize);
+
+  //! Compute cache key of input file data.
+  //! @param theFormat [in] format the data is read as
+  //! @param theData   [in] file data (as is, including compressed data)
+  //! @param theLen    [in] data length
+  static TCollection_AsciiString Key(ModelFormat theFormat,
+                                     const char* theData, size_t theLen);
+
+  //! Load document from cache.
+  //! @param theKey [in] cache key
+  //! @param theDoc [out] loaded document, should be closed by caller
+  //! @return FALSE if document is not in cache or cannot be read
+  static bool Load(const TCollection_AsciiString& theKey,
+                   Handle(TDocStd_Document) & theDoc);
+
+  //! Save document into cache. Existing entry is overwritten, and least
+  //! recently used entries are removed to fit into MaxSize().
+  //! @param theKey [in] cache key
+  //! @param theDoc [in] document to store
+  static bool Save(const TCollection_AsciiString& theKey,
+                   const Handle(TDocStd_Document) & theDoc);
+
+  //! Remove all cached documents.
+  static void Clear();
+
+ private:
+  //! Return path to cache entry.
+  static TCollection_AsciiString filePath(
+      const TCollection_AsciiString& theKey);
+
+  //! Remove least recently used entries exceeding MaxSize(),
+  //! except the given one.
+  static void evict(const TCollection_AsciiString& theKeptPath);
+};
+
+#endif  // _XCafDocumentCache_HeaderFile
@@ -0,0 +1,101 @@
+// Copyright (c) 2019 OPEN CASCADE SAS
+//
+// This file is part of the examples of the Open CASCADE Technology software
+// library.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE
+
+#include "OcctViewSetup.h"
+
+#include <Graphic3d_GraphicDriver.hxx>
+#include <V3d_Light.hxx>
+
+// ================================================================
+// Function : CreateViewer
+// Purpose  :
+// ================================================================
+Handle(V3d_Viewer) OcctViewSetup::CreateViewer(
+    const Handle(Graphic3d_GraphicDriver) & theDriver) {
+  Handle(V3d_Viewer) aViewer = new V3d_Viewer(theDriver);
+  aViewer->SetComputedMode(false);
+  aViewer->SetDefaultShadingModel(Graphic3d_TypeOfShadingModel_Phong);
+  aViewer->SetDefaultLights();
+  aViewer->SetLightOn();
+  for (V3d_ListOfLight::Iterator aLightIter(aViewer->ActiveLights());
+       aLightIter.More(); aLightIter.Next()) {
+    const Handle(V3d_Light)& aLight = aLightIter.Value();
+    if (aLight->Type() == Graphic3d_TypeOfLightSource_Directional) {
+      aLight->SetCastShadows(true);
+    }
+  }
+  return aViewer;
+}
+
+// ================================================================
+// Function : CreateTextStyle
+// Purpose  :
+// ================================================================
+Handle(Prs3d_TextAspect) OcctViewSetup::CreateTextStyle() {
+  Handle(Prs3d_TextAspect) aTextStyle = new Prs3d_TextAspect();
+  aTextStyle->SetFont(Font_NOF_ASCII_MONO);
+  aTextStyle->SetHeight(12);
+  aTextStyle->Aspect()->SetColor(Quantity_NOC_GRAY95);
+  aTextStyle->Aspect()->SetColorSubTitle(Quantity_NOC_BLACK);
+  aTextStyle->Aspect()->SetDisplayType(Aspect_TODT_SHADOW);
+  aTextStyle->Aspect()->SetTextFontAspect(Font_FA_Bold);
+  aTextStyle->Aspect()->SetTextZoomable(false);
+  aTextStyle->SetHorizontalJustification(Graphic3d_HTA_LEFT);
+  aTextStyle->SetVerticalJustification(Graphic3d_VTA_BOTTOM);
+  return aTextStyle;
+}
+
+// ================================================================
+// Function : CreateView
+// Purpose  :
+// ================================================================
+Handle(V3d_View) OcctViewSetup::CreateView(
+    const Handle(V3d_Viewer) & theViewer,
+    const Handle(Aspect_Window) & theWindow, float theDevicePixelRatio) {
+  Handle(V3d_View) aView = new V3d_View(theViewer);
+  aView->Camera()->SetProjectionType(Graphic3d_Camera::Projection_Perspective);
+  aView->SetImmediateUpdate(false);
+  aView->ChangeRenderingParams().IsShadowEnabled = false;
+  aView->ChangeRenderingParams().Resolution =
+      (unsigned int)(96.0 * theDevicePixelRatio + 0.5);
+  aView->SetWindow(theWindow);
+  return aView;
+}
+
+// ================================================================
+// Function : CreateContext
+// Purpose  :
+// ================================================================
+Handle(AIS_InteractiveContext) OcctViewSetup::CreateContext(
+    const Handle(V3d_Viewer) & theViewer) {
+  Handle(AIS_InteractiveContext) aContext =
+      new AIS_InteractiveContext(theViewer);
+  // selection is highlighted within the immediate Top layer like hovering
+  // (sharing depth with the scene), so that changing selection does not
+  // invalidate the main scene
+  aContext->HighlightStyle(Prs3d_TypeOfHighlight_Selected)
+      ->SetZLayer(Graphic3d_ZLayerId_Top);
+  aContext->HighlightStyle(Prs3d_TypeOfHighlight_LocalSelected)
+      ->SetZLayer(Graphic3d_ZLayerId_Top);
+  return aContext;
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2019 OPEN CASCADE SAS
+//
+// This file is part of the examples of the Open CASCADE Technology software
+// library.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE
+
+#ifndef _OcctViewSetup_HeaderFile
+#define _OcctViewSetup_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <Aspect_Window.hxx>
+#include <Prs3d_TextAspect.hxx>
+#include <V3d_View.hxx>
+#include <V3d_Viewer.hxx>
+
+//! Viewer, view and interactive context setup independent from the window
+//! system, shared by the WebGL viewer and native offscreen benchmarks, so
+//! that both render the scene with the same parameters.
+class OcctViewSetup {
+ public:
+  //! Create viewer with default lights casting shadows.
+  static Handle(V3d_Viewer) CreateViewer(
+      const Handle(Graphic3d_GraphicDriver) & theDriver);
+
+  //! Create text style used by view statistics and view cube.
+  static Handle(Prs3d_TextAspect) CreateTextStyle();
+
+  //! Create perspective view.
+  //! @param theViewer [in] viewer
+  //! @param theWindow [in] window (canvas, native or virtual window)
+  //! @param theDevicePixelRatio [in] device pixel ratio
+  static Handle(V3d_View) CreateView(const Handle(V3d_Viewer) & theViewer,
+                                     const Handle(Aspect_Window) & theWindow,
+                                     float theDevicePixelRatio);
+
+  //! Create interactive context.
+  static Handle(AIS_InteractiveContext) CreateContext(
+      const Handle(V3d_Viewer) & theViewer);
+};
+
+#endif  // _OcctViewSetup_HeaderFile
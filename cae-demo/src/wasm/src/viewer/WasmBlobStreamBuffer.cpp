@@ -0,0 +1,123 @@
+#include "WasmBlobStreamBuffer.h"
+
+#include <emscripten.h>
+
+//! Append data to the list of Blob parts with the given id.
+EM_JS(void, jsBlobAppend, (int theId, const char* theData, int theLen), {
+  const aParts = Module['_myBlobParts'] = Module['_myBlobParts'] || {};
+  aParts[theId] = aParts[theId] || [];
+  aParts[theId].push(HEAPU8.slice(theData, theData + theLen));
+});
+
+//! Assemble Blob from the parts with the given id and pass it to optional
+//! Module.onExportDone(fileName, blob), or download it as a file.
+EM_JS(void, jsBlobFinish,
+      (int theId, const char* theFileName, const char* theMimeType), {
+        const aParts = Module['_myBlobParts'] || {};
+        const aBlob = new Blob(aParts[theId] || [],
+                               {type : UTF8ToString(theMimeType)});
+        delete aParts[theId];
+        const aFileName = UTF8ToString(theFileName);
+        if (Module['onExportDone'] !== undefined) {
+          Module['onExportDone'](aFileName, aBlob);
+          return;
+        }
+        const aLink = document.createElement('a');
+        aLink.href = URL.createObjectURL(aBlob);
+        aLink.download = aFileName;
+        aLink.click();
+        setTimeout(function() { URL.revokeObjectURL(aLink.href); }, 0);
+      });
+
+//! Release Blob parts with the given id.
+EM_JS(void, jsBlobDiscard, (int theId), {
+  if (Module['_myBlobParts'] !== undefined) {
+    delete Module['_myBlobParts'][theId];
+  }
+});
+
+// ================================================================
+// Function : WasmBlobStreamBuffer
+// Purpose  :
+// ================================================================
+WasmBlobStreamBuffer::WasmBlobStreamBuffer(size_t theChunkSize)
+    : myChunk(new char[theChunkSize]),
+      myChunkSize(theChunkSize),
+      myNbFlushed(0),
+      myId(0),
+      myIsFinished(false) {
+  static int THE_LAST_ID = 0;
+  myId = ++THE_LAST_ID;
+  setp(myChunk.get(), myChunk.get() + myChunkSize);
+}
+
+// ================================================================
+// Function : ~WasmBlobStreamBuffer
+// Purpose  :
+// ================================================================
+WasmBlobStreamBuffer::~WasmBlobStreamBuffer() {
+  if (!myIsFinished) {
+    jsBlobDiscard(myId);
+  }
+}
+
+// ================================================================
+// Function : Finish
+// Purpose  :
+// ================================================================
+void WasmBlobStreamBuffer::Finish(const std::string& theFileName,
+                                  const std::string& theMimeType) {
+  flushChunk();
+  jsBlobFinish(myId, theFileName.c_str(), theMimeType.c_str());
+  myIsFinished = true;
+}
+
+// ================================================================
+// Function : flushChunk
+// Purpose  :
+// ================================================================
+void WasmBlobStreamBuffer::flushChunk() {
+  const int aLen = int(pptr() - pbase());
+  if (aLen > 0) {
+    jsBlobAppend(myId, pbase(), aLen);
+    myNbFlushed += size_t(aLen);
+  }
+  setp(myChunk.get(), myChunk.get() + myChunkSize);
+}
+
+// ================================================================
+// Function : overflow
+// Purpose  :
+// ================================================================
+WasmBlobStreamBuffer::int_type WasmBlobStreamBuffer::overflow(
+    int_type theChar) {
+  flushChunk();
+  if (!traits_type::eq_int_type(theChar, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(theChar);
+    pbump(1);
+  }
+  return traits_type::not_eof(theChar);
+}
+
+// ================================================================
+// Function : sync
+// Purpose  :
+// ================================================================
+int WasmBlobStreamBuffer::sync() {
+  flushChunk();
+  return 0;
+}
+
+// ================================================================
+// Function : seekoff
+// Purpose  :
+// ================================================================
+WasmBlobStreamBuffer::pos_type WasmBlobStreamBuffer::seekoff(
+    off_type theOff, std::ios_base::seekdir theDir,
+    std::ios_base::openmode theMode) {
+  if (theOff != 0 || theDir != std::ios_base::cur ||
+      (theMode & std::ios_base::out) == 0) {
+    return pos_type(off_type(-1));
+  }
+  return pos_type(off_type(NbWritten()));
+}
@@ -0,0 +1,59 @@
+#ifndef _WasmBlobStreamBuffer_HeaderFile
+#define _WasmBlobStreamBuffer_HeaderFile
+
+#include <cstddef>
+#include <memory>
+#include <streambuf>
+#include <string>
+
+//! Write-only stream buffer passing written data to JS as Blob parts.
+//! Every filled chunk is copied out of the heap into a JS typed array, so
+//! that the heap holds a single chunk whatever the output size, and the
+//! parts are assembled into a Blob by Finish(), leaving the browser free to
+//! keep a large Blob out of memory.
+class WasmBlobStreamBuffer : public std::streambuf {
+ public:
+  //! Main constructor.
+  //! @param theChunkSize [in] size of chunk passed to JS at once
+  WasmBlobStreamBuffer(size_t theChunkSize = 1024 * 1024);
+
+  //! Destructor; discards parts of unfinished Blob.
+  virtual ~WasmBlobStreamBuffer();
+
+  //! Return number of bytes written so far.
+  size_t NbWritten() const { return myNbFlushed + size_t(pptr() - pbase()); }
+
+  //! Pass the rest of data and the assembled Blob to optional JS callback
+  //! Module.onExportDone(fileName, blob), or offer it for download when
+  //! the callback is not defined.
+  //! @param theFileName [in] file name
+  //! @param theMimeType [in] Blob type
+  void Finish(const std::string& theFileName, const std::string& theMimeType);
+
+ protected:
+  //! Pass filled chunk to JS.
+  virtual int_type overflow(int_type theChar) override;
+
+  //! Pass written data to JS.
+  virtual int sync() override;
+
+  //! Only reports current position (tellp()), as data is not kept.
+  virtual pos_type seekoff(off_type theOff, std::ios_base::seekdir theDir,
+                           std::ios_base::openmode theMode) override;
+
+ private:
+  //! Pass written data to JS.
+  void flushChunk();
+
+  WasmBlobStreamBuffer(const WasmBlobStreamBuffer&) = delete;
+  WasmBlobStreamBuffer& operator=(const WasmBlobStreamBuffer&) = delete;
+
+ private:
+  std::unique_ptr<char[]> myChunk;  //!< chunk being written
+  size_t myChunkSize;               //!< chunk capacity
+  size_t myNbFlushed;               //!< bytes passed to JS
+  int myId;                         //!< id of Blob parts on JS side
+  bool myIsFinished;                //!< Blob has been assembled
+};
+
+#endif  // _WasmBlobStreamBuffer_HeaderFile
@@ -0,0 +1,153 @@
+#include "WasmEdgeOverlay.h"
+
+#include <BRepTools.hxx>
+#include <BRep_Tool.hxx>
+#include <Graphic3d_Group.hxx>
+#include <Poly_Polygon3D.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
+#include <Prs3d_LineAspect.hxx>
+#include <StdPrs_ToolTriangulatedShape.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+#include <TopoDS.hxx>
+
+#include <vector>
+
+namespace {
+//! Discretized edge: either polygon on triangulation or 3D polygon.
+struct EdgePolygon {
+  Handle(Poly_PolygonOnTriangulation) PolyOnTris;
+  Handle(Poly_Triangulation) Triangulation;
+  Handle(Poly_Polygon3D) Polygon3d;
+  gp_Trsf Trsf;
+
+  Standard_Integer NbNodes() const {
+    return !PolyOnTris.IsNull() ? PolyOnTris->NbNodes()
+                                : Polygon3d->NbNodes();
+  }
+
+  gp_Pnt Node(Standard_Integer theIndex) const {
+    gp_Pnt aPnt = !PolyOnTris.IsNull()
+                      ? Triangulation->Node(PolyOnTris->Node(theIndex))
+                      : Polygon3d->Nodes().Value(theIndex);
+    if (Trsf.Form() != gp_Identity) {
+      aPnt.Transform(Trsf);
+    }
+    return aPnt;
+  }
+};
+}  // namespace
+
+// ================================================================
+// Function : WasmEdgeOverlay
+// Purpose  :
+// ================================================================
+WasmEdgeOverlay::WasmEdgeOverlay(const TopoDS_Shape& theShape)
+    : myShape(theShape) {
+  SetDisplayMode(0);
+  SetInfiniteState(false);
+}
+
+// ================================================================
+// Function : BuildSegments
+// Purpose  :
+// ================================================================
+Handle(Graphic3d_ArrayOfSegments) WasmEdgeOverlay::BuildSegments(
+    const TopoDS_Shape& theShape) {
+  TopTools_IndexedDataMapOfShapeListOfShape anEdgeFaceMap;
+  TopExp::MapShapesAndAncestors(theShape, TopAbs_EDGE, TopAbs_FACE,
+                                anEdgeFaceMap);
+
+  // collect polygons first to allocate the shared buffer at once
+  std::vector<EdgePolygon> aPolygons;
+  aPolygons.reserve(anEdgeFaceMap.Extent());
+  Standard_Integer aNbNodes = 0, aNbSegments = 0;
+  for (Standard_Integer anEdgeIter = 1; anEdgeIter <= anEdgeFaceMap.Extent();
+       ++anEdgeIter) {
+    const TopoDS_Edge& anEdge = TopoDS::Edge(anEdgeFaceMap.FindKey(anEdgeIter));
+    if (BRep_Tool::Degenerated(anEdge)) {
+      continue;
+    }
+
+    EdgePolygon aPolygon;
+    for (TopTools_ListOfShape::Iterator aFaceIter(
+             anEdgeFaceMap.FindFromIndex(anEdgeIter));
+         aFaceIter.More() && aPolygon.PolyOnTris.IsNull(); aFaceIter.Next()) {
+      TopLoc_Location aLoc;
+      const TopoDS_Face& aFace = TopoDS::Face(aFaceIter.Value());
+      aPolygon.Triangulation = BRep_Tool::Triangulation(aFace, aLoc);
+      if (aPolygon.Triangulation.IsNull()) {
+        continue;
+      }
+      aPolygon.PolyOnTris = BRep_Tool::PolygonOnTriangulation(
+          anEdge, aPolygon.Triangulation, aLoc);
+      aPolygon.Trsf = aLoc.Transformation();
+    }
+    if (aPolygon.PolyOnTris.IsNull()) {
+      // free edge or face without mesh
+      TopLoc_Location aLoc;
+      aPolygon.Polygon3d = BRep_Tool::Polygon3D(anEdge, aLoc);
+      if (aPolygon.Polygon3d.IsNull()) {
+        continue;
+      }
+      aPolygon.Trsf = aLoc.Transformation();
+    }
+
+    const Standard_Integer aNbEdgeNodes = aPolygon.NbNodes();
+    if (aNbEdgeNodes < 2) {
+      continue;
+    }
+    aNbNodes += aNbEdgeNodes;
+    aNbSegments += aNbEdgeNodes - 1;
+    aPolygons.push_back(aPolygon);
+  }
+  if (aNbSegments == 0) {
+    return Handle(Graphic3d_ArrayOfSegments)();
+  }
+
+  Handle(Graphic3d_ArrayOfSegments) aSegments =
+      new Graphic3d_ArrayOfSegments(aNbNodes, aNbSegments * 2);
+  for (const EdgePolygon& aPolygon : aPolygons) {
+    const Standard_Integer aNbEdgeNodes = aPolygon.NbNodes();
+    const Standard_Integer aFirstIndex = aSegments->VertexNumber() + 1;
+    for (Standard_Integer aNodeIter = 1; aNodeIter <= aNbEdgeNodes;
+         ++aNodeIter) {
+      aSegments->AddVertex(aPolygon.Node(aNodeIter));
+    }
+    for (Standard_Integer aNodeIter = 0; aNodeIter < aNbEdgeNodes - 1;
+         ++aNodeIter) {
+      aSegments->AddEdges(aFirstIndex + aNodeIter, aFirstIndex + aNodeIter + 1);
+    }
+  }
+  return aSegments;
+}
+
+// ================================================================
+// Function : Compute
+// Purpose  :
+// ================================================================
+void WasmEdgeOverlay::Compute(const Handle(PrsMgr_PresentationManager) &
+                                  thePrsMgr,
+                              const Handle(Prs3d_Presentation) & thePrs,
+                              const Standard_Integer theMode) {
+  (void)thePrsMgr;
+  if (theMode != 0 || myShape.IsNull()) {
+    return;
+  }
+
+  // reuse existing triangulation whatever its quality, as mesh parameters
+  // may differ per object - meshing is done only if shape was not meshed yet
+  if (!BRepTools::Triangulation(myShape, Precision::Infinite(), true)) {
+    StdPrs_ToolTriangulatedShape::Tessellate(myShape, myDrawer);
+  }
+  Handle(Graphic3d_ArrayOfSegments) aSegments = BuildSegments(myShape);
+  if (aSegments.IsNull()) {
+    return;
+  }
+
+  Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+  aGroup->SetGroupPrimitivesAspect(myDrawer->FaceBoundaryAspect()->Aspect());
+  aGroup->AddPrimitiveArray(aSegments);
+}
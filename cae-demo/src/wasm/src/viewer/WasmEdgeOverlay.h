@@ -0,0 +1,56 @@
+#ifndef _WasmEdgeOverlay_HeaderFile
+#define _WasmEdgeOverlay_HeaderFile
+
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_ArrayOfSegments.hxx>
+#include <TopoDS_Shape.hxx>
+
+//! Edge overlay drawn on top of shaded shapes.
+//! Unlike face boundaries of AIS_Shape, which discretize every edge curve
+//! once more, the overlay reuses the polygons on triangulation produced by
+//! meshing, so the lines match the shaded mesh exactly and cost no extra
+//! curve evaluation. All edges of the model are packed into a single
+//! segments array (one line buffer per model).
+class WasmEdgeOverlay : public AIS_InteractiveObject {
+  DEFINE_STANDARD_RTTI_INLINE(WasmEdgeOverlay, AIS_InteractiveObject)
+ public:
+  //! Main constructor.
+  //! @param theShape [in] shape (normally the whole model) to outline
+  WasmEdgeOverlay(const TopoDS_Shape& theShape);
+
+  //! Return outlined shape.
+  const TopoDS_Shape& Shape() const { return myShape; }
+
+  //! Only mode 0 is supported.
+  virtual Standard_Boolean AcceptDisplayMode(
+      const Standard_Integer theMode) const override {
+    return theMode == 0;
+  }
+
+  //! Build segments from polygons on triangulation of the shape edges.
+  //! Edges without triangulation on any adjacent face fall back to their 3D
+  //! polygon, if any; other edges are skipped.
+  //! @param theShape [in] meshed shape
+  //! @return segments array or NULL if shape has no discretized edges
+  static Handle(Graphic3d_ArrayOfSegments) BuildSegments(
+      const TopoDS_Shape& theShape);
+
+ protected:
+  //! Compute presentation.
+  virtual void Compute(const Handle(PrsMgr_PresentationManager) & thePrsMgr,
+                       const Handle(Prs3d_Presentation) & thePrs,
+                       const Standard_Integer theMode) override;
+
+  //! Overlay is not selectable.
+  virtual void ComputeSelection(const Handle(SelectMgr_Selection) &
+                                    theSel,
+                                const Standard_Integer theMode) override {
+    (void)theSel;
+    (void)theMode;
+  }
+
+ private:
+  TopoDS_Shape myShape;  //!< outlined shape
+};
+
+#endif  // _WasmEdgeOverlay_HeaderFile
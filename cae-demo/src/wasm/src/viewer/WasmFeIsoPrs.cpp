@@ -0,0 +1,78 @@
+#include "WasmFeIsoPrs.h"
+
+#include <Graphic3d_ArrayOfSegments.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+#include <Graphic3d_Group.hxx>
+#include <Prs3d_LineAspect.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+
+// ================================================================
+// Function : WasmFeIsoPrs
+// Purpose  :
+// ================================================================
+WasmFeIsoPrs::WasmFeIsoPrs(
+    const FeIsoGeometry& theGeometry, bool theIsLines,
+    const std::vector<Graphic3d_Vec4ub>& theLevelColors)
+    : myPrimitives(BuildPrimitives(theGeometry, theIsLines, theLevelColors)),
+      myIsLines(theIsLines) {
+  SetDisplayMode(0);
+  SetInfiniteState(false);
+  myDrawer->SetupOwnShadingAspect();
+  myDrawer->ShadingAspect()->Aspect()->SetShadingModel(Graphic3d_TOSM_FACET);
+  myDrawer->ShadingAspect()->Aspect()->SetPolygonOffsets(Aspect_POM_Off);
+  myDrawer->SetLineAspect(
+      new Prs3d_LineAspect(Quantity_NOC_BLACK, Aspect_TOL_SOLID, 2.0));
+}
+
+// ================================================================
+// Function : BuildPrimitives
+// Purpose  :
+// ================================================================
+Handle(Graphic3d_ArrayOfPrimitives) WasmFeIsoPrs::BuildPrimitives(
+    const FeIsoGeometry& theGeometry, bool theIsLines,
+    const std::vector<Graphic3d_Vec4ub>& theLevelColors) {
+  const int aNbVerts = theGeometry.NbVertices();
+  if (aNbVerts == 0) {
+    return Handle(Graphic3d_ArrayOfPrimitives)();
+  }
+
+  Handle(Graphic3d_ArrayOfPrimitives) aPrimitives;
+  if (theIsLines) {
+    aPrimitives = new Graphic3d_ArrayOfSegments(
+        aNbVerts, 0, Graphic3d_ArrayFlags_VertexColor);
+  } else {
+    aPrimitives = new Graphic3d_ArrayOfTriangles(
+        aNbVerts, 0, Graphic3d_ArrayFlags_VertexColor);
+  }
+  const int aNbPrimVerts = theIsLines ? 2 : 3;
+  const float* aPos = theGeometry.Positions.data();
+  for (int aVertIter = 0; aVertIter < aNbVerts; ++aVertIter, aPos += 3) {
+    const int aVertex = aPrimitives->AddVertex(aPos[0], aPos[1], aPos[2]);
+    aPrimitives->SetVertexColor(
+        aVertex,
+        theLevelColors[size_t(theGeometry.Levels[aVertIter / aNbPrimVerts])]);
+  }
+  return aPrimitives;
+}
+
+// ================================================================
+// Function : Compute
+// Purpose  :
+// ================================================================
+void WasmFeIsoPrs::Compute(const Handle(PrsMgr_PresentationManager) &
+                               thePrsMgr,
+                           const Handle(Prs3d_Presentation) & thePrs,
+                           const Standard_Integer theMode) {
+  (void)thePrsMgr;
+  if (theMode != 0 || myPrimitives.IsNull()) {
+    return;
+  }
+
+  Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+  if (myIsLines) {
+    aGroup->SetGroupPrimitivesAspect(myDrawer->LineAspect()->Aspect());
+  } else {
+    aGroup->SetGroupPrimitivesAspect(myDrawer->ShadingAspect()->Aspect());
+  }
+  aGroup->AddPrimitiveArray(myPrimitives);
+}
@@ -0,0 +1,59 @@
+#ifndef _WasmFeIsoPrs_HeaderFile
+#define _WasmFeIsoPrs_HeaderFile
+
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_ArrayOfPrimitives.hxx>
+
+#include "FeIsoExtractor.h"
+
+//! Presentation of isosurfaces, iso-lines or contour bands extracted from
+//! FE results. Geometry is uploaded once as non-indexed triangles or
+//! segments colored per level; the presentation is not selectable and is
+//! replaced as a whole when extraction parameters change.
+//! Contour bands are drawn without polygon offset, so that they cover the
+//! coinciding skin which is shifted back.
+class WasmFeIsoPrs : public AIS_InteractiveObject {
+  DEFINE_STANDARD_RTTI_INLINE(WasmFeIsoPrs, AIS_InteractiveObject)
+ public:
+  //! Main constructor.
+  //! @param theGeometry    [in] extracted geometry
+  //! @param theIsLines     [in] geometry defines segments, not triangles
+  //! @param theLevelColors [in] colors of levels of the geometry
+  WasmFeIsoPrs(const FeIsoGeometry& theGeometry, bool theIsLines,
+               const std::vector<Graphic3d_Vec4ub>& theLevelColors);
+
+  //! Return TRUE if presentation shows iso-lines.
+  bool IsLines() const { return myIsLines; }
+
+  //! Only mode 0 is supported.
+  virtual Standard_Boolean AcceptDisplayMode(
+      const Standard_Integer theMode) const override {
+    return theMode == 0;
+  }
+
+  //! Build triangles or segments array of the geometry.
+  //! @return array or NULL if geometry is empty
+  static Handle(Graphic3d_ArrayOfPrimitives) BuildPrimitives(
+      const FeIsoGeometry& theGeometry, bool theIsLines,
+      const std::vector<Graphic3d_Vec4ub>& theLevelColors);
+
+ protected:
+  //! Compute presentation.
+  virtual void Compute(const Handle(PrsMgr_PresentationManager) & thePrsMgr,
+                       const Handle(Prs3d_Presentation) & thePrs,
+                       const Standard_Integer theMode) override;
+
+  //! Presentation is not selectable.
+  virtual void ComputeSelection(const Handle(SelectMgr_Selection) &
+                                    theSel,
+                                const Standard_Integer theMode) override {
+    (void)theSel;
+    (void)theMode;
+  }
+
+ private:
+  Handle(Graphic3d_ArrayOfPrimitives) myPrimitives;  //!< geometry or NULL
+  bool myIsLines;  //!< primitives are segments
+};
+
+#endif  // _WasmFeIsoPrs_HeaderFile
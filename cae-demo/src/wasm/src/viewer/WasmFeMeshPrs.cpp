@@ -0,0 +1,349 @@
+#include "WasmFeMeshPrs.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <Bnd_Box.hxx>
+#include <Graphic3d_AttribBuffer.hxx>
+#include <Graphic3d_Group.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+#include <Select3D_SensitivePrimitiveArray.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <SelectMgr_Selection.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+//! Color of skin without result.
+static const Graphic3d_Vec4ub THE_SKIN_COLOR(191, 191, 191, 255);
+
+//! Index of vertex attributes within skin triangles array.
+enum SkinAttribute {
+  SkinAttribute_Position,
+  SkinAttribute_Color,
+};
+}  // namespace
+
+// ================================================================
+// Function : WasmFeMeshPrs
+// Purpose  :
+// ================================================================
+WasmFeMeshPrs::WasmFeMeshPrs(const Handle(FeMesh) & theMesh,
+                             FeMeshSkin&& theSkin)
+    : myMesh(theMesh),
+      mySkin(std::move(theSkin)),
+      myIsFlat(false),
+      myMaxDisplacement(0.0f) {
+  SetDisplayMode(0);
+  SetInfiniteState(false);
+  myDrawer->SetupOwnShadingAspect();
+  myDrawer->ShadingAspect()->Aspect()->SetShadingModel(Graphic3d_TOSM_FACET);
+}
+
+// ================================================================
+// Function : BuildTriangles
+// Purpose  :
+// ================================================================
+Handle(Graphic3d_ArrayOfTriangles) WasmFeMeshPrs::BuildTriangles(
+    const FeMesh& theMesh, const FeMeshSkin& theSkin) {
+  if (theSkin.NbTriangles() == 0) {
+    return Handle(Graphic3d_ArrayOfTriangles)();
+  }
+
+  Handle(Graphic3d_ArrayOfTriangles) aTriangles =
+      new Graphic3d_ArrayOfTriangles(
+          int(theSkin.Nodes.size()), theSkin.NbTriangles() * 3,
+          Graphic3d_ArrayFlags_VertexColor |
+              Graphic3d_ArrayFlags_AttribsMutable |
+              Graphic3d_ArrayFlags_AttribsDeinterleaved);
+  for (const int aNode : theSkin.Nodes) {
+    const int aVertex = aTriangles->AddVertex(
+        theMesh.X[aNode], theMesh.Y[aNode], theMesh.Z[aNode]);
+    aTriangles->SetVertexColor(aVertex, THE_SKIN_COLOR);
+  }
+  for (size_t anIndex = 0; anIndex < theSkin.Triangles.size(); anIndex += 3) {
+    aTriangles->AddTriangleEdges(theSkin.Triangles[anIndex] + 1,
+                                 theSkin.Triangles[anIndex + 1] + 1,
+                                 theSkin.Triangles[anIndex + 2] + 1);
+  }
+  return aTriangles;
+}
+
+// ================================================================
+// Function : BuildFlatTriangles
+// Purpose  :
+// ================================================================
+Handle(Graphic3d_ArrayOfTriangles) WasmFeMeshPrs::BuildFlatTriangles(
+    const Handle(Graphic3d_ArrayOfTriangles) & theTriangles,
+    const FeMeshSkin& theSkin) {
+  Handle(Graphic3d_ArrayOfTriangles) aFlat = new Graphic3d_ArrayOfTriangles(
+      int(theSkin.Triangles.size()), 0,
+      Graphic3d_ArrayFlags_VertexColor | Graphic3d_ArrayFlags_AttribsMutable |
+          Graphic3d_ArrayFlags_AttribsDeinterleaved);
+  for (const int aVert : theSkin.Triangles) {
+    const int aVertex = aFlat->AddVertex(theTriangles->Vertice(aVert + 1));
+    aFlat->SetVertexColor(aVertex, THE_SKIN_COLOR);
+  }
+  return aFlat;
+}
+
+// ================================================================
+// Function : SetResult
+// Purpose  :
+// ================================================================
+bool WasmFeMeshPrs::SetResult(const float* theValues, size_t theNbValues,
+                              int theNbComponents,
+                              FeResultLocation theLocation,
+                              const FeResultRange& theRange,
+                              const FeColormap& theColormap) {
+  const size_t aNbItems = size_t(theLocation == FeResultLocation_Node
+                                     ? myMesh->NbNodes()
+                                     : myMesh->NbElements());
+  if (myTriangles.IsNull()) {
+    myTriangles = BuildTriangles(*myMesh, mySkin);
+  }
+  if (myTriangles.IsNull() || theNbComponents <= 0 ||
+      theNbValues != aNbItems * size_t(theNbComponents)) {
+    return false;
+  }
+
+  if (theLocation == FeResultLocation_Node) {
+    const int aNbVerts = int(mySkin.Nodes.size());
+    myScalars.resize(size_t(aNbVerts));
+    for (int aVertIter = 0; aVertIter < aNbVerts; ++aVertIter) {
+      myScalars[aVertIter] = FeColormap::Scalar(
+          theValues, size_t(mySkin.Nodes[aVertIter]), theNbComponents);
+    }
+  } else {
+    const int aNbTris = mySkin.NbTriangles();
+    myScalars.resize(size_t(aNbTris));
+    for (int aTriIter = 0; aTriIter < aNbTris; ++aTriIter) {
+      myScalars[aTriIter] = FeColormap::Scalar(
+          theValues, size_t(mySkin.Elements[aTriIter]), theNbComponents);
+    }
+  }
+  setFlat(theLocation != FeResultLocation_Node);
+  SetColormap(theRange, theColormap);
+  return true;
+}
+
+// ================================================================
+// Function : SetColormap
+// Purpose  :
+// ================================================================
+void WasmFeMeshPrs::SetColormap(const FeResultRange& theRange,
+                                const FeColormap& theColormap) {
+  if (myScalars.empty()) {
+    return;
+  }
+
+  myRange = theRange;
+  if (myRange.IsEmpty()) {
+    myRange = FeResultRange();
+    bool isFirst = true;
+    for (const float aScalar : myScalars) {
+      if (std::isnan(aScalar)) {
+        continue;
+      }
+      myRange.Min = isFirst ? aScalar : std::min(myRange.Min, aScalar);
+      myRange.Max = isFirst ? aScalar : std::max(myRange.Max, aScalar);
+      isFirst = false;
+    }
+  }
+  if (myIsFlat) {
+    for (size_t aTriIter = 0; aTriIter < myScalars.size(); ++aTriIter) {
+      const Graphic3d_Vec4ub aColor =
+          theColormap.Color(myScalars[aTriIter], myRange);
+      for (int aNodeIter = 1; aNodeIter <= 3; ++aNodeIter) {
+        myFlatTriangles->SetVertexColor(int(aTriIter) * 3 + aNodeIter,
+                                        aColor);
+      }
+    }
+    invalidateAttribute(myFlatTriangles, SkinAttribute_Color);
+    return;
+  }
+
+  for (size_t aVertIter = 0; aVertIter < myScalars.size(); ++aVertIter) {
+    myTriangles->SetVertexColor(int(aVertIter) + 1,
+                                theColormap.Color(myScalars[aVertIter],
+                                                  myRange));
+  }
+  invalidateAttribute(myTriangles, SkinAttribute_Color);
+}
+
+// ================================================================
+// Function : setFlat
+// Purpose  :
+// ================================================================
+void WasmFeMeshPrs::setFlat(bool theIsFlat) {
+  if (theIsFlat && myFlatTriangles.IsNull()) {
+    myFlatTriangles = BuildFlatTriangles(myTriangles, mySkin);
+  }
+  if (myIsFlat == theIsFlat) {
+    return;
+  }
+
+  myIsFlat = theIsFlat;
+  if (!GetContext().IsNull()) {
+    GetContext()->Redisplay(this, false);
+  }
+}
+
+// ================================================================
+// Function : SetDisplacements
+// Purpose  :
+// ================================================================
+bool WasmFeMeshPrs::SetDisplacements(const float* theValues,
+                                     size_t theNbValues, float theScale) {
+  if (myTriangles.IsNull()) {
+    myTriangles = BuildTriangles(*myMesh, mySkin);
+  }
+  if (myTriangles.IsNull() || theNbValues != size_t(myMesh->NbNodes()) * 3) {
+    return false;
+  }
+
+  const FeMesh& aMesh = *myMesh;
+  float aMaxSquare = 0.0f;
+  for (size_t aVertIter = 0; aVertIter < mySkin.Nodes.size(); ++aVertIter) {
+    const size_t aNode = size_t(mySkin.Nodes[aVertIter]);
+    const float* aDisp = theValues + aNode * 3;
+    const float aDX = aDisp[0] * theScale;
+    const float aDY = aDisp[1] * theScale;
+    const float aDZ = aDisp[2] * theScale;
+    myTriangles->SetVertice(int(aVertIter) + 1, aMesh.X[aNode] + aDX,
+                            aMesh.Y[aNode] + aDY, aMesh.Z[aNode] + aDZ);
+    aMaxSquare = std::max(aMaxSquare, aDX * aDX + aDY * aDY + aDZ * aDZ);
+  }
+  invalidateAttribute(myTriangles, SkinAttribute_Position);
+  if (!myFlatTriangles.IsNull()) {
+    for (size_t anIndex = 0; anIndex < mySkin.Triangles.size(); ++anIndex) {
+      myFlatTriangles->SetVertice(
+          int(anIndex) + 1,
+          myTriangles->Vertice(mySkin.Triangles[anIndex] + 1));
+    }
+    invalidateAttribute(myFlatTriangles, SkinAttribute_Position);
+  }
+
+  // bounding box is enlarged with a margin, so that animation recomputes
+  // presentation only a few times
+  const float aMaxDisp = std::sqrt(aMaxSquare);
+  if (aMaxDisp > myMaxDisplacement) {
+    myMaxDisplacement = aMaxDisp * 2.0f;
+    if (!GetContext().IsNull()) {
+      GetContext()->Redisplay(this, false);
+      GetContext()->RecomputeSelectionPrimitives(this);
+    }
+  }
+  return true;
+}
+
+// ================================================================
+// Function : ClearResults
+// Purpose  :
+// ================================================================
+void WasmFeMeshPrs::ClearResults() {
+  myScalars.clear();
+  myRange = FeResultRange();
+  if (myTriangles.IsNull()) {
+    return;
+  }
+
+  const FeMesh& aMesh = *myMesh;
+  for (size_t aVertIter = 0; aVertIter < mySkin.Nodes.size(); ++aVertIter) {
+    const int aNode = mySkin.Nodes[aVertIter];
+    myTriangles->SetVertice(int(aVertIter) + 1, aMesh.X[aNode],
+                            aMesh.Y[aNode], aMesh.Z[aNode]);
+    myTriangles->SetVertexColor(int(aVertIter) + 1, THE_SKIN_COLOR);
+  }
+  invalidateAttribute(myTriangles, SkinAttribute_Position);
+  invalidateAttribute(myTriangles, SkinAttribute_Color);
+  // flat triangles are rebuilt from undeformed skin on next use
+  myFlatTriangles.Nullify();
+  setFlat(false);
+  if (!GetContext().IsNull()) {
+    GetContext()->RecomputeSelectionPrimitives(this);
+  }
+}
+
+// ================================================================
+// Function : invalidateAttribute
+// Purpose  :
+// ================================================================
+void WasmFeMeshPrs::invalidateAttribute(
+    const Handle(Graphic3d_ArrayOfTriangles) & theTriangles, int theIndex) {
+  Handle(Graphic3d_AttribBuffer) anAttribs =
+      Handle(Graphic3d_AttribBuffer)::DownCast(theTriangles->Attributes());
+  if (!anAttribs.IsNull()) {
+    anAttribs->Invalidate(theIndex);
+  }
+}
+
+// ================================================================
+// Function : Compute
+// Purpose  :
+// ================================================================
+void WasmFeMeshPrs::Compute(const Handle(PrsMgr_PresentationManager) &
+                                thePrsMgr,
+                            const Handle(Prs3d_Presentation) & thePrs,
+                            const Standard_Integer theMode) {
+  (void)thePrsMgr;
+  if (theMode != 0) {
+    return;
+  }
+
+  if (myTriangles.IsNull()) {
+    myTriangles = BuildTriangles(*myMesh, mySkin);
+  }
+  if (myTriangles.IsNull()) {
+    return;
+  }
+
+  // bounds cover undeformed skin and reserved displacement, as vertex
+  // positions are changed without recomputing presentation
+  Bnd_Box aBox;
+  for (const int aNode : mySkin.Nodes) {
+    aBox.Add(gp_Pnt(myMesh->X[aNode], myMesh->Y[aNode], myMesh->Z[aNode]));
+  }
+  aBox.Enlarge(myMaxDisplacement);
+
+  Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+  aGroup->SetGroupPrimitivesAspect(myDrawer->ShadingAspect()->Aspect());
+  aGroup->AddPrimitiveArray(myIsFlat ? myFlatTriangles : myTriangles, false);
+  aGroup->SetMinMaxValues(aBox.CornerMin().X(), aBox.CornerMin().Y(),
+                          aBox.CornerMin().Z(), aBox.CornerMax().X(),
+                          aBox.CornerMax().Y(), aBox.CornerMax().Z());
+}
+
+// ================================================================
+// Function : ComputeSelection
+// Purpose  :
+// ================================================================
+void WasmFeMeshPrs::ComputeSelection(const Handle(SelectMgr_Selection) &
+                                         theSel,
+                                     const Standard_Integer theMode) {
+  if (theMode != 0) {
+    return;
+  }
+  if (myTriangles.IsNull()) {
+    myTriangles = BuildTriangles(*myMesh, mySkin);
+  }
+  if (myTriangles.IsNull()) {
+    return;
+  }
+
+  // selection shares the immutable index buffer with the presentation, but
+  // copies vertex positions, which displacements change in place - picking
+  // moved vertices against BVH built for the old ones would miss
+  const int aNbVerts = myTriangles->VertexNumber();
+  Handle(Graphic3d_ArrayOfTriangles) aPositions =
+      new Graphic3d_ArrayOfTriangles(aNbVerts, 0, Graphic3d_ArrayFlags_None);
+  for (int aVertIter = 1; aVertIter <= aNbVerts; ++aVertIter) {
+    aPositions->AddVertex(myTriangles->Vertice(aVertIter));
+  }
+
+  Handle(SelectMgr_EntityOwner) anOwner = new SelectMgr_EntityOwner(this);
+  Handle(Select3D_SensitivePrimitiveArray) aSensitive =
+      new Select3D_SensitivePrimitiveArray(anOwner);
+  aSensitive->InitTriangulation(aPositions->Attributes(),
+                                myTriangles->Indices(), TopLoc_Location());
+  theSel->Add(aSensitive);
+}
@@ -0,0 +1,125 @@
+#ifndef _WasmFeMeshPrs_HeaderFile
+#define _WasmFeMeshPrs_HeaderFile
+
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+
+#include "FeMesh.h"
+
+//! Presentation of finite-element mesh by its exterior skin.
+//! Interior faces of volume elements are never uploaded: only skin vertices
+//! are stored, without normals, and shaded with facet model computing
+//! normals per fragment. Indices are 16-bit for skins below 65535 vertices.
+//!
+//! Results are shown by updating vertex colors and positions in place:
+//! vertex attributes are mutable and kept in separate blocks, so that
+//! a time step re-uploads only the changed attribute of skin vertices,
+//! without recomputing the presentation or rebuilding the geometry.
+//! Selection holds its own copy of skin vertex positions, taken when it is
+//! computed, and is recomputed when displacements leave the bounding box
+//! reserved for them or are cleared; smaller displacement steps are picked
+//! against the positions of the last recomputation.
+class WasmFeMeshPrs : public AIS_InteractiveObject {
+  DEFINE_STANDARD_RTTI_INLINE(WasmFeMeshPrs, AIS_InteractiveObject)
+ public:
+  //! Main constructor.
+  //! @param theMesh [in] mesh
+  //! @param theSkin [in] skin extracted from the mesh, taken over
+  WasmFeMeshPrs(const Handle(FeMesh) & theMesh, FeMeshSkin&& theSkin);
+
+  //! Return mesh.
+  const Handle(FeMesh) & Mesh() const { return myMesh; }
+
+  //! Return skin.
+  const FeMeshSkin& Skin() const { return mySkin; }
+
+  //! Color skin by result values mapped to colormap.
+  //! Node values are interpolated across skin faces; element values color
+  //! skin faces of every element flat, using a separate array with unshared
+  //! vertices of skin triangles, so that a single bad element is not
+  //! smoothed away by its neighbors.
+  //! @param theValues       [in] theNbComponents values per node or element
+  //! @param theNbValues     [in] number of values
+  //! @param theNbComponents [in] 1 for scalars, 3 for vectors shown by
+  //!                             magnitude
+  //! @param theLocation     [in] values location
+  //! @param theRange        [in] range mapped to colormap, computed from
+  //!                             the values if empty
+  //! @param theColormap     [in] colormap
+  //! @return FALSE if number of values does not match the mesh
+  bool SetResult(const float* theValues, size_t theNbValues,
+                 int theNbComponents, FeResultLocation theLocation,
+                 const FeResultRange& theRange, const FeColormap& theColormap);
+
+  //! Return range of the shown result.
+  const FeResultRange& ResultRange() const { return myRange; }
+
+  //! Recolor shown result with another range or colormap.
+  //! @param theRange    [in] range, computed from the result if empty
+  //! @param theColormap [in] colormap
+  void SetColormap(const FeResultRange& theRange,
+                   const FeColormap& theColormap);
+
+  //! Move skin vertices by scaled nodal displacements.
+  //! Presentation is recomputed only when the displaced skin leaves
+  //! bounding box reserved for displacements.
+  //! @param theValues   [in] 3 values per node
+  //! @param theNbValues [in] number of values
+  //! @param theScale    [in] displacement scale
+  //! @return FALSE if number of values does not match the mesh
+  bool SetDisplacements(const float* theValues, size_t theNbValues,
+                        float theScale);
+
+  //! Restore undeformed uniformly colored skin.
+  void ClearResults();
+
+  //! Only mode 0 is supported.
+  virtual Standard_Boolean AcceptDisplayMode(
+      const Standard_Integer theMode) const override {
+    return theMode == 0;
+  }
+
+  //! Build triangles array of the skin.
+  //! @return triangles array or NULL if skin is empty
+  static Handle(Graphic3d_ArrayOfTriangles) BuildTriangles(
+      const FeMesh& theMesh, const FeMeshSkin& theSkin);
+
+  //! Build non-indexed triangles array of the skin, three vertices per
+  //! triangle, with positions copied from the indexed one.
+  static Handle(Graphic3d_ArrayOfTriangles) BuildFlatTriangles(
+      const Handle(Graphic3d_ArrayOfTriangles) & theTriangles,
+      const FeMeshSkin& theSkin);
+
+ protected:
+  //! Compute presentation.
+  virtual void Compute(const Handle(PrsMgr_PresentationManager) & thePrsMgr,
+                       const Handle(Prs3d_Presentation) & thePrs,
+                       const Standard_Integer theMode) override;
+
+  //! Compute selection of the whole mesh.
+  virtual void ComputeSelection(const Handle(SelectMgr_Selection) & theSel,
+                                const Standard_Integer theMode) override;
+
+ private:
+  //! Invalidate vertex attribute for re-uploading.
+  void invalidateAttribute(const Handle(Graphic3d_ArrayOfTriangles) &
+                               theTriangles,
+                           int theIndex);
+
+  //! Switch between indexed and flat triangles, recomputing presentation.
+  void setFlat(bool theIsFlat);
+
+ private:
+  Handle(FeMesh) myMesh;  //!< mesh
+  FeMeshSkin mySkin;      //!< exterior skin
+  Handle(Graphic3d_ArrayOfTriangles) myTriangles;  //!< skin triangles
+  //! skin triangles with unshared vertices for element results, or NULL
+  Handle(Graphic3d_ArrayOfTriangles) myFlatTriangles;
+  //! shown result at skin vertices, or at skin triangles when flat
+  std::vector<float> myScalars;
+  bool myIsFlat;                 //!< flat triangles are shown
+  FeResultRange myRange;         //!< range of shown result
+  float myMaxDisplacement;       //!< displacement reserved in bounding box
+};
+
+#endif  // _WasmFeMeshPrs_HeaderFile
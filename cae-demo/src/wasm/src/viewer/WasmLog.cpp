@@ -0,0 +1,164 @@
+#include "WasmLog.h"
+
+#include <emscripten.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+//! Recorded message.
+struct LogRecord {
+  double Time = 0.0;                       //!< time in milliseconds
+  WasmLogLevel Level = WasmLogLevel_Info;  //!< message level
+  const char* Format = "";                 //!< format string
+  WasmLogArgs Args;                        //!< copied arguments
+};
+
+//! Ring buffer of recorded messages.
+struct LogRing {
+  std::vector<LogRecord> Records;  //!< allocated records
+  size_t Capacity = 1024;          //!< maximum number of records
+  size_t Next = 0;                 //!< index of the record to overwrite
+  bool ToEcho = false;             //!< print all messages to the console
+};
+
+//! Return ring buffer.
+LogRing& logRing() {
+  static LogRing aRing;
+  return aRing;
+}
+
+//! Level names.
+static const char* THE_LEVEL_NAMES[WasmLogLevel_Off + 1] = {
+    "trace", "debug", "info", "warning", "fail", "off"};
+
+//! Print formatted message to the console.
+void echoMessage(WasmLogLevel theLevel, const std::string& theMessage) {
+  static const spdlog::level::level_enum THE_SPD_LEVELS[WasmLogLevel_Off] = {
+      spdlog::level::trace, spdlog::level::debug, spdlog::level::info,
+      spdlog::level::warn, spdlog::level::err};
+  spdlog::log(THE_SPD_LEVELS[theLevel], "{}", theMessage);
+}
+}  // namespace
+
+// ================================================================
+// Function : level
+// Purpose  :
+// ================================================================
+WasmLogLevel& WasmLog::level() {
+  // silent by default, except for problems
+  static WasmLogLevel aLevel = WasmLogLevel_Warning;
+  return aLevel;
+}
+
+// ================================================================
+// Function : SetLevelName
+// Purpose  :
+// ================================================================
+bool WasmLog::SetLevelName(const std::string& theName) {
+  for (int aLevelIter = 0; aLevelIter <= WasmLogLevel_Off; ++aLevelIter) {
+    if (theName == THE_LEVEL_NAMES[aLevelIter]) {
+      SetLevel(WasmLogLevel(aLevelIter));
+      return true;
+    }
+  }
+  return false;
+}
+
+// ================================================================
+// Function : SetEcho
+// Purpose  :
+// ================================================================
+void WasmLog::SetEcho(bool theToEcho) { logRing().ToEcho = theToEcho; }
+
+// ================================================================
+// Function : SetCapacity
+// Purpose  :
+// ================================================================
+void WasmLog::SetCapacity(int theNbMessages) {
+  Clear();
+  logRing().Capacity = size_t(std::max(theNbMessages, 0));
+}
+
+// ================================================================
+// Function : Clear
+// Purpose  :
+// ================================================================
+void WasmLog::Clear() {
+  LogRing& aRing = logRing();
+  aRing.Records.clear();
+  aRing.Records.shrink_to_fit();
+  aRing.Next = 0;
+}
+
+// ================================================================
+// Function : add
+// Purpose  :
+// ================================================================
+void WasmLog::add(WasmLogLevel theLevel, const char* theFormat,
+                  WasmLogArgs&& theArgs) {
+  LogRing& aRing = logRing();
+  if (aRing.ToEcho || theLevel >= WasmLogLevel_Warning) {
+    echoMessage(theLevel, fmt::vformat(theFormat, theArgs));
+  }
+  if (aRing.Capacity == 0) {
+    return;
+  }
+
+  LogRecord aRecord;
+  aRecord.Time = emscripten_get_now();
+  aRecord.Level = theLevel;
+  aRecord.Format = theFormat;
+  aRecord.Args = std::move(theArgs);
+  if (aRing.Records.size() < aRing.Capacity) {
+    aRing.Records.push_back(std::move(aRecord));
+  } else {
+    aRing.Records[aRing.Next] = std::move(aRecord);
+  }
+  aRing.Next = (aRing.Next + 1) % aRing.Capacity;
+}
+
+// ================================================================
+// Function : Dump
+// Purpose  :
+// ================================================================
+std::string WasmLog::Dump() {
+  const LogRing& aRing = logRing();
+  const size_t aNbRecords = aRing.Records.size();
+  // the oldest record follows the last written one once the ring is full
+  const size_t aFirst = aNbRecords < aRing.Capacity ? 0 : aRing.Next;
+  std::string aDump;
+  for (size_t aRecIter = 0; aRecIter < aNbRecords; ++aRecIter) {
+    const LogRecord& aRecord = aRing.Records[(aFirst + aRecIter) % aNbRecords];
+    aDump += fmt::format("[{:.3f}] [{}] ", aRecord.Time * 0.001,
+                         THE_LEVEL_NAMES[aRecord.Level]);
+    aDump += fmt::vformat(aRecord.Format, aRecord.Args);
+    aDump += '\n';
+  }
+  return aDump;
+}
+
+// ================================================================
+// Function : send
+// Purpose  :
+// ================================================================
+void WasmLogPrinter::send(const TCollection_AsciiString& theString,
+                          const Message_Gravity theGravity) const {
+  WasmLogLevel aLevel = WasmLogLevel_Fail;
+  switch (theGravity) {
+    case Message_Trace:
+      aLevel = WasmLogLevel_Trace;
+      break;
+    case Message_Info:
+      aLevel = WasmLogLevel_Info;
+      break;
+    case Message_Warning:
+      aLevel = WasmLogLevel_Warning;
+      break;
+    case Message_Alarm:
+    case Message_Fail:
+      aLevel = WasmLogLevel_Fail;
+      break;
+  }
+  WASM_LOG(aLevel, "{}", theString.ToCString());
+}
@@ -0,0 +1,127 @@
+#ifndef _WasmLog_HeaderFile
+#define _WasmLog_HeaderFile
+
+#include <Message_Printer.hxx>
+#include <spdlog/spdlog.h>
+
+#if defined(SPDLOG_FMT_EXTERNAL)
+#include <fmt/args.h>
+#else
+#include <spdlog/fmt/bundled/args.h>
+#endif
+
+#include <string>
+
+//! Logging levels.
+enum WasmLogLevel {
+  WasmLogLevel_Trace = 0,
+  WasmLogLevel_Debug,
+  WasmLogLevel_Info,
+  WasmLogLevel_Warning,
+  WasmLogLevel_Fail,
+  WasmLogLevel_Off
+};
+
+//! Arguments of recorded message.
+typedef fmt::dynamic_format_arg_store<fmt::format_context> WasmLogArgs;
+
+//! Minimal level compiled in; WASM_LOG_TRACE() and WASM_LOG_DEBUG() below
+//! this level expand to nothing, so that their arguments are not evaluated.
+#ifndef WASM_LOG_COMPILED_LEVEL
+#define WASM_LOG_COMPILED_LEVEL 0
+#endif
+
+//! Log of the viewer with runtime level and ring-buffer sink.
+//!
+//! Messages below the runtime level are skipped by a single comparison,
+//! before arguments are evaluated. Accepted messages are recorded into
+//! a ring buffer of fixed capacity together with a copy of their arguments,
+//! and are formatted only on Dump(). Warnings and failures are also printed
+//! to the console immediately; other levels only when echo is turned on.
+class WasmLog {
+ public:
+  //! Return TRUE if messages of specified level are recorded.
+  static bool IsEnabled(WasmLogLevel theLevel) { return theLevel >= level(); }
+
+  //! Return runtime level.
+  static WasmLogLevel Level() { return level(); }
+
+  //! Set runtime level.
+  static void SetLevel(WasmLogLevel theLevel) { level() = theLevel; }
+
+  //! Set runtime level by name: "trace", "debug", "info", "warning", "fail"
+  //! or "off".
+  //! @return FALSE if name is unknown
+  static bool SetLevelName(const std::string& theName);
+
+  //! Print all recorded messages to the console as they come.
+  static void SetEcho(bool theToEcho);
+
+  //! Set ring buffer capacity in messages; 0 disables recording.
+  static void SetCapacity(int theNbMessages);
+
+  //! Format recorded messages, from the oldest one.
+  static std::string Dump();
+
+  //! Drop recorded messages.
+  static void Clear();
+
+  //! Record the message.
+  //! @param theLevel  [in] message level
+  //! @param theFormat [in] fmt-style format string with static lifetime
+  //! @param theArgs   [in] arguments copied for deferred formatting
+  template <typename... Args_t>
+  static void Write(WasmLogLevel theLevel, const char* theFormat,
+                    const Args_t&... theArgs) {
+    WasmLogArgs anArgs;
+    (anArgs.push_back(theArgs), ...);
+    add(theLevel, theFormat, std::move(anArgs));
+  }
+
+ private:
+  //! Return runtime level.
+  static WasmLogLevel& level();
+
+  //! Add message to the ring buffer and echo it.
+  static void add(WasmLogLevel theLevel, const char* theFormat,
+                  WasmLogArgs&& theArgs);
+};
+
+//! Printer forwarding messages of OCCT messenger to WasmLog.
+class WasmLogPrinter : public Message_Printer {
+  DEFINE_STANDARD_RTTI_INLINE(WasmLogPrinter, Message_Printer)
+ public:
+  //! Main constructor; all gravities are passed to WasmLog.
+  WasmLogPrinter() { myTraceLevel = Message_Trace; }
+
+ protected:
+  //! Forward the message.
+  virtual void send(const TCollection_AsciiString& theString,
+                    const Message_Gravity theGravity) const override;
+};
+
+//! Record the message if its level is enabled at runtime.
+#define WASM_LOG(theLevel, ...)               \
+  do {                                        \
+    if (WasmLog::IsEnabled(theLevel)) {       \
+      WasmLog::Write(theLevel, __VA_ARGS__);  \
+    }                                         \
+  } while (false)
+
+#if WASM_LOG_COMPILED_LEVEL <= 0
+#define WASM_LOG_TRACE(...) WASM_LOG(WasmLogLevel_Trace, __VA_ARGS__)
+#else
+#define WASM_LOG_TRACE(...) ((void)0)
+#endif
+
+#if WASM_LOG_COMPILED_LEVEL <= 1
+#define WASM_LOG_DEBUG(...) WASM_LOG(WasmLogLevel_Debug, __VA_ARGS__)
+#else
+#define WASM_LOG_DEBUG(...) ((void)0)
+#endif
+
+#define WASM_LOG_INFO(...) WASM_LOG(WasmLogLevel_Info, __VA_ARGS__)
+#define WASM_LOG_WARNING(...) WASM_LOG(WasmLogLevel_Warning, __VA_ARGS__)
+#define WASM_LOG_FAIL(...) WASM_LOG(WasmLogLevel_Fail, __VA_ARGS__)
+
+#endif  // _WasmLog_HeaderFile
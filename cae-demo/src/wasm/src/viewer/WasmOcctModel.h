@@ -0,0 +1,72 @@
+#ifndef _WasmOcctModel_HeaderFile
+#define _WasmOcctModel_HeaderFile
+
+#include <AIS_Shape.hxx>
+#include <BRep_Builder.hxx>
+#include <NCollection_Sequence.hxx>
+#include <TopoDS_Compound.hxx>
+
+#include <vector>
+
+#include "FeIsoExtractor.h"
+#include "FeMeshQuality.h"
+#include "ModelFingerprint.h"
+#include "ModelMassProperties.h"
+#include "ModelMesher.h"
+#include "ModelTree.h"
+
+//! Kinds of iso presentations of FE results.
+enum WasmIsoKind {
+  WasmIsoKind_None,
+  WasmIsoKind_Isosurface,
+  WasmIsoKind_IsoLines,
+  WasmIsoKind_ContourBands,
+};
+
+//! Parameters of the shown iso presentation, to extract it again when
+//! the mesh is deformed.
+struct WasmIsoParams {
+  WasmIsoKind Kind = WasmIsoKind_None;
+  double Min = 0.0;  //!< range minimum, or isosurface value
+  double Max = 0.0;  //!< range maximum
+  int NbLevels = 0;  //!< number of iso-lines or bands
+};
+
+//! Named model loaded into the viewer.
+//! Groups all presentations created from a single file,
+//! so that they can be shown, hidden and removed together.
+class WasmOcctModel : public Standard_Transient {
+  DEFINE_STANDARD_RTTI_INLINE(WasmOcctModel, Standard_Transient)
+ public:
+  //! Return compound of all shapes of the model.
+  TopoDS_Shape Shape() const {
+    if (Objects.Size() == 1) {
+      return Objects.First()->Shape();
+    }
+
+    TopoDS_Compound aCompound;
+    BRep_Builder aBuilder;
+    aBuilder.MakeCompound(aCompound);
+    for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(Objects);
+         anObjIter.More(); anObjIter.Next()) {
+      aBuilder.Add(aCompound, anObjIter.Value()->Shape());
+    }
+    return aCompound;
+  }
+
+ public:
+  NCollection_Sequence<Handle(AIS_Shape)> Objects;  //!< shape presentations
+  Handle(AIS_InteractiveObject) EdgeOverlay;  //!< edge overlay or NULL
+  ModelMeshStats RemeshStats;  //!< statistics of pending remeshing
+  ModelMassProperties MassProperties;  //!< cached mass properties
+  Handle(ModelTree) Tree;  //!< assembly tree of STEP/IGES model or NULL
+  Handle(AIS_InteractiveObject) MeshPrs;  //!< FE mesh presentation or NULL
+  Handle(FeIsoExtractor) IsoExtractor;  //!< iso extraction of FE results
+  Handle(AIS_InteractiveObject) IsoPrs;  //!< iso presentation or NULL
+  WasmIsoParams IsoParams;  //!< parameters of iso presentation
+  FeMeshQuality MeshQuality;  //!< cached quality of FE mesh elements
+  ModelFingerprint Fingerprint;  //!< fingerprints of parts of Objects
+  std::vector<uint64_t> ObjectFingerprints;  //!< fingerprints of Objects
+};
+
+#endif  // _WasmOcctModel_HeaderFile
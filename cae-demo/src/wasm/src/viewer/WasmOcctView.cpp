@@ -24,7 +24,21 @@
 #include "WasmOcctView.h"
 
 #include <emscripten/bind.h>
-#include <spdlog/spdlog.h>
+
+#include "DecompressStreamBuffer.h"
+#include "FeMeshReader.h"
+#include "MeshExporter.h"
+#include "ModelFingerprint.h"
+#include "ModelFormat.h"
+#include "ModelReader.h"
+#include "OcctViewSetup.h"
+#include "WasmBlobStreamBuffer.h"
+#include "WasmEdgeOverlay.h"
+#include "WasmFeIsoPrs.h"
+#include "WasmFeMeshPrs.h"
+#include "WasmLog.h"
+#include "WasmProgressIndicator.h"
+#include "XCafDocumentCache.h"
 
 // ===================== OCCT ======================
 #include <AIS_Shape.hxx>
@@ -38,24 +52,28 @@
 #include <BRep_Builder.hxx>
 #include <BRep_Tool.hxx>
 #include <Graphic3d_CubeMapPacked.hxx>
-#include <IGESCAFControl_Reader.hxx>
-#include <Image_AlienPixMap.hxx>
+#include <Image_PixMap.hxx>
 #include <Message.hxx>
 #include <Message_Messenger.hxx>
 #include <Message_PrinterOStream.hxx>
 #include <Message_ProgressIndicator.hxx>
+#include <Message_ProgressScope.hxx>
+#include <NCollection_Map.hxx>
+#include <OSD_MemInfo.hxx>
+#include <OpenGl_Context.hxx>
 #include <OpenGl_GraphicDriver.hxx>
 #include <Poly.hxx>
 #include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
 #include <Prs3d_DatumAspect.hxx>
 #include <Prs3d_ToolCylinder.hxx>
 #include <Prs3d_ToolDisk.hxx>
 #include <Quantity_Color.hxx>
-#include <STEPCAFControl_Reader.hxx>
 #include <STEPControl_Reader.hxx>
 #include <Standard_ArrayStreamBuffer.hxx>
 #include <Standard_PrimitiveTypes.hxx>
 #include <Standard_Version.hxx>
+#include <StdSelect_BRepOwner.hxx>
 #include <StepData_StepModel.hxx>
 #include <TColgp_Array1OfVec.hxx>
 #include <TDF_ChildIterator.hxx>
@@ -75,7 +93,9 @@
 #include <XCAFDoc_ShapeTool.hxx>
 
 // ==================== STD-CPP ======================
+#include <algorithm>
 #include <array>
+#include <cctype>
 #include <climits>
 #include <filesystem>
 #include <fstream>
@@ -88,57 +108,454 @@
 
 #define THE_CANVAS_ID "canvas"
 
+//! Start streaming download of the model.
+//! Every received chunk is copied straight into the heap buffer returned by
+//! onModelFetchChunk(), so the file is never accumulated on JS side.
+EM_JS(void, jsFetchModel, (int theTaskId, const char* theUrl), {
+  const aController = new AbortController();
+  Module['_myFetchControllers'] = Module['_myFetchControllers'] || {};
+  Module['_myFetchControllers'][theTaskId] = aController;
+  const aFinish = function(theIsDone) {
+    delete Module['_myFetchControllers'][theTaskId];
+    _onModelFetchDone(theTaskId, theIsDone ? 1 : 0);
+  };
+  fetch(UTF8ToString(theUrl), {signal : aController.signal})
+      .then(function(theResponse) {
+        if (!theResponse.ok || theResponse.body === null) {
+          throw new Error('HTTP status ' + theResponse.status);
+        }
+        const aTotal = Number(theResponse.headers.get('Content-Length') || 0);
+        const aReader = theResponse.body.getReader();
+        const aPump = function() {
+          return aReader.read().then(function(theChunk) {
+            if (theChunk.done) {
+              return true;
+            }
+            const aPtr = _onModelFetchChunk(theTaskId, theChunk.value.length,
+                                            aTotal) >>> 0;
+            if (aPtr === 0) {
+              aController.abort();
+              return false;
+            }
+            HEAPU8.set(theChunk.value, aPtr);
+            _onModelFetchProgress(theTaskId);
+            return aPump();
+          });
+        };
+        return aPump();
+      })
+      .then(aFinish, function(theError) {
+        console.warn(theError);
+        aFinish(false);
+      });
+});
+
+//! Abort streaming download started by jsFetchModel().
+EM_JS(void, jsAbortFetchModel, (int theTaskId), {
+  const aControllers = Module['_myFetchControllers'];
+  if (aControllers !== undefined && aControllers[theTaskId] !== undefined) {
+    aControllers[theTaskId].abort();
+  }
+});
+
+//! Report download progress to optional JS callback
+//! Module.onDownloadProgress(name, loadedBytes, totalBytes);
+//! total is 0 if server did not report content length.
+EM_JS(void, jsReportDownloadProgress,
+      (const char* theName, double theLoaded, double theTotal), {
+        if (Module['onDownloadProgress'] !== undefined) {
+          Module['onDownloadProgress'](UTF8ToString(theName), theLoaded,
+                                       theTotal);
+        }
+      });
+
+//! Notify optional JS callback Module.onRemeshDone(name, reusedFraction)
+//! that the model has been remeshed; reusedFraction is the fraction of faces
+//! which triangulation has been kept.
+EM_JS(void, jsReportRemeshDone, (const char* theName, double theReused), {
+  if (Module['onRemeshDone'] !== undefined) {
+    Module['onRemeshDone'](UTF8ToString(theName), theReused);
+  }
+});
+
+//! Download cubemap image and decode it by the browser image pipeline.
+//! createImageBitmap() decodes the image off the main thread, and decoded
+//! RGBA pixels are written straight into the heap buffer returned by
+//! onCubemapImageSize(), so that encoded data never enters the heap.
+EM_JS(void, jsDecodeCubemap, (int theTaskId, const char* theUrl), {
+  fetch(UTF8ToString(theUrl))
+      .then(function(theResponse) {
+        if (!theResponse.ok) {
+          throw new Error('HTTP status ' + theResponse.status);
+        }
+        return theResponse.blob();
+      })
+      .then(function(theBlob) {
+        return createImageBitmap(theBlob, {
+          premultiplyAlpha : 'none',
+          colorSpaceConversion : 'none'
+        });
+      })
+      .then(function(theBitmap) {
+        const aSizeX = theBitmap.width;
+        const aSizeY = theBitmap.height;
+        const aCanvas = typeof OffscreenCanvas !== 'undefined'
+                            ? new OffscreenCanvas(aSizeX, aSizeY)
+                            : document.createElement('canvas');
+        aCanvas.width = aSizeX;
+        aCanvas.height = aSizeY;
+        const aCtx = aCanvas.getContext('2d');
+        aCtx.drawImage(theBitmap, 0, 0);
+        theBitmap.close();
+        const aPixels = aCtx.getImageData(0, 0, aSizeX, aSizeY).data;
+        const aPtr = _onCubemapImageSize(theTaskId, aSizeX, aSizeY) >>> 0;
+        if (aPtr !== 0) {
+          HEAPU8.set(aPixels, aPtr);
+        }
+        _onCubemapImageDone(theTaskId, aPtr !== 0 ? 1 : 0);
+      })
+      .catch(function(theError) {
+        console.warn(theError);
+        _onCubemapImageDone(theTaskId, 0);
+      });
+});
+
+//! Mount IndexedDB-backed file system at document cache directory and
+//! populate it from the browser storage. Cache stays empty (in-memory only)
+//! when IndexedDB is unavailable, e.g. in private browsing mode.
+EM_JS(void, jsMountModelCache, (const char* theDir), {
+  const aDir = UTF8ToString(theDir);
+  try {
+    FS.mkdirTree(aDir);
+    FS.mount(IDBFS, {}, aDir);
+    FS.syncfs(true, function(theError) {
+      if (theError) {
+        console.warn('Unable to restore model cache', theError);
+      }
+    });
+  } catch (theError) {
+    console.warn('Unable to mount model cache', theError);
+  }
+});
+
+//! Flush document cache directory into browser storage.
+EM_JS(void, jsSyncModelCache, (), {
+  FS.syncfs(false, function(theError) {
+    if (theError) {
+      console.warn('Unable to store model cache', theError);
+    }
+  });
+});
+
 namespace {
-//! Auxiliary wrapper for loading model.
+//! Auxiliary wrapper for streaming model download.
+//! Data is received into a heap buffer preallocated from Content-Length
+//! (when available) and passed to WasmOcctView::openFromMemory() without
+//! another copy.
 struct ModelAsyncLoader {
+  //! Minimal interval between progress reports in milliseconds.
+  static constexpr double THE_PROGRESS_INTERVAL = 100.0;
+
   std::string Name;
   std::string Path;
+  int Id;
+  bool ToUpdate;
+  char* Buffer;
+  size_t Size;
+  size_t Capacity;
+  size_t TotalSize;
+  double LastReportTime;
+  bool IsHeaderChecked;
+  bool IsCancelled;
+
+  ModelAsyncLoader(const char* theName, const char* thePath,
+                   bool theToUpdate)
+      : Name(theName),
+        Path(thePath),
+        Id(++LastId()),
+        ToUpdate(theToUpdate),
+        Buffer(nullptr),
+        Size(0),
+        Capacity(0),
+        TotalSize(0),
+        LastReportTime(0.0),
+        IsHeaderChecked(false),
+        IsCancelled(false) {
+    Tasks()[Id] = this;
+  }
 
-  ModelAsyncLoader(const char* theName, const char* thePath)
-      : Name(theName), Path(thePath) {}
+  ~ModelAsyncLoader() {
+    Tasks().erase(Id);
+    free(Buffer);
+  }
 
-  //! File data read event.
-  static void onDataRead(void* theOpaque, void* theBuffer, int theDataLen) {
-    const ModelAsyncLoader* aTask = (ModelAsyncLoader*)theOpaque;
-    WasmOcctView::openFromMemory(
-        aTask->Name, reinterpret_cast<uintptr_t>(theBuffer), theDataLen, false);
-    delete aTask;
+  //! Return map of active tasks.
+  static std::unordered_map<int, ModelAsyncLoader*>& Tasks() {
+    static std::unordered_map<int, ModelAsyncLoader*> aTasks;
+    return aTasks;
   }
 
-  //! File read error event.
-  static void onReadFailed(void* theOpaque) {
-    const ModelAsyncLoader* aTask = (ModelAsyncLoader*)theOpaque;
-    Message::DefaultMessenger()->Send(
-        TCollection_AsciiString("Error: unable to load file ") +
-            aTask->Path.c_str(),
-        Message_Fail);
-    delete aTask;
+  //! Return last assigned task id.
+  static int& LastId() {
+    static int anId = 0;
+    return anId;
+  }
+
+  //! Find active task by id.
+  static ModelAsyncLoader* Find(int theTaskId) {
+    auto aTaskIter = Tasks().find(theTaskId);
+    return aTaskIter != Tasks().end() ? aTaskIter->second : nullptr;
+  }
+
+  //! Reserve space for the next chunk.
+  //! @param theChunkLen [in] chunk length
+  //! @param theTotalLen [in] expected file length or 0 if unknown
+  //! @return pointer to write the chunk to, or NULL on allocation failure
+  char* Reserve(size_t theChunkLen, size_t theTotalLen) {
+    TotalSize = theTotalLen;
+    const size_t aRequired = Size + theChunkLen;
+    if (aRequired > Capacity) {
+      // Content-Length may be smaller than actual data for encoded transfer
+      size_t aNewCapacity = std::max({aRequired, theTotalLen, Capacity * 2});
+      char* aNewBuffer = (char*)realloc(Buffer, aNewCapacity);
+      if (aNewBuffer == nullptr) {
+        return nullptr;
+      }
+      Buffer = aNewBuffer;
+      Capacity = aNewCapacity;
+    }
+    char* aChunk = Buffer + Size;
+    Size = aRequired;
+    return aChunk;
+  }
+
+  //! Check that received header belongs to supported format.
+  //! @return FALSE if format is unsupported and download should be stopped
+  bool CheckHeader() {
+    if (IsHeaderChecked || Size < ModelFormatTool::THE_HEADER_SIZE) {
+      return true;
+    }
+    IsHeaderChecked = true;
+    return ModelFormatTool::Detect(Name, Buffer, Size) != ModelFormat_Unknown;
+  }
+
+  //! Report progress to JS, not more often than THE_PROGRESS_INTERVAL.
+  void ReportProgress(bool theToForce) {
+    const double aTime = emscripten_get_now();
+    if (!theToForce && aTime - LastReportTime < THE_PROGRESS_INTERVAL) {
+      return;
+    }
+    LastReportTime = aTime;
+    jsReportDownloadProgress(Name.c_str(), double(Size), double(TotalSize));
   }
 };
 
 //! Auxiliary wrapper for loading cubemap.
+//! Only the most recently requested cubemap is applied.
 struct CubemapAsyncLoader {
-  //! Image file read event.
-  static void onImageRead(const char* theFilePath) {
-    Handle(Graphic3d_CubeMapPacked) aCubemap;
-    Handle(Image_AlienPixMap) anImage = new Image_AlienPixMap();
-    if (anImage->Load(theFilePath)) {
-      aCubemap = new Graphic3d_CubeMapPacked(anImage);
-    }
-    WasmOcctView::Instance().View()->SetBackgroundCubeMap(aCubemap, true,
+  //! Return id of the last request.
+  static int& LastId() {
+    static int anId = 0;
+    return anId;
+  }
+
+  //! Return path of the last request.
+  static std::string& Path() {
+    static std::string aPath;
+    return aPath;
+  }
+
+  //! Return image being filled by jsDecodeCubemap().
+  static Handle(Image_PixMap) & Image() {
+    static Handle(Image_PixMap) anImage;
+    return anImage;
+  }
+
+  //! Return TRUE if path refers to a GPU-compressed (DDS) cubemap.
+  static bool IsCompressed(const std::string& thePath) {
+    std::string anExt =
+        std::filesystem::path(thePath.substr(0, thePath.find('?')))
+            .extension()
+            .string();
+    std::transform(anExt.begin(), anExt.end(), anExt.begin(),
+                   [](unsigned char theChar) { return std::tolower(theChar); });
+    return anExt == ".dds";
+  }
+
+  //! Return path of DDS file of the shown cubemap, or empty string.
+  //! The file is read on every texture upload, so it is kept while shown.
+  static std::string& ShownFile() {
+    static std::string aPath;
+    return aPath;
+  }
+
+  //! Return unique path of downloaded DDS file of the request.
+  static std::string CompressedFile(int theTaskId) {
+    return "/emulated/cubemap-" + std::to_string(theTaskId) + ".dds";
+  }
+
+  //! Set view background, removing DDS file of the previous one.
+  //! @param theFile [in] DDS file of the cubemap or empty string
+  static void SetCubemap(const Handle(Graphic3d_CubeMapPacked) & theCubemap,
+                         const std::string& theFile = std::string()) {
+    WasmOcctView::Instance().View()->SetBackgroundCubeMap(theCubemap, true,
                                                           false);
     WasmOcctView::Instance().UpdateView();
+    if (!ShownFile().empty() && ShownFile() != theFile) {
+      std::error_code anErr;
+      std::filesystem::remove(ShownFile(), anErr);
+    }
+    ShownFile() = theFile;
   }
 
-  //! Image file failed read event.
-  static void onImageFailed(const char* theFilePath) {
+  //! Report loading failure.
+  static void ReportFailure() {
     Message::DefaultMessenger()->Send(
-        TCollection_AsciiString("Error: unable to load image ") + theFilePath,
+        TCollection_AsciiString("Error: unable to load image ") +
+            Path().c_str(),
         Message_Fail);
   }
+
+  //! Compressed file read event.
+  static void onCompressedRead(unsigned int /*theHandle*/, void* theTaskId,
+                               const char* theFilePath) {
+    if ((intptr_t)theTaskId == LastId()) {
+      // DDS faces are uploaded to the GPU without decompression
+      SetCubemap(new Graphic3d_CubeMapPacked(theFilePath), theFilePath);
+    } else {
+      std::error_code anErr;
+      std::filesystem::remove(theFilePath, anErr);
+    }
+  }
+
+  //! Compressed file failed read event.
+  static void onCompressedFailed(unsigned int /*theHandle*/, void* theTaskId,
+                                 int /*theStatus*/) {
+    std::error_code anErr;
+    std::filesystem::remove(CompressedFile(int((intptr_t)theTaskId)), anErr);
+    if ((intptr_t)theTaskId == LastId()) {
+      ReportFailure();
+    }
+  }
 };
+
+//! Transparency of FE mesh skin showing isosurface.
+static const double THE_ISO_SKIN_TRANSPARENCY = 0.7;
+
+//! Color of iso-lines.
+static const Graphic3d_Vec4ub THE_ISO_LINE_COLOR(32, 32, 32, 255);
 }  // namespace
 
+//! Cubemap image decoded event - return pointer where RGBA pixels should be
+//! written, or NULL if request is outdated or allocation failed.
+extern "C" EMSCRIPTEN_KEEPALIVE uintptr_t onCubemapImageSize(int theTaskId,
+                                                             int theSizeX,
+                                                             int theSizeY) {
+  if (theTaskId != CubemapAsyncLoader::LastId() || theSizeX <= 0 ||
+      theSizeY <= 0) {
+    return 0;
+  }
+
+  // rows are tightly packed top-down as in canvas image data
+  Handle(Image_PixMap) anImage = new Image_PixMap();
+  if (!anImage->InitTrash(Image_Format_RGBA, Standard_Size(theSizeX),
+                          Standard_Size(theSizeY),
+                          Standard_Size(theSizeX) * 4)) {
+    return 0;
+  }
+  anImage->SetTopDown(true);
+  CubemapAsyncLoader::Image() = anImage;
+  return reinterpret_cast<uintptr_t>(anImage->ChangeData());
+}
+
+//! Cubemap image decoded, failed or outdated event.
+extern "C" EMSCRIPTEN_KEEPALIVE void onCubemapImageDone(int theTaskId,
+                                                        int theIsDone) {
+  if (theTaskId != CubemapAsyncLoader::LastId()) {
+    return;
+  }
+
+  Handle(Image_PixMap) anImage = CubemapAsyncLoader::Image();
+  CubemapAsyncLoader::Image().Nullify();
+  if (theIsDone == 0 || anImage.IsNull()) {
+    CubemapAsyncLoader::ReportFailure();
+    return;
+  }
+  CubemapAsyncLoader::SetCubemap(new Graphic3d_CubeMapPacked(anImage));
+}
+
+//! Chunk received event - return pointer where chunk should be written.
+extern "C" EMSCRIPTEN_KEEPALIVE uintptr_t onModelFetchChunk(int theTaskId,
+                                                            size_t theChunkLen,
+                                                            double theTotal) {
+  ModelAsyncLoader* aTask = ModelAsyncLoader::Find(theTaskId);
+  if (aTask == nullptr) {
+    return 0;
+  }
+  return reinterpret_cast<uintptr_t>(
+      aTask->Reserve(theChunkLen, size_t(theTotal)));
+}
+
+//! Chunk written event.
+extern "C" EMSCRIPTEN_KEEPALIVE void onModelFetchProgress(int theTaskId) {
+  ModelAsyncLoader* aTask = ModelAsyncLoader::Find(theTaskId);
+  if (aTask == nullptr) {
+    return;
+  }
+  if (!aTask->CheckHeader()) {
+    // fail fast instead of downloading the whole file of unsupported format;
+    // the task is released here, so that the abort is not reported again
+    Message::SendFail() << "Error: file '" << aTask->Name.c_str()
+                        << "' has unsupported format";
+    jsAbortFetchModel(theTaskId);
+    delete aTask;
+    return;
+  }
+  aTask->ReportProgress(false);
+}
+
+//! Download finished, failed or cancelled event.
+extern "C" EMSCRIPTEN_KEEPALIVE void onModelFetchDone(int theTaskId,
+                                                      int theIsDone) {
+  ModelAsyncLoader* aTask = ModelAsyncLoader::Find(theTaskId);
+  if (aTask == nullptr) {
+    return;
+  }
+  if (theIsDone == 0 && aTask->IsCancelled) {
+    WasmProgressIndicator::ClearCancel();
+    Message::SendWarning() << "Loading of '" << aTask->Name.c_str()
+                           << "' has been cancelled";
+    delete aTask;
+    return;
+  }
+  if (theIsDone == 0 || aTask->Size == 0) {
+    WasmProgressIndicator::ClearCancel();
+    Message::DefaultMessenger()->Send(
+        TCollection_AsciiString("Error: unable to load file ") +
+            aTask->Path.c_str(),
+        Message_Fail);
+    delete aTask;
+    return;
+  }
+
+  aTask->ReportProgress(true);
+  // ownership of the buffer is passed to openFromMemory(), which also
+  // reports unsupported format of files shorter than the checked header
+  char* aBuffer = aTask->Buffer;
+  const size_t aSize = aTask->Size;
+  const std::string aName = aTask->Name;
+  const bool toUpdate = aTask->ToUpdate;
+  aTask->Buffer = nullptr;
+  delete aTask;
+  if (toUpdate) {
+    WasmOcctView::updateFromMemory(
+        aName, reinterpret_cast<uintptr_t>(aBuffer), aSize, true);
+  } else {
+    WasmOcctView::openFromMemory(aName, reinterpret_cast<uintptr_t>(aBuffer),
+                                 aSize, true);
+  }
+}
+
 // ================================================================
 // Function : Instance
 // Purpose  :
@@ -152,7 +569,20 @@ WasmOcctView& WasmOcctView::Instance() {
 // Function : WasmOcctView
 // Purpose  :
 // ================================================================
-WasmOcctView::WasmOcctView() : myDevicePixelRatio(1.0f), myNbUpdateRequests(0) {
+WasmOcctView::WasmOcctView()
+    : myDevicePixelRatio(1.0f),
+      myNbUpdateRequests(0),
+      myNbFullRedraws(0),
+      myNbImmediateRedraws(0),
+      myToShowEdges(true),
+      myToLinkViews(false) {
+  myRemeshQueue.SetObjectCallback(
+      [this](const Handle(WasmOcctModel) & theModel,
+             const Handle(AIS_Shape) & theObject,
+             const ModelMeshStats& theStats) {
+        onObjectRemeshed(theModel, theObject, theStats);
+      });
+
   addActionHotKeys(Aspect_VKey_NavForward, Aspect_VKey_W,
                    Aspect_VKey_W | Aspect_VKeyFlags_SHIFT);
   addActionHotKeys(Aspect_VKey_NavBackward, Aspect_VKey_S,
@@ -213,6 +643,9 @@ void WasmOcctView::run() {
   initWindow();
   initViewer();
   initDemoScene();
+  if (!XCafDocumentCache::Directory().IsEmpty()) {
+    jsMountModelCache(XCafDocumentCache::Directory().ToCString());
+  }
   if (myView.IsNull()) {
     return;
   }
@@ -372,6 +805,9 @@ bool WasmOcctView::initViewer() {
   aDriver->ChangeOptions().buffersNoSwap = true;  // swap has no effect in WebGL
   aDriver->ChangeOptions().buffersOpaqueAlpha =
       true;  // avoid unexpected blending of canvas with page background
+  // render main scene into offscreen buffer, so that immediate layer can be
+  // redrawn on top of it without redrawing the whole scene
+  aDriver->ChangeOptions().useSystemBuffer = false;
   if (!aDriver->InitContext()) {
     Message::DefaultMessenger()->Send(
         TCollection_AsciiString("Error: EGL initialization failed"),
@@ -379,46 +815,19 @@ bool WasmOcctView::initViewer() {
     return false;
   }
 
-  Handle(V3d_Viewer) aViewer = new V3d_Viewer(aDriver);
-  aViewer->SetComputedMode(false);
-  aViewer->SetDefaultShadingModel(Graphic3d_TypeOfShadingModel_Phong);
-  aViewer->SetDefaultLights();
-  aViewer->SetLightOn();
-  for (V3d_ListOfLight::Iterator aLightIter(aViewer->ActiveLights());
-       aLightIter.More(); aLightIter.Next()) {
-    const Handle(V3d_Light)& aLight = aLightIter.Value();
-    if (aLight->Type() == Graphic3d_TypeOfLightSource_Directional) {
-      aLight->SetCastShadows(true);
-    }
-  }
+  Handle(V3d_Viewer) aViewer = OcctViewSetup::CreateViewer(aDriver);
 
   Handle(Wasm_Window) aWindow = new Wasm_Window(THE_CANVAS_ID);
   aWindow->Size(myWinSizeOld.x(), myWinSizeOld.y());
 
-  myTextStyle = new Prs3d_TextAspect();
-  myTextStyle->SetFont(Font_NOF_ASCII_MONO);
-  myTextStyle->SetHeight(12);
-  myTextStyle->Aspect()->SetColor(Quantity_NOC_GRAY95);
-  myTextStyle->Aspect()->SetColorSubTitle(Quantity_NOC_BLACK);
-  myTextStyle->Aspect()->SetDisplayType(Aspect_TODT_SHADOW);
-  myTextStyle->Aspect()->SetTextFontAspect(Font_FA_Bold);
-  myTextStyle->Aspect()->SetTextZoomable(false);
-  myTextStyle->SetHorizontalJustification(Graphic3d_HTA_LEFT);
-  myTextStyle->SetVerticalJustification(Graphic3d_VTA_BOTTOM);
-
-  myView = new V3d_View(aViewer);
-  myView->Camera()->SetProjectionType(Graphic3d_Camera::Projection_Perspective);
-  myView->SetImmediateUpdate(false);
-  myView->ChangeRenderingParams().IsShadowEnabled = false;
-  myView->ChangeRenderingParams().Resolution =
-      (unsigned int)(96.0 * myDevicePixelRatio + 0.5);
+  myTextStyle = OcctViewSetup::CreateTextStyle();
+  myView = OcctViewSetup::CreateView(aViewer, aWindow, myDevicePixelRatio);
   myView->ChangeRenderingParams().ToShowStats = true;
   myView->ChangeRenderingParams().StatsTextAspect = myTextStyle->Aspect();
   myView->ChangeRenderingParams().StatsTextHeight = (int)myTextStyle->Height();
-  myView->SetWindow(aWindow);
   dumpGlInfo(false);
 
-  myContext = new AIS_InteractiveContext(aViewer);
+  myContext = OcctViewSetup::CreateContext(aViewer);
   initPixelScaleRatio();
   return true;
 }
@@ -490,7 +899,7 @@ void WasmOcctView::UpdateView() {
 void WasmOcctView::redrawView() {
   if (!myView.IsNull()) {
     myNbUpdateRequests = 0;
-    FlushViewEvents(myContext, myView, true);
+    FlushViewEvents(myContext, FocusView(), true);
   }
 }
 
@@ -501,6 +910,27 @@ void WasmOcctView::redrawView() {
 void WasmOcctView::handleViewRedraw(const Handle(AIS_InteractiveContext) &
                                         theCtx,
                                     const Handle(V3d_View) & theView) {
+  if (myToLinkViews) {
+    syncViewCameras(theView);
+  }
+
+  // hover and selection highlighting invalidates only the immediate layer,
+  // which is drawn over the main scene cached in offscreen buffer
+  bool isInvalidated = myToAskNextFrame || myView->IsInvalidated();
+  bool isInvalidatedImmediate = myView->IsInvalidatedImmediate();
+  for (NCollection_IndexedDataMap<TCollection_AsciiString,
+                                  Handle(V3d_View)>::Iterator
+           aViewIter(mySubviews);
+       aViewIter.More(); aViewIter.Next()) {
+    isInvalidated = isInvalidated || aViewIter.Value()->IsInvalidated();
+    isInvalidatedImmediate =
+        isInvalidatedImmediate || aViewIter.Value()->IsInvalidatedImmediate();
+  }
+  if (isInvalidated) {
+    ++myNbFullRedraws;
+  } else if (isInvalidatedImmediate) {
+    ++myNbImmediateRedraws;
+  }
   AIS_ViewController::handleViewRedraw(theCtx, theView);
   if (myToAskNextFrame) {
     // ask more frames
@@ -510,6 +940,30 @@ void WasmOcctView::handleViewRedraw(const Handle(AIS_InteractiveContext) &
   }
 }
 
+// ================================================================
+// Function : handleSelectionPick
+// Purpose  :
+// ================================================================
+void WasmOcctView::handleSelectionPick(const Handle(AIS_InteractiveContext) &
+                                           theCtx,
+                                       const Handle(V3d_View) & theView) {
+  if (myGL.Selection.Tool != AIS_ViewSelectionTool_Picking ||
+      myGL.Selection.Points.Length() != 1) {
+    AIS_ViewController::handleSelectionPick(theCtx, theView);
+    return;
+  }
+
+  // same as the base implementation, but without invalidating the viewer -
+  // selection is highlighted within the immediate layer
+  const Graphic3d_Vec2i aPnt = myGL.Selection.Points.Last();
+  myGL.Selection.Points.Clear();
+  ResetPreviousMoveTo();
+  theCtx->MoveTo(aPnt.x(), aPnt.y(), theView, false);
+  theCtx->SelectDetected(myGL.Selection.Scheme);
+  invalidateImmediateViews();
+  OnSelectionChanged(theCtx, theView);
+}
+
 // ================================================================
 // Function : onResizeEvent
 // Purpose  :
@@ -566,6 +1020,9 @@ EM_BOOL WasmOcctView::onMouseEvent(int theEventType,
   }
 
   Handle(Wasm_Window) aWindow = Handle(Wasm_Window)::DownCast(myView->Window());
+  if (theEventType == EMSCRIPTEN_EVENT_MOUSEDOWN) {
+    focusViewAt(theEvent->targetX, theEvent->targetY);
+  }
   if (theEventType == EMSCRIPTEN_EVENT_MOUSEMOVE ||
       theEventType == EMSCRIPTEN_EVENT_MOUSEUP) {
     // these events are bound to EMSCRIPTEN_EVENT_TARGET_WINDOW, and coordinates
@@ -592,6 +1049,7 @@ EM_BOOL WasmOcctView::onWheelEvent(int theEventType,
     return EM_FALSE;
   }
 
+  focusViewAt(theEvent->mouse.targetX, theEvent->mouse.targetY);
   Handle(Wasm_Window) aWindow = Handle(Wasm_Window)::DownCast(myView->Window());
   return aWindow->ProcessWheelEvent(*this, theEventType, theEvent) ? EM_TRUE
                                                                    : EM_FALSE;
@@ -607,6 +1065,9 @@ EM_BOOL WasmOcctView::onTouchEvent(int theEventType,
     return EM_FALSE;
   }
 
+  if (theEventType == EMSCRIPTEN_EVENT_TOUCHSTART && theEvent->numTouches > 0) {
+    focusViewAt(theEvent->touches[0].targetX, theEvent->touches[0].targetY);
+  }
   Handle(Wasm_Window) aWindow = Handle(Wasm_Window)::DownCast(myView->Window());
   return aWindow->ProcessTouchEvent(*this, theEventType, theEvent) ? EM_TRUE
                                                                    : EM_FALSE;
@@ -761,15 +1222,33 @@ bool WasmOcctView::processKeyPress(Aspect_VKey theKey) {
 // Purpose  :
 // ================================================================
 void WasmOcctView::setCubemapBackground(const std::string& theImagePath) {
-  if (!theImagePath.empty()) {
-    emscripten_async_wget(theImagePath.c_str(), "/emulated/cubemap.jpg",
-                          CubemapAsyncLoader::onImageRead,
-                          CubemapAsyncLoader::onImageFailed);
-  } else {
-    WasmOcctView::Instance().View()->SetBackgroundCubeMap(
-        Handle(Graphic3d_CubeMapPacked)(), true, false);
-    WasmOcctView::Instance().UpdateView();
+  // pending request is superseded
+  const int aTaskId = ++CubemapAsyncLoader::LastId();
+  CubemapAsyncLoader::Path() = theImagePath;
+  CubemapAsyncLoader::Image().Nullify();
+  if (theImagePath.empty()) {
+    CubemapAsyncLoader::SetCubemap(Handle(Graphic3d_CubeMapPacked)());
+    return;
+  }
+  if (!CubemapAsyncLoader::IsCompressed(theImagePath)) {
+    jsDecodeCubemap(aTaskId, theImagePath.c_str());
+    return;
+  }
+
+  Handle(OpenGl_GraphicDriver) aDriver = Handle(OpenGl_GraphicDriver)::DownCast(
+      Instance().View()->Viewer()->Driver());
+  const Handle(OpenGl_Context)& aGlCtx = aDriver->GetSharedContext();
+  if (aGlCtx.IsNull() || !aGlCtx->SupportedTextureFormats()->HasCompressed()) {
+    Message::SendFail() << "Error: compressed textures are not supported by "
+                           "WebGL context, unable to load '"
+                        << theImagePath.c_str() << "'";
+    return;
   }
+  emscripten_async_wget2(theImagePath.c_str(),
+                         CubemapAsyncLoader::CompressedFile(aTaskId).c_str(),
+                         "GET", "", (void*)(intptr_t)aTaskId,
+                         CubemapAsyncLoader::onCompressedRead,
+                         CubemapAsyncLoader::onCompressedFailed, nullptr);
 }
 
 // ================================================================
@@ -779,9 +1258,9 @@ void WasmOcctView::setCubemapBackground(const std::string& theImagePath) {
 void WasmOcctView::fitAllObjects(bool theAuto) {
   WasmOcctView& aViewer = Instance();
   if (theAuto) {
-    aViewer.FitAllAuto(aViewer.Context(), aViewer.View());
+    aViewer.FitAllAuto(aViewer.Context(), aViewer.FocusView());
   } else {
-    aViewer.View()->FitAll(0.01, false);
+    aViewer.FocusView()->FitAll(0.01, false);
   }
   aViewer.UpdateView();
 }
@@ -793,12 +1272,27 @@ void WasmOcctView::fitAllObjects(bool theAuto) {
 void WasmOcctView::removeAllObjects() {
   WasmOcctView& aViewer = Instance();
   for (NCollection_IndexedDataMap<TCollection_AsciiString,
-                                  Handle(AIS_InteractiveObject)>::Iterator
-           anObjIter(aViewer.myObjects);
-       anObjIter.More(); anObjIter.Next()) {
-    aViewer.Context()->Remove(anObjIter.Value(), false);
+                                  Handle(WasmOcctModel)>::Iterator
+           aModelIter(aViewer.myModels);
+       aModelIter.More(); aModelIter.Next()) {
+    const Handle(WasmOcctModel)& aModel = aModelIter.Value();
+    for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+             aModel->Objects);
+         anObjIter.More(); anObjIter.Next()) {
+      aViewer.Context()->Remove(anObjIter.Value(), false);
+    }
+    if (!aModel->EdgeOverlay.IsNull()) {
+      aViewer.Context()->Remove(aModel->EdgeOverlay, false);
+    }
+    if (!aModel->MeshPrs.IsNull()) {
+      aViewer.Context()->Remove(aModel->MeshPrs, false);
+    }
+    if (!aModel->IsoPrs.IsNull()) {
+      aViewer.Context()->Remove(aModel->IsoPrs, false);
+    }
+    aViewer.myRemeshQueue.Remove(aModel);
   }
-  aViewer.myObjects.Clear();
+  aViewer.myModels.Clear();
   aViewer.UpdateView();
 }
 
@@ -807,20 +1301,32 @@ void WasmOcctView::removeAllObjects() {
 // Purpose  :
 // ================================================================
 bool WasmOcctView::removeObject(const std::string& theName) {
-  spdlog::debug(__func__);
-
   WasmOcctView& aViewer = Instance();
-  spdlog::debug("objects : {}", aViewer.myObjects.Size());
-  Handle(AIS_InteractiveObject) anObj;
-  if (!theName.empty() &&
-      !aViewer.myObjects.FindFromKey(theName.c_str(), anObj)) {
+  Handle(WasmOcctModel) aModel;
+  if (theName.empty() ||
+      !aViewer.myModels.FindFromKey(theName.c_str(), aModel)) {
     return false;
   }
 
-  aViewer.Context()->Remove(anObj, false);
-  aViewer.myObjects.RemoveKey(theName.c_str());
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+           aModel->Objects);
+       anObjIter.More(); anObjIter.Next()) {
+    aViewer.Context()->Remove(anObjIter.Value(), false);
+  }
+  if (!aModel->EdgeOverlay.IsNull()) {
+    aViewer.Context()->Remove(aModel->EdgeOverlay, false);
+  }
+  if (!aModel->MeshPrs.IsNull()) {
+    aViewer.Context()->Remove(aModel->MeshPrs, false);
+  }
+  if (!aModel->IsoPrs.IsNull()) {
+    aViewer.Context()->Remove(aModel->IsoPrs, false);
+  }
+  aViewer.myRemeshQueue.Remove(aModel);
+  aViewer.myModels.RemoveKey(theName.c_str());
   aViewer.UpdateView();
-  spdlog::debug("{} done.", __func__);
+  WASM_LOG_DEBUG("removed '{}', {} models left", theName,
+                 aViewer.myModels.Size());
   return true;
 }
 
@@ -830,13 +1336,26 @@ bool WasmOcctView::removeObject(const std::string& theName) {
 // ================================================================
 bool WasmOcctView::eraseObject(const std::string& theName) {
   WasmOcctView& aViewer = Instance();
-  Handle(AIS_InteractiveObject) anObj;
-  if (!theName.empty() &&
-      !aViewer.myObjects.FindFromKey(theName.c_str(), anObj)) {
+  Handle(WasmOcctModel) aModel;
+  if (theName.empty() ||
+      !aViewer.myModels.FindFromKey(theName.c_str(), aModel)) {
     return false;
   }
 
-  aViewer.Context()->Erase(anObj, false);
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+           aModel->Objects);
+       anObjIter.More(); anObjIter.Next()) {
+    aViewer.Context()->Erase(anObjIter.Value(), false);
+  }
+  if (!aModel->EdgeOverlay.IsNull()) {
+    aViewer.Context()->Erase(aModel->EdgeOverlay, false);
+  }
+  if (!aModel->MeshPrs.IsNull()) {
+    aViewer.Context()->Erase(aModel->MeshPrs, false);
+  }
+  if (!aModel->IsoPrs.IsNull()) {
+    aViewer.Context()->Erase(aModel->IsoPrs, false);
+  }
   aViewer.UpdateView();
   return true;
 }
@@ -847,13 +1366,26 @@ bool WasmOcctView::eraseObject(const std::string& theName) {
 // ================================================================
 bool WasmOcctView::displayObject(const std::string& theName) {
   WasmOcctView& aViewer = Instance();
-  Handle(AIS_InteractiveObject) anObj;
-  if (!theName.empty() &&
-      !aViewer.myObjects.FindFromKey(theName.c_str(), anObj)) {
+  Handle(WasmOcctModel) aModel;
+  if (theName.empty() ||
+      !aViewer.myModels.FindFromKey(theName.c_str(), aModel)) {
     return false;
   }
 
-  aViewer.Context()->Display(anObj, false);
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+           aModel->Objects);
+       anObjIter.More(); anObjIter.Next()) {
+    aViewer.Context()->Display(anObjIter.Value(), false);
+  }
+  if (!aModel->EdgeOverlay.IsNull()) {
+    aViewer.Context()->Display(aModel->EdgeOverlay, false);
+  }
+  if (!aModel->MeshPrs.IsNull()) {
+    aViewer.Context()->Display(aModel->MeshPrs, false);
+  }
+  if (!aModel->IsoPrs.IsNull()) {
+    aViewer.Context()->Display(aModel->IsoPrs, 0, -1, false);
+  }
   aViewer.UpdateView();
   return true;
 }
@@ -865,10 +1397,35 @@ bool WasmOcctView::displayObject(const std::string& theName) {
 void WasmOcctView::openFromUrl(const std::string& theName,
                                const std::string& theModelPath) {
   ModelAsyncLoader* aTask =
-      new ModelAsyncLoader(theName.c_str(), theModelPath.c_str());
-  emscripten_async_wget_data(theModelPath.c_str(), (void*)aTask,
-                             ModelAsyncLoader::onDataRead,
-                             ModelAsyncLoader::onReadFailed);
+      new ModelAsyncLoader(theName.c_str(), theModelPath.c_str(), false);
+  jsFetchModel(aTask->Id, theModelPath.c_str());
+}
+
+// ================================================================
+// Function : updateFromUrl
+// Purpose  :
+// ================================================================
+void WasmOcctView::updateFromUrl(const std::string& theName,
+                                 const std::string& theModelPath) {
+  ModelAsyncLoader* aTask =
+      new ModelAsyncLoader(theName.c_str(), theModelPath.c_str(), true);
+  jsFetchModel(aTask->Id, theModelPath.c_str());
+}
+
+// ================================================================
+// Function : cancelOpenFromUrl
+// Purpose  :
+// ================================================================
+bool WasmOcctView::cancelOpenFromUrl(const std::string& theName) {
+  for (const auto& aTaskIter : ModelAsyncLoader::Tasks()) {
+    if (aTaskIter.second->Name == theName) {
+      // the task is released by onModelFetchDone() on abort
+      aTaskIter.second->IsCancelled = true;
+      jsAbortFetchModel(aTaskIter.first);
+      return true;
+    }
+  }
+  return false;
 }
 
 // ================================================================
@@ -876,35 +1433,74 @@ void WasmOcctView::openFromUrl(const std::string& theName,
 // Purpose  :
 // ================================================================
 bool WasmOcctView::openFromMemory(const std::string& theName,
-                                  uintptr_t theBuffer, int theDataLen,
+                                  uintptr_t theBuffer, size_t theDataLen,
                                   bool theToFree) {
-  removeAllObjects();
-  removeObject(theName);
+  return loadFromMemory(theName, theBuffer, theDataLen, theToFree, false);
+}
+
+// ================================================================
+// Function : updateFromMemory
+// Purpose  :
+// ================================================================
+bool WasmOcctView::updateFromMemory(const std::string& theName,
+                                    uintptr_t theBuffer, size_t theDataLen,
+                                    bool theToFree) {
+  return loadFromMemory(theName, theBuffer, theDataLen, theToFree, true);
+}
+
+// ================================================================
+// Function : loadFromMemory
+// Purpose  :
+// ================================================================
+bool WasmOcctView::loadFromMemory(const std::string& theName,
+                                  uintptr_t theBuffer, size_t theDataLen,
+                                  bool theToFree, bool theToUpdate) {
   char* aBytes = reinterpret_cast<char*>(theBuffer);
-  if (aBytes == nullptr || theDataLen <= 0) {
+  if (aBytes == nullptr || theDataLen == 0) {
     return false;
   }
 
-  auto ext = std::filesystem::path(theName).extension();
+  WasmOcctView& aViewer = Instance();
+  Handle(WasmOcctModel) aPrevModel;
+  if (theToUpdate) {
+    aViewer.myModels.FindFromKey(theName.c_str(), aPrevModel);
+  }
 
-// Function to check if specified data stream starts with specified header.
-#define dataStartsWithHeader(theData, theHeader) \
-  (::strncmp(theData, theHeader, sizeof(theHeader) - 1) == 0)
+  Handle(WasmOcctModel) aModel;
+  switch (ModelFormatTool::Detect(theName, aBytes, theDataLen)) {
+    case ModelFormat_BRep:
+    case ModelFormat_BinBRep:
+      aModel = readBRepModel(theName, theBuffer, theDataLen, theToFree,
+                             aPrevModel);
+      break;
+    case ModelFormat_STEP:
+    case ModelFormat_IGES:
+      aModel = readXCafModel(theName, theBuffer, theDataLen, theToFree,
+                             aPrevModel);
+      break;
+    case ModelFormat_VTK:
+    case ModelFormat_Nastran:
+    case ModelFormat_Abaqus:
+      aModel = readFeMeshModel(theName, theBuffer, theDataLen, theToFree);
+      break;
+    case ModelFormat_Unknown:
+      if (theToFree) {
+        free(aBytes);
+      }
+      Message::SendFail() << "Error: file '" << theName.c_str()
+                          << "' has unsupported format";
+      return false;
+  }
 
-  if (dataStartsWithHeader(aBytes, "DBRep_DrawableShape")) {
-    return openBRepFromMemory(theName, theBuffer, theDataLen, theToFree);
-  } else if (dataStartsWithHeader(aBytes, "glTF")) {
-    // return openGltfFromMemory (theName, theBuffer, theDataLen, theToFree);
-  } else if (dataStartsWithHeader(aBytes, "ISO-10303-21") | ext == ".iges") {
-    return openSTEPAndIGESFromMemory(theName, theBuffer, theDataLen, theToFree);
+  // previous scene is kept on failure or cancellation
+  if (aModel.IsNull()) {
+    return false;
   }
-  if (theToFree) {
-    free(aBytes);
+  aViewer.showModel(theName.c_str(), aModel, aPrevModel);
+  if (!theToUpdate) {
+    aViewer.removeOtherObjects(theName.c_str());
   }
-
-  Message::SendFail() << "Error: file '" << theName.c_str()
-                      << "' has unsupported format";
-  return false;
+  return true;
 }
 
 // ================================================================
@@ -912,167 +1508,1587 @@ bool WasmOcctView::openFromMemory(const std::string& theName,
 // Purpose  :
 // ================================================================
 bool WasmOcctView::openBRepFromMemory(const std::string& theName,
-                                      uintptr_t theBuffer, int theDataLen,
+                                      uintptr_t theBuffer, size_t theDataLen,
                                       bool theToFree) {
-  Message::SendTrace() << "starting reading : " << theName;
-  removeObject(theName);
+  Handle(WasmOcctModel) aModel = readBRepModel(
+      theName, theBuffer, theDataLen, theToFree, Handle(WasmOcctModel)());
+  if (aModel.IsNull()) {
+    return false;
+  }
+  Instance().showModel(theName.c_str(), aModel, Handle(WasmOcctModel)());
+  return true;
+}
+
+// ================================================================
+// Function : readBRepModel
+// Purpose  :
+// ================================================================
+Handle(WasmOcctModel) WasmOcctView::readBRepModel(
+    const std::string& theName, uintptr_t theBuffer, size_t theDataLen,
+    bool theToFree, const Handle(WasmOcctModel) & thePrevModel) {
+  WASM_LOG_TRACE("starting reading : {}", theName);
 
   WasmOcctView& aViewer = Instance();
+  Handle(WasmProgressIndicator) aProgress =
+      new WasmProgressIndicator(theName.c_str());
+  Message_ProgressScope aPS(aProgress->Start(), "Loading", 100);
   TopoDS_Shape aShape;
-  BRep_Builder aBuilder;
-  bool isLoaded = false;
   {
+    // compressed data is inflated while parsing
     char* aRawData = reinterpret_cast<char*>(theBuffer);
-    Standard_ArrayStreamBuffer aStreamBuffer(aRawData, theDataLen);
-    std::istream aStream(&aStreamBuffer);
-    BRepTools::Read(aShape, aStream, aBuilder);
+    const bool isRead = ModelReader::ReadBRep(
+        theName, aRawData, theDataLen, aShape, aPS.Next(60));
     if (theToFree) {
       free(aRawData);
     }
-    isLoaded = true;
+    if (aPS.UserBreak()) {
+      Message::SendWarning() << "Loading of '" << theName.c_str()
+                             << "' has been cancelled";
+      return Handle(WasmOcctModel)();
+    }
+    if (!isRead) {
+      Message::SendFail() << "Error: unable to read file '" << theName.c_str()
+                          << "'";
+      return Handle(WasmOcctModel)();
+    }
   }
-  if (!isLoaded) {
-    return false;
+
+  Handle(WasmOcctModel) aModel = new WasmOcctModel();
+  aModel->Objects.Append(new AIS_Shape(aShape));
+  aViewer.reuseModel(thePrevModel, aModel);
+  if (!aViewer.meshModel(aModel, aPS.Next(40))) {
+    Message::SendWarning() << "Loading of '" << theName.c_str()
+                           << "' has been cancelled";
+    return Handle(WasmOcctModel)();
   }
+  return aModel;
+}
 
-  Handle(AIS_Shape) aShapePrs = new AIS_Shape(aShape);
-  if (!theName.empty()) {
-    aViewer.myObjects.Add(theName.c_str(), aShapePrs);
+// ================================================================
+// Function : readFeMeshModel
+// Purpose  :
+// ================================================================
+Handle(WasmOcctModel) WasmOcctView::readFeMeshModel(const std::string& theName,
+                                                    uintptr_t theBuffer,
+                                                    size_t theDataLen,
+                                                    bool theToFree) {
+  WASM_LOG_TRACE("starting reading mesh : {}", theName);
+
+  Handle(WasmProgressIndicator) aProgress =
+      new WasmProgressIndicator(theName.c_str());
+  Message_ProgressScope aPS(aProgress->Start(), "Loading", 100);
+  Handle(FeMesh) aMesh = new FeMesh();
+  {
+    // compressed data is inflated while parsing
+    char* aRawData = reinterpret_cast<char*>(theBuffer);
+    const bool isRead = FeMeshReader::Read(theName, aRawData,
+                                           theDataLen, *aMesh,
+                                           aPS.Next(70));
+    if (theToFree) {
+      free(aRawData);
+    }
+    if (aPS.UserBreak()) {
+      Message::SendWarning() << "Loading of '" << theName.c_str()
+                             << "' has been cancelled";
+      return Handle(WasmOcctModel)();
+    }
+    if (!isRead) {
+      Message::SendFail() << "Error: unable to read mesh '"
+                          << theName.c_str() << "'";
+      return Handle(WasmOcctModel)();
+    }
   }
-  aShapePrs->SetMaterial(Graphic3d_NameOfMaterial_Silver);
-  aViewer.Context()->Display(aShapePrs, AIS_Shaded, 0, false);
-  aViewer.View()->FitAll(0.01, false);
-  aViewer.UpdateView();
 
-  Message::DefaultMessenger()->Send(
-      TCollection_AsciiString("Loaded file ") + theName.c_str(), Message_Info);
-  Message::DefaultMessenger()->Send(OSD_MemInfo::PrintInfo(), Message_Trace);
-  return true;
+  FeMeshSkin aSkin;
+  if (!aMesh->ComputeSkin(aSkin, aPS.Next(30))) {
+    Message::SendWarning() << "Loading of '" << theName.c_str()
+                           << "' has been cancelled";
+    return Handle(WasmOcctModel)();
+  }
+  WASM_LOG_DEBUG("mesh '{}': {} nodes, {} elements, {} skin triangles",
+                 theName, aMesh->NbNodes(), aMesh->NbElements(),
+                 aSkin.NbTriangles());
+
+  Handle(WasmOcctModel) aModel = new WasmOcctModel();
+  aModel->MeshPrs = new WasmFeMeshPrs(aMesh, std::move(aSkin));
+  return aModel;
 }
 
 bool WasmOcctView::openFromString(const std::string& theName,
                                   const std::string& buffer) {
-  Message::SendTrace() << __func__;
+  WASM_LOG_TRACE("{}", __func__);
   return openFromMemory(theName, reinterpret_cast<uintptr_t>(buffer.data()),
                         buffer.length(), false);
 }
 
 bool WasmOcctView::openSTEPAndIGESFromMemory(const std::string& theName,
                                              uintptr_t theBuffer,
-                                             int theDataLen, bool theToFree) {
-  Message::SendTrace() << "open step from memory : " << theName;
-  auto ext = std::filesystem::path(theName).extension();
+                                             size_t theDataLen,
+                                             bool theToFree) {
+  Handle(WasmOcctModel) aModel = readXCafModel(
+      theName, theBuffer, theDataLen, theToFree, Handle(WasmOcctModel)());
+  if (aModel.IsNull()) {
+    return false;
+  }
+  Instance().showModel(theName.c_str(), aModel, Handle(WasmOcctModel)());
+  return true;
+}
 
-  removeObject(theName);
+// ================================================================
+// Function : readXCafModel
+// Purpose  :
+// ================================================================
+Handle(WasmOcctModel) WasmOcctView::readXCafModel(
+    const std::string& theName, uintptr_t theBuffer, size_t theDataLen,
+    bool theToFree, const Handle(WasmOcctModel) & thePrevModel) {
+  WASM_LOG_TRACE("open step from memory : {}", theName);
 
   WasmOcctView& aViewer = Instance();
-  TopoDS_Shape aShape;
+  Handle(WasmProgressIndicator) aProgress =
+      new WasmProgressIndicator(theName.c_str());
+  Message_ProgressScope aPS(aProgress->Start(), "Loading", 100);
+  Handle(WasmOcctModel) aModel = new WasmOcctModel();
   bool isLoaded = false;
 
   {
     char* aRawData = reinterpret_cast<char*>(theBuffer);
-    Standard_ArrayStreamBuffer aStreamBuffer(aRawData, theDataLen);
-    std::istream aStream(&aStreamBuffer);
-    std::filesystem::path wDir("/working");
-    std::filesystem::create_directories(wDir);
-    std::filesystem::path fpath = wDir.append(theName);
-
-    std::fstream fi{fpath, fi.binary | fi.out};
-    fi.write(aRawData, theDataLen);
-    fi.close();
-
-    {
-      Handle(TDocStd_Document) doc;
+    const TCollection_AsciiString aCacheKey =
+        XCafDocumentCache::Key(
+            ModelFormatTool::Detect(theName, aRawData, theDataLen),
+            aRawData, theDataLen);
+    Handle(TDocStd_Document) doc;
+    bool canRead = false;
+    const bool isCached = XCafDocumentCache::Load(aCacheKey, doc);
+    if (isCached) {
+      // product structure, names, colors and layers are restored from
+      // the binary snapshot without parsing and transfer
+      WASM_LOG_DEBUG("restored '{}' from cache", theName);
+      canRead = true;
+      aPS.Next(70);
+    } else {
       XCAFApp_Application::GetApplication()->NewDocument("MDTV-XCAF", doc);
-      bool canRead = false;
-      if (ext == ".step" || ext == ".stp") {
-        STEPCAFControl_Reader reader;
-        reader.SetColorMode(true);
-        reader.SetNameMode(true);
-        reader.SetLayerMode(true);
-        // reader.
-        if (reader.ReadFile(fpath.c_str()) == IFSelect_RetDone) {
-          canRead = true;
-          // Message_ProgressIndicator pi();
-          reader.Transfer(doc);
-        }
-      } else {
-        IGESCAFControl_Reader reader;
-        reader.SetColorMode(true);
-        reader.SetNameMode(true);
-        reader.SetLayerMode(true);
-        // reader.
-        if (reader.ReadFile(fpath.c_str()) == IFSelect_RetDone) {
-          canRead = true;
-          reader.Transfer(doc);
-        }
-      }
-
-      if (!canRead) {
-        Message::DefaultMessenger()->SendFail()
-            << "Failed opening file : " << theName;
-        return false;
-      }
+      canRead = ModelReader::ReadXCaf(theName, aRawData, theDataLen,
+                                      doc, aPS.Next(70));
+    }
+    if (theToFree) {
+      free(aRawData);
+    }
+    if (canRead && !isCached && !aPS.UserBreak() &&
+        XCafDocumentCache::Save(aCacheKey, doc)) {
+      jsSyncModelCache();
+    }
 
-      Handle(XCAFDoc_ShapeTool) shapeTool =
-          XCAFDoc_DocumentTool::ShapeTool(doc->Main());
-      Handle(XCAFDoc_ColorTool) colorTool =
-          XCAFDoc_DocumentTool::ColorTool(doc->Main());
-      TDF_LabelSequence topLevelShapes;
-      shapeTool->GetShapes(topLevelShapes);
-      spdlog::debug("shapes : {}", topLevelShapes.Length());
+    if (canRead && !aPS.UserBreak()) {
+      // one object per free shape, so that objects match roots of the tree;
+      // the document is kept alive by the tree for browsing the assembly
+      aModel->Tree = new ModelTree(doc);
+      const TDF_LabelSequence& topLevelShapes = aModel->Tree->Roots();
+      WASM_LOG_DEBUG("shapes : {}", topLevelShapes.Length());
       for (Standard_Integer iLabel = 1; iLabel <= topLevelShapes.Length();
            ++iLabel) {
         TDF_Label label = topLevelShapes.Value(iLabel);
-        TopoDS_Shape shape;
-        shapeTool->GetShape(label, shape);
-        Handle(AIS_Shape) shapePrs = new AIS_Shape(shape);
-        if (!theName.empty()) {
-          aViewer.myObjects.Add(theName.c_str(), shapePrs);
+        aModel->Objects.Append(
+            new AIS_Shape(XCAFDoc_ShapeTool::GetShape(label)));
+        if (thePrevModel.IsNull()) {
+          aViewer.View()->FitAll(0.01, false);
+          aViewer.UpdateView();
         }
-        shapePrs->SetMaterial(Graphic3d_NameOfMaterial_Silver);
-        aViewer.Context()->Display(shapePrs, AIS_Shaded, 0, false);
-        aViewer.View()->FitAll(0.01, false);
-        aViewer.UpdateView();
       }
-
-      isLoaded = true;
+      aViewer.reuseModel(thePrevModel, aModel);
+      isLoaded = aViewer.meshModel(aModel, aPS.Next(30));
+    } else {
+      XCAFApp_Application::GetApplication()->Close(doc);
     }
 
-    if (theToFree) {
-      free(aRawData);
+    if (!canRead) {
+      Message::DefaultMessenger()->SendFail()
+          << "Failed opening file : " << theName;
+      return Handle(WasmOcctModel)();
     }
   }
 
   if (!isLoaded) {
-    return false;
+    // partially transferred and meshed shapes are released with the model
+    Message::SendWarning() << "Loading of '" << theName.c_str()
+                           << "' has been cancelled";
+    return Handle(WasmOcctModel)();
   }
-  // Handle(AIS_Shape) aShapePrs = new AIS_Shape(aShape);
-  // if (!theName.empty()) {
-  //   aViewer.myObjects.Add(theName.c_str(), aShapePrs);
-  // }
-  // aShapePrs->SetMaterial(Graphic3d_NameOfMaterial_Silver);
-  // aViewer.Context()->Display(aShapePrs, AIS_Shaded, 0, false);
-  aViewer.View()->FitAll(0.01, false);
-  aViewer.UpdateView();
+  return aModel;
+}
 
-  Message::DefaultMessenger()->Send(
-      TCollection_AsciiString("Loaded file ") + theName.c_str(), Message_Info);
-  Message::DefaultMessenger()->Send(OSD_MemInfo::PrintInfo(), Message_Trace);
+// ================================================================
+// Function : showModel
+// Purpose  :
+// ================================================================
+void WasmOcctView::showModel(const TCollection_AsciiString& theName,
+                             const Handle(WasmOcctModel) & theModel,
+                             const Handle(WasmOcctModel) & thePrevModel) {
+  Handle(WasmOcctModel) aCurrModel;
+  myModels.FindFromKey(theName, aCurrModel);
+  if (thePrevModel.IsNull() || aCurrModel != thePrevModel) {
+    removeObject(theName.ToCString());
+    displayModel(theName, theModel);
+    View()->FitAll(0.01, false);
+  } else {
+    // objects reused from the previous revision stay displayed and selected,
+    // and the camera is kept
+    NCollection_Map<Handle(Standard_Transient)> aReused;
+    for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+             theModel->Objects);
+         anObjIter.More(); anObjIter.Next()) {
+      aReused.Add(anObjIter.Value());
+    }
+    for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+             thePrevModel->Objects);
+         anObjIter.More(); anObjIter.Next()) {
+      if (!aReused.Contains(anObjIter.Value())) {
+        myContext->Remove(anObjIter.Value(), false);
+      }
+    }
+    if (!thePrevModel->EdgeOverlay.IsNull()) {
+      myContext->Remove(thePrevModel->EdgeOverlay, false);
+    }
+    if (!thePrevModel->MeshPrs.IsNull()) {
+      myContext->Remove(thePrevModel->MeshPrs, false);
+    }
+    if (!thePrevModel->IsoPrs.IsNull()) {
+      myContext->Remove(thePrevModel->IsoPrs, false);
+    }
 
-  return true;
+    // pending remeshing of reused objects is moved to the new model
+    myRemeshQueue.Move(thePrevModel, theModel);
+    myModels.ChangeFromKey(theName) = theModel;
+    displayModel(TCollection_AsciiString(), theModel);
+  }
+  UpdateView();
+
+  Message::DefaultMessenger()->Send(
+      TCollection_AsciiString("Loaded file ") + theName, Message_Info);
+  WASM_LOG_DEBUG("{}", OSD_MemInfo::PrintInfo().ToCString());
 }
 
 // ================================================================
-// Function : displayGround
+// Function : reuseModel
 // Purpose  :
 // ================================================================
-void WasmOcctView::displayGround(bool theToShow) {
-  static Handle(AIS_Shape) aGroundPrs = new AIS_Shape(TopoDS_Shape());
+void WasmOcctView::reuseModel(const Handle(WasmOcctModel) & thePrevModel,
+                              const Handle(WasmOcctModel) & theModel) {
+  // fingerprints of the previous revision were stored at its load
+  std::unordered_multimap<uint64_t, Handle(AIS_Shape)> aPrevObjects;
+  if (!thePrevModel.IsNull() &&
+      thePrevModel->ObjectFingerprints.size() ==
+          size_t(thePrevModel->Objects.Size())) {
+    for (int anObjIter = 1; anObjIter <= thePrevModel->Objects.Size();
+         ++anObjIter) {
+      aPrevObjects.emplace(thePrevModel->ObjectFingerprints[anObjIter - 1],
+                           thePrevModel->Objects.Value(anObjIter));
+    }
+  }
 
-  WasmOcctView& aViewer = Instance();
-  Bnd_Box aBox;
-  if (theToShow) {
+  // fingerprints of all parts read from the file, including replaced ones
+  ModelFingerprint aFingerprint;
+  theModel->ObjectFingerprints.clear();
+  int aNbReused = 0, aNbParts = 0, aNbReusedParts = 0;
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+           theModel->Objects);
+       anObjIter.More(); anObjIter.Next()) {
+    Handle(AIS_Shape)& anObject = anObjIter.ChangeValue();
+    const uint64_t aHash = aFingerprint.Shape(anObject->Shape());
+    theModel->ObjectFingerprints.push_back(aHash);
+    const auto aPrevIter = aPrevObjects.find(aHash);
+    if (aPrevIter != aPrevObjects.end()) {
+      // unchanged object keeps its presentation, selection and mesh quality
+      anObject = aPrevIter->second;
+      aPrevObjects.erase(aPrevIter);
+      theModel->Fingerprint.AddKnownParts(anObject->Shape(),
+                                          thePrevModel->Fingerprint);
+      ++aNbReused;
+      continue;
+    }
+
+    // parts found in the previous revision bring their triangulation along
+    if (!thePrevModel.IsNull()) {
+      anObject->SetShape(aFingerprint.ReuseParts(
+          anObject->Shape(), thePrevModel->Fingerprint, aNbParts,
+          aNbReusedParts));
+    }
+    theModel->Fingerprint.AddKnownParts(anObject->Shape(), aFingerprint);
+  }
+  if (!thePrevModel.IsNull()) {
+    WASM_LOG_DEBUG("reused {} of {} objects, {} of {} parts of changed "
+                   "objects",
+                   aNbReused, theModel->Objects.Size(), aNbReusedParts,
+                   aNbParts);
+  }
+}
+
+// ================================================================
+// Function : cancelLoading
+// Purpose  :
+// ================================================================
+void WasmOcctView::cancelLoading() {
+  // downloads are aborted rather than leaving a pending request behind,
+  // so that it does not cancel an unrelated load later;
+  // the tasks are released by onModelFetchDone() on abort
+  for (const auto& aTaskIter : ModelAsyncLoader::Tasks()) {
+    aTaskIter.second->IsCancelled = true;
+    jsAbortFetchModel(aTaskIter.first);
+  }
+  if (WasmProgressIndicator::IsActive()) {
+    WasmProgressIndicator::RequestCancel();
+  }
+}
+
+// ================================================================
+// Function : clearModelCache
+// Purpose  :
+// ================================================================
+void WasmOcctView::clearModelCache() {
+  XCafDocumentCache::Clear();
+  jsSyncModelCache();
+}
+
+// ================================================================
+// Function : memoryUsage
+// Purpose  :
+// ================================================================
+double WasmOcctView::memoryUsage() {
+  OSD_MemInfo aMemInfo(false);
+  aMemInfo.SetActive(false);
+  aMemInfo.SetActive(OSD_MemInfo::MemHeapUsage, true);
+  aMemInfo.Update();
+  return double(aMemInfo.Value(OSD_MemInfo::MemHeapUsage));
+}
+
+// ================================================================
+// Function : nbFullRedraws
+// Purpose  :
+// ================================================================
+int WasmOcctView::nbFullRedraws() { return Instance().myNbFullRedraws; }
+
+// ================================================================
+// Function : nbImmediateRedraws
+// Purpose  :
+// ================================================================
+int WasmOcctView::nbImmediateRedraws() {
+  return Instance().myNbImmediateRedraws;
+}
+
+// ================================================================
+// Function : resetRedrawCounters
+// Purpose  :
+// ================================================================
+void WasmOcctView::resetRedrawCounters() {
+  WasmOcctView& aViewer = Instance();
+  aViewer.myNbFullRedraws = 0;
+  aViewer.myNbImmediateRedraws = 0;
+}
+
+// ================================================================
+// Function : detectAt
+// Purpose  :
+// ================================================================
+bool WasmOcctView::detectAt(int theX, int theY) {
+  WasmOcctView& aViewer = Instance();
+  if (aViewer.myView.IsNull()) {
+    return false;
+  }
+
+  aViewer.ResetPreviousMoveTo();
+  aViewer.myContext->MoveTo(theX, theY, aViewer.FocusView(), false);
+  aViewer.invalidateImmediateViews();
+  aViewer.ProcessInput();
+  return aViewer.myContext->HasDetected();
+}
+
+// ================================================================
+// Function : createSubview
+// Purpose  :
+// ================================================================
+Handle(V3d_View) WasmOcctView::createSubview(double theLeft, double theTop,
+                                             double theWidth,
+                                             double theHeight) {
+  if (theLeft < 0.0 || theTop < 0.0 || theWidth <= 0.0 || theHeight <= 0.0 ||
+      theLeft + theWidth > 1.0 || theTop + theHeight > 1.0) {
+    Message::SendFail() << "Error: invalid view layout";
+    return Handle(V3d_View)();
+  }
+#if OCC_VERSION_HEX >= 0x070700
+  // subview size and offset are relative to the main view for values
+  // below 1 and in pixels otherwise
+  const double aMaxFraction = 1.0 - Precision::Confusion();
+  Handle(V3d_View) aView = new V3d_View(myView->Viewer());
+  aView->Camera()->Copy(myView->Camera());
+  aView->ChangeRenderingParams() = myView->RenderingParams();
+  aView->SetImmediateUpdate(false);
+  aView->SetWindow(myView,
+                   Graphic3d_Vec2d(std::min(theWidth, aMaxFraction),
+                                   std::min(theHeight, aMaxFraction)),
+                   Aspect_TOTP_LEFT_UPPER,
+                   Graphic3d_Vec2d(theLeft, theTop));
+  return aView;
+#else
+  Message::SendFail() << "Error: multiple views require OCCT 7.7 or later";
+  return Handle(V3d_View)();
+#endif
+}
+
+// ================================================================
+// Function : addView
+// Purpose  :
+// ================================================================
+bool WasmOcctView::addView(const std::string& theId, double theLeft,
+                           double theTop, double theWidth, double theHeight) {
+  WasmOcctView& aViewer = Instance();
+  if (aViewer.myView.IsNull() || aViewer.mySubviews.Contains(theId.c_str())) {
+    return false;
+  }
+
+  Handle(V3d_View) aView =
+      aViewer.createSubview(theLeft, theTop, theWidth, theHeight);
+  if (aView.IsNull()) {
+    return false;
+  }
+#if OCC_VERSION_HEX >= 0x070700
+  // main view is no more drawn itself, only its subviews
+  aViewer.myView->View()->SetSubviewComposer(true);
+#endif
+  aViewer.mySubviews.Add(theId.c_str(), aView);
+  if (aViewer.myFocusView.IsNull()) {
+    // the main view is hidden by its subviews
+    aViewer.myFocusView = aView;
+  }
+  aViewer.UpdateView();
+  return true;
+}
+
+// ================================================================
+// Function : setViewLayout
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setViewLayout(const std::string& theId, double theLeft,
+                                 double theTop, double theWidth,
+                                 double theHeight) {
+  WasmOcctView& aViewer = Instance();
+  Handle(V3d_View)* anOldView = aViewer.mySubviews.ChangeSeek(theId.c_str());
+  if (anOldView == nullptr) {
+    return false;
+  }
+
+  // subview window cannot be changed - view is recreated with the same camera
+  Handle(V3d_View) aView =
+      aViewer.createSubview(theLeft, theTop, theWidth, theHeight);
+  if (aView.IsNull()) {
+    return false;
+  }
+  aView->Camera()->Copy((*anOldView)->Camera());
+  if (aViewer.myFocusView == *anOldView) {
+    aViewer.myFocusView = aView;
+  }
+  (*anOldView)->Remove();
+  *anOldView = aView;
+  aViewer.UpdateView();
+  return true;
+}
+
+// ================================================================
+// Function : removeView
+// Purpose  :
+// ================================================================
+bool WasmOcctView::removeView(const std::string& theId) {
+  WasmOcctView& aViewer = Instance();
+  Handle(V3d_View) aView;
+  if (!aViewer.mySubviews.FindFromKey(theId.c_str(), aView)) {
+    return false;
+  }
+
+  aView->Remove();
+  aViewer.mySubviews.RemoveKey(theId.c_str());
+  if (aViewer.myFocusView == aView) {
+    aViewer.myFocusView = !aViewer.mySubviews.IsEmpty()
+                              ? aViewer.mySubviews.FindFromIndex(1)
+                              : Handle(V3d_View)();
+  }
+#if OCC_VERSION_HEX >= 0x070700
+  if (aViewer.mySubviews.IsEmpty()) {
+    aViewer.myView->View()->SetSubviewComposer(false);
+  }
+#endif
+  aViewer.UpdateView();
+  return true;
+}
+
+// ================================================================
+// Function : setViewsLinked
+// Purpose  :
+// ================================================================
+void WasmOcctView::setViewsLinked(bool theToLink) {
+  WasmOcctView& aViewer = Instance();
+  aViewer.myToLinkViews = theToLink;
+  if (theToLink && !aViewer.myView.IsNull()) {
+    aViewer.syncViewCameras(aViewer.FocusView());
+    aViewer.UpdateView();
+  }
+}
+
+// ================================================================
+// Function : focusViewAt
+// Purpose  :
+// ================================================================
+void WasmOcctView::focusViewAt(double theX, double theY) {
+#if OCC_VERSION_HEX >= 0x070700
+  if (mySubviews.IsEmpty()) {
+    return;
+  }
+
+  const Graphic3d_Vec2d aPnt =
+      myView->Window()->ConvertPointToBacking(Graphic3d_Vec2d(theX, theY));
+  Handle(V3d_View) aView = myView->PickSubview(Graphic3d_Vec2i(aPnt));
+  if (!aView.IsNull() && aView != myFocusView) {
+    // drop hover highlighting of previously active view
+    if (!myFocusView.IsNull()) {
+      myContext->ClearDetected(false);
+      myFocusView->InvalidateImmediate();
+    }
+    myFocusView = aView;
+  }
+#else
+  (void)theX;
+  (void)theY;
+#endif
+}
+
+// ================================================================
+// Function : syncViewCameras
+// Purpose  :
+// ================================================================
+void WasmOcctView::syncViewCameras(const Handle(V3d_View) & theSource) {
+  const Handle(Graphic3d_Camera)& aSrcCam = theSource->Camera();
+  for (NCollection_IndexedDataMap<TCollection_AsciiString,
+                                  Handle(V3d_View)>::Iterator
+           aViewIter(mySubviews);
+       aViewIter.More(); aViewIter.Next()) {
+    const Handle(V3d_View)& aView = aViewIter.Value();
+    const Handle(Graphic3d_Camera)& aCam = aView->Camera();
+    if (aView == theSource ||
+        (aCam->Eye().IsEqual(aSrcCam->Eye(), Precision::Confusion()) &&
+         aCam->Center().IsEqual(aSrcCam->Center(), Precision::Confusion()) &&
+         aCam->Up().IsEqual(aSrcCam->Up(), Precision::Angular()) &&
+         Abs(aCam->Scale() - aSrcCam->Scale()) <= Precision::Confusion())) {
+      continue;
+    }
+
+    // only orientation is copied - aspect ratio depends on the view size
+    aCam->CopyOrientation(aSrcCam);
+    aCam->SetScale(aSrcCam->Scale());
+    aView->Invalidate();
+  }
+}
+
+// ================================================================
+// Function : invalidateImmediateViews
+// Purpose  :
+// ================================================================
+void WasmOcctView::invalidateImmediateViews() {
+  myView->InvalidateImmediate();
+  for (NCollection_IndexedDataMap<TCollection_AsciiString,
+                                  Handle(V3d_View)>::Iterator
+           aViewIter(mySubviews);
+       aViewIter.More(); aViewIter.Next()) {
+    aViewIter.Value()->InvalidateImmediate();
+  }
+}
+
+// ================================================================
+// Function : meshModel
+// Purpose  :
+// ================================================================
+bool WasmOcctView::meshModel(const Handle(WasmOcctModel) & theModel,
+                             const Message_ProgressRange& theProgress) {
+  Message_ProgressScope aPS(theProgress, "Meshing", theModel->Objects.Size());
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+           theModel->Objects);
+       anObjIter.More() && aPS.More(); anObjIter.Next()) {
+    if (myContext->IsDisplayed(anObjIter.Value())) {
+      // object reused from the previous model revision is already meshed
+      aPS.Next();
+      continue;
+    }
+
+    // not yet displayed object inherits default quality from the context
+    const Handle(Prs3d_Drawer)& aDrawer = anObjIter.Value()->Attributes();
+    aDrawer->SetLink(myContext->DefaultDrawer());
+    aDrawer->SetAutoTriangulation(false);
+    WasmRemeshQueue::MeshObject(anObjIter.Value(), aPS.Next());
+  }
+  return !aPS.UserBreak();
+}
+
+// ================================================================
+// Function : applyMeshQuality
+// Purpose  :
+// ================================================================
+bool WasmOcctView::applyMeshQuality(const Handle(Prs3d_Drawer) & theDrawer,
+                                    double theDeflection, double theAngle,
+                                    bool theIsRelative) {
+  if (theDeflection <= 0.0 || theAngle <= 0.0 || theAngle >= 90.0) {
+    Message::SendFail() << "Error: invalid mesh quality " << theDeflection
+                        << ", " << theAngle << " deg";
+    return false;
+  }
+
+  if (theIsRelative) {
+    theDrawer->SetTypeOfDeflection(Aspect_TOD_RELATIVE);
+    theDrawer->SetDeviationCoefficient(theDeflection);
+  } else {
+    theDrawer->SetTypeOfDeflection(Aspect_TOD_ABSOLUTE);
+    theDrawer->SetMaximalChordialDeviation(theDeflection);
+  }
+  theDrawer->SetDeviationAngle(theAngle * M_PI / 180.0);
+  return true;
+}
+
+// ================================================================
+// Function : setMeshQuality
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setMeshQuality(const std::string& theName,
+                                  double theDeflection, double theAngle,
+                                  bool theIsRelative) {
+  WasmOcctView& aViewer = Instance();
+  Handle(WasmOcctModel) aModel;
+  if (!aViewer.myModels.FindFromKey(theName.c_str(), aModel)) {
+    return false;
+  }
+
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+           aModel->Objects);
+       anObjIter.More(); anObjIter.Next()) {
+    const Handle(Prs3d_Drawer)& aDrawer = anObjIter.Value()->Attributes();
+    const double aPrevAngle = aDrawer->DeviationAngle();
+    if (!applyMeshQuality(aDrawer, theDeflection, theAngle, theIsRelative)) {
+      return false;
+    }
+    aViewer.myRemeshQueue.Add(
+        aModel, anObjIter.Value(),
+        Abs(aDrawer->DeviationAngle() - aPrevAngle) > Precision::Angular());
+  }
+  return true;
+}
+
+// ================================================================
+// Function : setObjectMeshQuality
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setObjectMeshQuality(const std::string& theName,
+                                        int theIndex, double theDeflection,
+                                        double theAngle, bool theIsRelative) {
+  WasmOcctView& aViewer = Instance();
+  Handle(WasmOcctModel) aModel;
+  if (!aViewer.myModels.FindFromKey(theName.c_str(), aModel) ||
+      theIndex < 0 || theIndex >= aModel->Objects.Size()) {
+    return false;
+  }
+
+  const Handle(AIS_Shape)& anObject = aModel->Objects.Value(theIndex + 1);
+  const Handle(Prs3d_Drawer)& aDrawer = anObject->Attributes();
+  const double aPrevAngle = aDrawer->DeviationAngle();
+  if (!applyMeshQuality(aDrawer, theDeflection, theAngle, theIsRelative)) {
+    return false;
+  }
+  aViewer.myRemeshQueue.Add(
+      aModel, anObject,
+      Abs(aDrawer->DeviationAngle() - aPrevAngle) > Precision::Angular());
+  return true;
+}
+
+// ================================================================
+// Function : setDefaultMeshQuality
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setDefaultMeshQuality(double theDeflection, double theAngle,
+                                         bool theIsRelative) {
+  return applyMeshQuality(Instance().myContext->DefaultDrawer(), theDeflection,
+                          theAngle, theIsRelative);
+}
+
+// ================================================================
+// Function : nbModelObjects
+// Purpose  :
+// ================================================================
+int WasmOcctView::nbModelObjects(const std::string& theName) {
+  Handle(WasmOcctModel) aModel;
+  if (!Instance().myModels.FindFromKey(theName.c_str(), aModel)) {
+    return -1;
+  }
+  return aModel->Objects.Size();
+}
+
+// ================================================================
+// Function : modelMassProperties
+// Purpose  :
+// ================================================================
+ModelMassProps WasmOcctView::modelMassProperties(const std::string& theName) {
+  Handle(WasmOcctModel) aModel;
+  if (!Instance().myModels.FindFromKey(theName.c_str(), aModel)) {
+    return ModelMassProps();
+  }
+
+  NCollection_Sequence<TopoDS_Shape> aShapes;
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+           aModel->Objects);
+       anObjIter.More(); anObjIter.Next()) {
+    aShapes.Append(anObjIter.Value()->Shape());
+  }
+  return aModel->MassProperties.Compute(aShapes);
+}
+
+// ================================================================
+// Function : objectMassProperties
+// Purpose  :
+// ================================================================
+ModelMassProps WasmOcctView::objectMassProperties(const std::string& theName,
+                                                  int theIndex) {
+  Handle(WasmOcctModel) aModel;
+  if (!Instance().myModels.FindFromKey(theName.c_str(), aModel) ||
+      theIndex < 0 || theIndex >= aModel->Objects.Size()) {
+    return ModelMassProps();
+  }
+  return aModel->MassProperties.Compute(
+      aModel->Objects.Value(theIndex + 1)->Shape());
+}
+
+// ================================================================
+// Function : modelTreeNbChildren
+// Purpose  :
+// ================================================================
+int WasmOcctView::modelTreeNbChildren(const std::string& theName,
+                                      const std::string& theNodeId) {
+  Handle(WasmOcctModel) aModel;
+  if (!Instance().myModels.FindFromKey(theName.c_str(), aModel) ||
+      aModel->Tree.IsNull()) {
+    return -1;
+  }
+  return aModel->Tree->NbChildren(theNodeId);
+}
+
+// ================================================================
+// Function : modelTreeChildren
+// Purpose  :
+// ================================================================
+std::vector<ModelTreeNode> WasmOcctView::modelTreeChildren(
+    const std::string& theName, const std::string& theNodeId, int theOffset,
+    int theCount) {
+  Handle(WasmOcctModel) aModel;
+  if (!Instance().myModels.FindFromKey(theName.c_str(), aModel) ||
+      aModel->Tree.IsNull()) {
+    return std::vector<ModelTreeNode>();
+  }
+  return aModel->Tree->Children(theNodeId, theOffset, theCount);
+}
+
+// ================================================================
+// Function : findModelTreeNodes
+// Purpose  :
+// ================================================================
+std::vector<ModelTreeNode> WasmOcctView::findModelTreeNodes(
+    const std::string& theName, const std::string& theQuery,
+    int theMaxResults) {
+  Handle(WasmOcctModel) aModel;
+  if (!Instance().myModels.FindFromKey(theName.c_str(), aModel) ||
+      aModel->Tree.IsNull()) {
+    return std::vector<ModelTreeNode>();
+  }
+  return aModel->Tree->Find(theQuery, theMaxResults);
+}
+
+// ================================================================
+// Function : selectModelTreeNode
+// Purpose  :
+// ================================================================
+bool WasmOcctView::selectModelTreeNode(const std::string& theName,
+                                       const std::string& theNodeId) {
+  WasmOcctView& aViewer = Instance();
+  Handle(WasmOcctModel) aModel;
+  if (aViewer.myView.IsNull() ||
+      !aViewer.myModels.FindFromKey(theName.c_str(), aModel) ||
+      aModel->Tree.IsNull()) {
+    return false;
+  }
+
+  aViewer.myContext->ClearSelected(false);
+  bool isSelected = theNodeId.empty();
+  int aRootIndex = -1;
+  const TopoDS_Shape aShape = aModel->Tree->NodeShape(theNodeId, aRootIndex);
+  if (!aShape.IsNull() && aRootIndex < aModel->Objects.Size()) {
+    const Handle(AIS_Shape)& anObject = aModel->Objects.Value(aRootIndex + 1);
+    if (aViewer.myContext->IsDisplayed(anObject)) {
+      // the owner only highlights the occurrence within the root object,
+      // the same way as a sub-shape picked in local selection mode
+      aViewer.myContext->AddOrRemoveSelected(
+          new StdSelect_BRepOwner(aShape, anObject, 0, true), false);
+      isSelected = true;
+    }
+  }
+  aViewer.invalidateImmediateViews();
+  aViewer.ProcessInput();
+  return isSelected;
+}
+
+// ================================================================
+// Function : findMeshPrs
+// Purpose  :
+// ================================================================
+Handle(WasmFeMeshPrs) WasmOcctView::findMeshPrs(
+    const std::string& theName) const {
+  Handle(WasmOcctModel) aModel;
+  if (!myModels.FindFromKey(theName.c_str(), aModel)) {
+    return Handle(WasmFeMeshPrs)();
+  }
+  return Handle(WasmFeMeshPrs)::DownCast(aModel->MeshPrs);
+}
+
+// ================================================================
+// Function : findMeshField
+// Purpose  :
+// ================================================================
+const FeResultField* WasmOcctView::findMeshField(
+    const Handle(WasmFeMeshPrs) & thePrs, const std::string& theFieldName) {
+  if (thePrs.IsNull()) {
+    return nullptr;
+  }
+  for (const FeResultField& aField : thePrs->Mesh()->Fields) {
+    if (aField.Name == theFieldName) {
+      return &aField;
+    }
+  }
+  return nullptr;
+}
+
+// ================================================================
+// Function : meshResultFields
+// Purpose  :
+// ================================================================
+std::vector<std::string> WasmOcctView::meshResultFields(
+    const std::string& theName) {
+  std::vector<std::string> aNames;
+  const Handle(WasmFeMeshPrs) aPrs = Instance().findMeshPrs(theName);
+  if (!aPrs.IsNull()) {
+    for (const FeResultField& aField : aPrs->Mesh()->Fields) {
+      aNames.push_back(aField.Name);
+    }
+  }
+  return aNames;
+}
+
+// ================================================================
+// Function : meshNodeIds
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::meshNodeIds(const std::string& theName) {
+  const Handle(WasmFeMeshPrs) aPrs = Instance().findMeshPrs(theName);
+  if (aPrs.IsNull()) {
+    return emscripten::val::global("Int32Array").new_(0);
+  }
+
+  // the view into the heap is copied, as it is invalidated by memory growth
+  const std::vector<int>& anIds = aPrs->Mesh()->NodeIds;
+  return emscripten::val::global("Int32Array")
+      .new_(emscripten::typed_memory_view(anIds.size(), anIds.data()));
+}
+
+// ================================================================
+// Function : meshElementIds
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::meshElementIds(const std::string& theName) {
+  const Handle(WasmFeMeshPrs) aPrs = Instance().findMeshPrs(theName);
+  if (aPrs.IsNull()) {
+    return emscripten::val::global("Int32Array").new_(0);
+  }
+
+  const FeMesh& aMesh = *aPrs->Mesh();
+  emscripten::val anIds =
+      emscripten::val::global("Int32Array").new_(aMesh.NbElements());
+  int anOffset = 0;
+  for (const FeElementBlock& aBlock : aMesh.Blocks) {
+    anIds.call<void>("set",
+                     emscripten::val(emscripten::typed_memory_view(
+                         aBlock.Ids.size(), aBlock.Ids.data())),
+                     anOffset);
+    anOffset += aBlock.NbElements();
+  }
+  return anIds;
+}
+
+// ================================================================
+// Function : showMeshResultField
+// Purpose  :
+// ================================================================
+bool WasmOcctView::showMeshResultField(const std::string& theName,
+                                       const std::string& theFieldName,
+                                       double theMin, double theMax) {
+  WasmOcctView& aViewer = Instance();
+  const Handle(WasmFeMeshPrs) aPrs = aViewer.findMeshPrs(theName);
+  const FeResultField* aField = findMeshField(aPrs, theFieldName);
+  if (aField == nullptr ||
+      !aPrs->SetResult(aField->Values.data(), aField->Values.size(),
+                       aField->NbComponents, aField->Location,
+                       FeResultRange{float(theMin), float(theMax)},
+                       aViewer.myColormap)) {
+    return false;
+  }
+  aViewer.UpdateView();
+  return true;
+}
+
+// ================================================================
+// Function : showMeshResult
+// Purpose  :
+// ================================================================
+bool WasmOcctView::showMeshResult(const std::string& theName,
+                                  uintptr_t theBuffer, int theNbValues,
+                                  int theNbComponents, bool theIsElemental,
+                                  double theMin, double theMax,
+                                  bool theToFree) {
+  WasmOcctView& aViewer = Instance();
+  const Handle(WasmFeMeshPrs) aPrs = aViewer.findMeshPrs(theName);
+  float* aValues = reinterpret_cast<float*>(theBuffer);
+  const bool isShown =
+      !aPrs.IsNull() && aValues != nullptr && theNbValues > 0 &&
+      aPrs->SetResult(aValues, size_t(theNbValues), theNbComponents,
+                      theIsElemental ? FeResultLocation_Element
+                                     : FeResultLocation_Node,
+                      FeResultRange{float(theMin), float(theMax)},
+                      aViewer.myColormap);
+  if (theToFree) {
+    free(aValues);
+  }
+  if (isShown) {
+    aViewer.UpdateView();
+  }
+  return isShown;
+}
+
+// ================================================================
+// Function : setMeshDisplacement
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setMeshDisplacement(const std::string& theName,
+                                       uintptr_t theBuffer, int theNbValues,
+                                       double theScale, bool theToFree) {
+  WasmOcctView& aViewer = Instance();
+  const Handle(WasmFeMeshPrs) aPrs = aViewer.findMeshPrs(theName);
+  float* aValues = reinterpret_cast<float*>(theBuffer);
+  const bool isSet =
+      !aPrs.IsNull() && aValues != nullptr && theNbValues > 0 &&
+      aPrs->SetDisplacements(aValues, size_t(theNbValues), float(theScale));
+  if (isSet) {
+    aViewer.setIsoDisplacements(theName, aValues, size_t(theNbValues),
+                                float(theScale));
+  }
+  if (theToFree) {
+    free(aValues);
+  }
+  if (isSet) {
+    aViewer.UpdateView();
+  }
+  return isSet;
+}
+
+// ================================================================
+// Function : setMeshDisplacementField
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setMeshDisplacementField(const std::string& theName,
+                                            const std::string& theFieldName,
+                                            double theScale) {
+  WasmOcctView& aViewer = Instance();
+  const Handle(WasmFeMeshPrs) aPrs = aViewer.findMeshPrs(theName);
+  const FeResultField* aField = findMeshField(aPrs, theFieldName);
+  if (aField == nullptr || aField->Location != FeResultLocation_Node ||
+      aField->NbComponents != 3 ||
+      !aPrs->SetDisplacements(aField->Values.data(), aField->Values.size(),
+                              float(theScale))) {
+    return false;
+  }
+  aViewer.setIsoDisplacements(theName, aField->Values.data(),
+                              aField->Values.size(), float(theScale));
+  aViewer.UpdateView();
+  return true;
+}
+
+// ================================================================
+// Function : meshResultRange
+// Purpose  :
+// ================================================================
+FeResultRange WasmOcctView::meshResultRange(const std::string& theName) {
+  const Handle(WasmFeMeshPrs) aPrs = Instance().findMeshPrs(theName);
+  return !aPrs.IsNull() ? aPrs->ResultRange() : FeResultRange();
+}
+
+// ================================================================
+// Function : clearMeshResult
+// Purpose  :
+// ================================================================
+bool WasmOcctView::clearMeshResult(const std::string& theName) {
+  WasmOcctView& aViewer = Instance();
+  const Handle(WasmFeMeshPrs) aPrs = aViewer.findMeshPrs(theName);
+  if (aPrs.IsNull()) {
+    return false;
+  }
+  aPrs->ClearResults();
+  aViewer.setIsoDisplacements(theName, nullptr, 0, 0.0f);
+  aViewer.UpdateView();
+  return true;
+}
+
+// ================================================================
+// Function : setResultColormap
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setResultColormap(const std::string& theColormap) {
+  WasmOcctView& aViewer = Instance();
+  if (!FeColormap::FromName(theColormap, aViewer.myColormap)) {
+    return false;
+  }
+
+  for (NCollection_IndexedDataMap<TCollection_AsciiString,
+                                  Handle(WasmOcctModel)>::Iterator
+           aModelIter(aViewer.myModels);
+       aModelIter.More(); aModelIter.Next()) {
+    const Handle(WasmFeMeshPrs) aPrs =
+        Handle(WasmFeMeshPrs)::DownCast(aModelIter.Value()->MeshPrs);
+    if (!aPrs.IsNull()) {
+      aPrs->SetColormap(aPrs->ResultRange(), aViewer.myColormap);
+    }
+  }
+  aViewer.UpdateView();
+  return true;
+}
+
+// ================================================================
+// Function : setIsoScalars
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setIsoScalars(const std::string& theName,
+                                 const float* theValues, size_t theNbValues,
+                                 int theNbComponents,
+                                 FeResultLocation theLocation) {
+  Handle(WasmOcctModel) aModel;
+  if (!myModels.FindFromKey(theName.c_str(), aModel)) {
+    return false;
+  }
+  const Handle(WasmFeMeshPrs) aPrs =
+      Handle(WasmFeMeshPrs)::DownCast(aModel->MeshPrs);
+  if (aPrs.IsNull()) {
+    return false;
+  }
+
+  if (aModel->IsoExtractor.IsNull()) {
+    aModel->IsoExtractor = new FeIsoExtractor(aPrs->Mesh(), aPrs->Skin());
+  }
+  return aModel->IsoExtractor->SetScalars(theValues, theNbValues,
+                                          theNbComponents, theLocation);
+}
+
+// ================================================================
+// Function : findIsoModel
+// Purpose  :
+// ================================================================
+Handle(WasmOcctModel) WasmOcctView::findIsoModel(
+    const std::string& theName) const {
+  Handle(WasmOcctModel) aModel;
+  if (!myModels.FindFromKey(theName.c_str(), aModel) ||
+      aModel->IsoExtractor.IsNull() || !aModel->IsoExtractor->HasScalars()) {
+    return Handle(WasmOcctModel)();
+  }
+  return aModel;
+}
+
+// ================================================================
+// Function : displayIsoPrs
+// Purpose  :
+// ================================================================
+void WasmOcctView::displayIsoPrs(const Handle(WasmOcctModel) & theModel,
+                                 const Handle(WasmFeIsoPrs) & thePrs,
+                                 bool theToSeeThrough) {
+  if (!theModel->IsoPrs.IsNull()) {
+    myContext->Remove(theModel->IsoPrs, false);
+  }
+  theModel->IsoPrs = thePrs;
+  if (!thePrs.IsNull()) {
+    myContext->Display(thePrs, 0, -1, false);
+  }
+  if (theToSeeThrough) {
+    myContext->SetTransparency(theModel->MeshPrs, THE_ISO_SKIN_TRANSPARENCY,
+                               false);
+  } else {
+    myContext->UnsetTransparency(theModel->MeshPrs, false);
+  }
+  UpdateView();
+}
+
+// ================================================================
+// Function : setMeshIsoField
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setMeshIsoField(const std::string& theName,
+                                   const std::string& theFieldName) {
+  WasmOcctView& aViewer = Instance();
+  const FeResultField* aField =
+      findMeshField(aViewer.findMeshPrs(theName), theFieldName);
+  return aField != nullptr &&
+         aViewer.setIsoScalars(theName, aField->Values.data(),
+                               aField->Values.size(), aField->NbComponents,
+                               aField->Location);
+}
+
+// ================================================================
+// Function : setMeshIsoValues
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setMeshIsoValues(const std::string& theName,
+                                    uintptr_t theBuffer, int theNbValues,
+                                    int theNbComponents, bool theIsElemental,
+                                    bool theToFree) {
+  float* aValues = reinterpret_cast<float*>(theBuffer);
+  const bool isSet =
+      aValues != nullptr && theNbValues > 0 &&
+      Instance().setIsoScalars(theName, aValues, size_t(theNbValues),
+                               theNbComponents,
+                               theIsElemental ? FeResultLocation_Element
+                                              : FeResultLocation_Node);
+  if (theToFree) {
+    free(aValues);
+  }
+  return isSet;
+}
+
+// ================================================================
+// Function : showMeshIsosurface
+// Purpose  :
+// ================================================================
+bool WasmOcctView::showMeshIsosurface(const std::string& theName,
+                                      double theValue) {
+  WasmOcctView& aViewer = Instance();
+  const Handle(WasmOcctModel) aModel = aViewer.findIsoModel(theName);
+  if (aModel.IsNull()) {
+    return false;
+  }
+
+  aModel->IsoParams = WasmIsoParams();
+  aModel->IsoParams.Kind = WasmIsoKind_Isosurface;
+  aModel->IsoParams.Min = theValue;
+  aViewer.showIso(theName, aModel);
+  return true;
+}
+
+// ================================================================
+// Function : showMeshIsoLines
+// Purpose  :
+// ================================================================
+bool WasmOcctView::showMeshIsoLines(const std::string& theName,
+                                    double theMin, double theMax,
+                                    int theNbLevels) {
+  WasmOcctView& aViewer = Instance();
+  const Handle(WasmOcctModel) aModel = aViewer.findIsoModel(theName);
+  if (aModel.IsNull() || theNbLevels <= 0) {
+    return false;
+  }
+
+  aModel->IsoParams.Kind = WasmIsoKind_IsoLines;
+  aModel->IsoParams.Min = theMin;
+  aModel->IsoParams.Max = theMax;
+  aModel->IsoParams.NbLevels = theNbLevels;
+  aViewer.showIso(theName, aModel);
+  return true;
+}
+
+// ================================================================
+// Function : showMeshContourBands
+// Purpose  :
+// ================================================================
+bool WasmOcctView::showMeshContourBands(const std::string& theName,
+                                        double theMin, double theMax,
+                                        int theNbBands) {
+  WasmOcctView& aViewer = Instance();
+  const Handle(WasmOcctModel) aModel = aViewer.findIsoModel(theName);
+  if (aModel.IsNull() || theNbBands <= 0) {
+    return false;
+  }
+
+  aModel->IsoParams.Kind = WasmIsoKind_ContourBands;
+  aModel->IsoParams.Min = theMin;
+  aModel->IsoParams.Max = theMax;
+  aModel->IsoParams.NbLevels = theNbBands;
+  aViewer.showIso(theName, aModel);
+  return true;
+}
+
+// ================================================================
+// Function : showIso
+// Purpose  :
+// ================================================================
+void WasmOcctView::showIso(const std::string& theName,
+                           const Handle(WasmOcctModel) & theModel) {
+  const WasmIsoParams& aParams = theModel->IsoParams;
+  const FeIsoExtractor& anExtractor = *theModel->IsoExtractor;
+  const FeResultRange aRange =
+      aParams.Min < aParams.Max
+          ? FeResultRange{float(aParams.Min), float(aParams.Max)}
+          : anExtractor.Range();
+  FeIsoGeometry aGeometry;
+  switch (aParams.Kind) {
+    case WasmIsoKind_None: {
+      displayIsoPrs(theModel, Handle(WasmFeIsoPrs)(), false);
+      return;
+    }
+    case WasmIsoKind_Isosurface: {
+      anExtractor.Isosurface(float(aParams.Min), aGeometry);
+      WASM_LOG_DEBUG("isosurface {} of '{}': {} triangles", aParams.Min,
+                     theName, aGeometry.Levels.size());
+      const std::vector<Graphic3d_Vec4ub> aColors(
+          1, myColormap.Color(float(aParams.Min), anExtractor.Range()));
+      displayIsoPrs(theModel, new WasmFeIsoPrs(aGeometry, false, aColors),
+                    true);
+      return;
+    }
+    case WasmIsoKind_IsoLines: {
+      std::vector<float> aLevels;
+      for (int aLevelIter = 1; aLevelIter <= aParams.NbLevels; ++aLevelIter) {
+        aLevels.push_back(aRange.Min + (aRange.Max - aRange.Min) *
+                                           aLevelIter /
+                                           (aParams.NbLevels + 1));
+      }
+
+      anExtractor.IsoLines(aLevels, aGeometry);
+      WASM_LOG_DEBUG("{} iso-lines of '{}': {} segments", aParams.NbLevels,
+                     theName, aGeometry.Levels.size());
+      const std::vector<Graphic3d_Vec4ub> aColors(aLevels.size(),
+                                                  THE_ISO_LINE_COLOR);
+      displayIsoPrs(theModel, new WasmFeIsoPrs(aGeometry, true, aColors),
+                    false);
+      return;
+    }
+    case WasmIsoKind_ContourBands: {
+      const float aStep = (aRange.Max - aRange.Min) / aParams.NbLevels;
+      std::vector<float> aBounds;
+      std::vector<Graphic3d_Vec4ub> aColors;
+      for (int aBandIter = 0; aBandIter < aParams.NbLevels; ++aBandIter) {
+        if (aBandIter > 0) {
+          aBounds.push_back(aRange.Min + aStep * aBandIter);
+        }
+        // bands are colored by their middle value
+        aColors.push_back(
+            myColormap.Color(aRange.Min + aStep * (aBandIter + 0.5f), aRange));
+      }
+
+      anExtractor.ContourBands(aBounds, aGeometry);
+      WASM_LOG_DEBUG("{} contour bands of '{}': {} triangles",
+                     aParams.NbLevels, theName, aGeometry.Levels.size());
+      displayIsoPrs(theModel, new WasmFeIsoPrs(aGeometry, false, aColors),
+                    false);
+      return;
+    }
+  }
+}
+
+// ================================================================
+// Function : setIsoDisplacements
+// Purpose  :
+// ================================================================
+void WasmOcctView::setIsoDisplacements(const std::string& theName,
+                                       const float* theValues,
+                                       size_t theNbValues, float theScale) {
+  Handle(WasmOcctModel) aModel;
+  if (!myModels.FindFromKey(theName.c_str(), aModel)) {
+    return;
+  }
+  const Handle(WasmFeMeshPrs) aPrs =
+      Handle(WasmFeMeshPrs)::DownCast(aModel->MeshPrs);
+  if (aPrs.IsNull() ||
+      (aModel->IsoExtractor.IsNull() && theValues == nullptr)) {
+    return;
+  }
+
+  // extractor is created here to keep displacements for iso values set later
+  if (aModel->IsoExtractor.IsNull()) {
+    aModel->IsoExtractor = new FeIsoExtractor(aPrs->Mesh(), aPrs->Skin());
+  }
+  if (theValues != nullptr) {
+    aModel->IsoExtractor->SetDisplacements(theValues, theNbValues, theScale);
+  } else {
+    aModel->IsoExtractor->ClearDisplacements();
+  }
+  if (aModel->IsoParams.Kind != WasmIsoKind_None &&
+      aModel->IsoExtractor->HasScalars()) {
+    showIso(theName, aModel);
+  }
+}
+
+// ================================================================
+// Function : clearMeshIso
+// Purpose  :
+// ================================================================
+bool WasmOcctView::clearMeshIso(const std::string& theName) {
+  WasmOcctView& aViewer = Instance();
+  Handle(WasmOcctModel) aModel;
+  if (!aViewer.myModels.FindFromKey(theName.c_str(), aModel) ||
+      aModel->MeshPrs.IsNull()) {
+    return false;
+  }
+  aModel->IsoParams = WasmIsoParams();
+  aViewer.displayIsoPrs(aModel, Handle(WasmFeIsoPrs)(), false);
+  return true;
+}
+
+// ================================================================
+// Function : meshQualityValues
+// Purpose  :
+// ================================================================
+const std::vector<float>* WasmOcctView::meshQualityValues(
+    const std::string& theName, const std::string& theMetric) {
+  Handle(WasmOcctModel) aModel;
+  FeQualityMetric aMetric = FeQualityMetric_AspectRatio;
+  if (!myModels.FindFromKey(theName.c_str(), aModel) ||
+      !FeMeshQuality::MetricFromName(theMetric, aMetric)) {
+    return nullptr;
+  }
+  const Handle(WasmFeMeshPrs) aPrs =
+      Handle(WasmFeMeshPrs)::DownCast(aModel->MeshPrs);
+  if (aPrs.IsNull()) {
+    return nullptr;
+  }
+
+  const std::vector<float>& aValues =
+      aModel->MeshQuality.Values(*aPrs->Mesh(), aMetric);
+  WASM_LOG_DEBUG("quality '{}' of '{}': {} elements", theMetric, theName,
+                 aValues.size());
+  return &aValues;
+}
+
+// ================================================================
+// Function : showMeshQuality
+// Purpose  :
+// ================================================================
+bool WasmOcctView::showMeshQuality(const std::string& theName,
+                                   const std::string& theMetric,
+                                   double theMin, double theMax) {
+  WasmOcctView& aViewer = Instance();
+  const std::vector<float>* aValues =
+      aViewer.meshQualityValues(theName, theMetric);
+  if (aValues == nullptr ||
+      !aViewer.findMeshPrs(theName)->SetResult(
+          aValues->data(), aValues->size(), 1, FeResultLocation_Element,
+          FeResultRange{float(theMin), float(theMax)}, aViewer.myColormap)) {
+    return false;
+  }
+  aViewer.UpdateView();
+  return true;
+}
+
+// ================================================================
+// Function : meshQualityHistogram
+// Purpose  :
+// ================================================================
+FeQualityHistogram WasmOcctView::meshQualityHistogram(
+    const std::string& theName, const std::string& theMetric,
+    int theNbBins) {
+  const std::vector<float>* aValues =
+      Instance().meshQualityValues(theName, theMetric);
+  return aValues != nullptr ? FeMeshQuality::Histogram(*aValues, theNbBins)
+                            : FeQualityHistogram();
+}
+
+// ================================================================
+// Function : exportModel
+// Purpose  :
+// ================================================================
+bool WasmOcctView::exportModel(const std::string& theName,
+                               const std::string& theFormat,
+                               const std::string& theFileName) {
+  WasmOcctView& aViewer = Instance();
+  Handle(WasmOcctModel) aModel;
+  MeshExportFormat aFormat = MeshExportFormat_STL;
+  if (!aViewer.myModels.FindFromKey(theName.c_str(), aModel) ||
+      !MeshExporter::FormatFromName(theFormat, aFormat)) {
+    return false;
+  }
+
+  MeshExporter anExporter;
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+           aModel->Objects);
+       anObjIter.More(); anObjIter.Next()) {
+    anExporter.AddShape(anObjIter.Value()->Shape());
+  }
+  const Handle(WasmFeMeshPrs) aMeshPrs =
+      Handle(WasmFeMeshPrs)::DownCast(aModel->MeshPrs);
+  if (!aMeshPrs.IsNull()) {
+    anExporter.AddSkin(*aMeshPrs->Mesh(), aMeshPrs->Skin());
+  }
+  WASM_LOG_DEBUG("exporting '{}' as {}: {} nodes, {} triangles", theName,
+                 theFormat, anExporter.NbNodes(), anExporter.NbTriangles());
+
+  Handle(WasmProgressIndicator) aProgress =
+      new WasmProgressIndicator(theName.c_str());
+  WasmBlobStreamBuffer aBuffer;
+  std::ostream aStream(&aBuffer);
+  if (!anExporter.Write(aStream, aFormat, aProgress->Start()) ||
+      !aStream.flush()) {
+    Message::SendFail() << "Error: unable to export '" << theName.c_str()
+                        << "' as " << theFormat.c_str();
+    return false;
+  }
+  WASM_LOG_DEBUG("exported '{}': {} bytes", theName, aBuffer.NbWritten());
+  aBuffer.Finish(theFileName, aFormat == MeshExportFormat_STL
+                                  ? "model/stl"
+                                  : "application/octet-stream");
+  return true;
+}
+
+// ================================================================
+// Function : onObjectRemeshed
+// Purpose  :
+// ================================================================
+void WasmOcctView::onObjectRemeshed(const Handle(WasmOcctModel) & theModel,
+                                    const Handle(AIS_Shape) & theObject,
+                                    const ModelMeshStats& theStats) {
+  // presentation is kept if none of object faces has been remeshed
+  ModelMeshStats& aModelStats = theModel->RemeshStats;
+  aModelStats.NbFaces += theStats.NbFaces;
+  aModelStats.NbReused += theStats.NbReused;
+  if (theStats.NbReused < theStats.NbFaces) {
+    myContext->Redisplay(theObject, false);
+  }
+  if (myRemeshQueue.HasJobs(theModel)) {
+    UpdateView();
+    return;
+  }
+
+  // overlay is rebuilt once, when all objects are remeshed
+  if (!theModel->EdgeOverlay.IsNull() &&
+      aModelStats.NbReused < aModelStats.NbFaces) {
+    myContext->Redisplay(theModel->EdgeOverlay, false);
+  }
+  const double aReused =
+      aModelStats.NbFaces > 0
+          ? double(aModelStats.NbReused) / double(aModelStats.NbFaces)
+          : 1.0;
+  for (NCollection_IndexedDataMap<TCollection_AsciiString,
+                                  Handle(WasmOcctModel)>::Iterator
+           aModelIter(myModels);
+       aModelIter.More(); aModelIter.Next()) {
+    if (aModelIter.Value() == theModel) {
+      WASM_LOG_DEBUG("remeshed '{}': {} of {} faces reused",
+                     aModelIter.Key().ToCString(), aModelStats.NbReused,
+                     aModelStats.NbFaces);
+      jsReportRemeshDone(aModelIter.Key().ToCString(), aReused);
+      break;
+    }
+  }
+  aModelStats = ModelMeshStats();
+  UpdateView();
+}
+
+// ================================================================
+// Function : removeOtherObjects
+// Purpose  :
+// ================================================================
+void WasmOcctView::removeOtherObjects(const TCollection_AsciiString& theName) {
+  NCollection_Sequence<TCollection_AsciiString> aNames;
+  for (NCollection_IndexedDataMap<TCollection_AsciiString,
+                                  Handle(WasmOcctModel)>::Iterator
+           aModelIter(myModels);
+       aModelIter.More(); aModelIter.Next()) {
+    if (aModelIter.Key() != theName) {
+      aNames.Append(aModelIter.Key());
+    }
+  }
+  for (NCollection_Sequence<TCollection_AsciiString>::Iterator aNameIter(
+           aNames);
+       aNameIter.More(); aNameIter.Next()) {
+    removeObject(aNameIter.Value().ToCString());
+  }
+}
+
+// ================================================================
+// Function : displayModel
+// Purpose  :
+// ================================================================
+void WasmOcctView::displayModel(const TCollection_AsciiString& theName,
+                                const Handle(WasmOcctModel) & theModel) {
+  if (!theName.IsEmpty()) {
+    myModels.Add(theName, theModel);
+  }
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+           theModel->Objects);
+       anObjIter.More(); anObjIter.Next()) {
+    const Handle(AIS_Shape)& aShapePrs = anObjIter.Value();
+    if (myContext->IsDisplayed(aShapePrs)) {
+      continue;
+    }
+    aShapePrs->SetMaterial(Graphic3d_NameOfMaterial_Silver);
+    myContext->Display(aShapePrs, AIS_Shaded, 0, false);
+  }
+  if (!theModel->MeshPrs.IsNull() &&
+      !myContext->IsDisplayed(theModel->MeshPrs)) {
+    theModel->MeshPrs->SetMaterial(Graphic3d_NameOfMaterial_Silver);
+    myContext->Display(theModel->MeshPrs, 0, 0, false);
+  }
+  // shaded presentations are computed first, so the overlay reuses their mesh
+  updateEdgeOverlay(theModel);
+}
+
+// ================================================================
+// Function : updateEdgeOverlay
+// Purpose  :
+// ================================================================
+void WasmOcctView::updateEdgeOverlay(const Handle(WasmOcctModel) & theModel) {
+  if (!myToShowEdges) {
+    if (!theModel->EdgeOverlay.IsNull()) {
+      myContext->Remove(theModel->EdgeOverlay, false);
+      theModel->EdgeOverlay.Nullify();
+    }
+    return;
+  }
+
+  if (theModel->EdgeOverlay.IsNull() && !theModel->Objects.IsEmpty()) {
+    theModel->EdgeOverlay = new WasmEdgeOverlay(theModel->Shape());
+    myContext->Display(theModel->EdgeOverlay, 0, -1, false);
+  }
+}
+
+// ================================================================
+// Function : setEdgeOverlay
+// Purpose  :
+// ================================================================
+void WasmOcctView::setEdgeOverlay(bool theToShow) {
+  WasmOcctView& aViewer = Instance();
+  if (aViewer.myToShowEdges == theToShow) {
+    return;
+  }
+
+  aViewer.myToShowEdges = theToShow;
+  for (NCollection_IndexedDataMap<TCollection_AsciiString,
+                                  Handle(WasmOcctModel)>::Iterator
+           aModelIter(aViewer.myModels);
+       aModelIter.More(); aModelIter.Next()) {
+    aViewer.updateEdgeOverlay(aModelIter.Value());
+  }
+  aViewer.UpdateView();
+}
+
+// ================================================================
+// Function : displayGround
+// Purpose  :
+// ================================================================
+void WasmOcctView::displayGround(bool theToShow) {
+  static Handle(AIS_Shape) aGroundPrs = new AIS_Shape(TopoDS_Shape());
+
+  WasmOcctView& aViewer = Instance();
+  Bnd_Box aBox;
+  if (theToShow) {
     aViewer.Context()->Remove(aGroundPrs, false);
     aBox = aViewer.View()->View()->MinMaxValues();
   }
@@ -1121,6 +3137,43 @@ void WasmOcctView::displayGround(bool theToShow) {
 
 // Module exports
 EMSCRIPTEN_BINDINGS(OccViewerModule) {
+  emscripten::value_object<ModelMassProps>("MassProperties")
+      .field("isDone", &ModelMassProps::IsDone)
+      .field("volume", &ModelMassProps::Volume)
+      .field("area", &ModelMassProps::Area)
+      .field("centerX", &ModelMassProps::CenterX)
+      .field("centerY", &ModelMassProps::CenterY)
+      .field("centerZ", &ModelMassProps::CenterZ)
+      .field("ixx", &ModelMassProps::Ixx)
+      .field("iyy", &ModelMassProps::Iyy)
+      .field("izz", &ModelMassProps::Izz)
+      .field("ixy", &ModelMassProps::Ixy)
+      .field("ixz", &ModelMassProps::Ixz)
+      .field("iyz", &ModelMassProps::Iyz)
+      .field("minX", &ModelMassProps::MinX)
+      .field("minY", &ModelMassProps::MinY)
+      .field("minZ", &ModelMassProps::MinZ)
+      .field("maxX", &ModelMassProps::MaxX)
+      .field("maxY", &ModelMassProps::MaxY)
+      .field("maxZ", &ModelMassProps::MaxZ);
+  emscripten::value_object<ModelTreeNode>("ModelTreeNode")
+      .field("id", &ModelTreeNode::Id)
+      .field("name", &ModelTreeNode::Name)
+      .field("nbChildren", &ModelTreeNode::NbChildren)
+      .field("objectIndex", &ModelTreeNode::ObjectIndex)
+      .field("isAssembly", &ModelTreeNode::IsAssembly);
+  emscripten::register_vector<ModelTreeNode>("ModelTreeNodeVector");
+  emscripten::value_object<FeResultRange>("ResultRange")
+      .field("min", &FeResultRange::Min)
+      .field("max", &FeResultRange::Max);
+  emscripten::register_vector<std::string>("StringVector");
+  emscripten::register_vector<int>("IntVector");
+  emscripten::value_object<FeQualityHistogram>("QualityHistogram")
+      .field("min", &FeQualityHistogram::Min)
+      .field("max", &FeQualityHistogram::Max)
+      .field("nbInvalid", &FeQualityHistogram::NbInvalid)
+      .field("counts", &FeQualityHistogram::Counts);
+
   emscripten::function("setCubemapBackground",
                        &WasmOcctView::setCubemapBackground);
   emscripten::function("fitAllObjects", &WasmOcctView::fitAllObjects);
@@ -1129,9 +3182,78 @@ EMSCRIPTEN_BINDINGS(OccViewerModule) {
   emscripten::function("eraseObject", &WasmOcctView::eraseObject);
   emscripten::function("displayObject", &WasmOcctView::displayObject);
   emscripten::function("displayGround", &WasmOcctView::displayGround);
+  emscripten::function("setEdgeOverlay", &WasmOcctView::setEdgeOverlay);
+  emscripten::function("setMeshQuality", &WasmOcctView::setMeshQuality);
+  emscripten::function("setObjectMeshQuality",
+                       &WasmOcctView::setObjectMeshQuality);
+  emscripten::function("setDefaultMeshQuality",
+                       &WasmOcctView::setDefaultMeshQuality);
+  emscripten::function("nbModelObjects", &WasmOcctView::nbModelObjects);
+  emscripten::function("modelMassProperties",
+                       &WasmOcctView::modelMassProperties);
+  emscripten::function("objectMassProperties",
+                       &WasmOcctView::objectMassProperties);
+  emscripten::function("modelTreeNbChildren",
+                       &WasmOcctView::modelTreeNbChildren);
+  emscripten::function("modelTreeChildren", &WasmOcctView::modelTreeChildren);
+  emscripten::function("findModelTreeNodes",
+                       &WasmOcctView::findModelTreeNodes);
+  emscripten::function("selectModelTreeNode",
+                       &WasmOcctView::selectModelTreeNode);
+  emscripten::function("meshResultFields", &WasmOcctView::meshResultFields);
+  emscripten::function("meshNodeIds", &WasmOcctView::meshNodeIds);
+  emscripten::function("meshElementIds", &WasmOcctView::meshElementIds);
+  emscripten::function("showMeshResultField",
+                       &WasmOcctView::showMeshResultField);
+  emscripten::function("showMeshResult", &WasmOcctView::showMeshResult,
+                       emscripten::allow_raw_pointers());
+  emscripten::function("setMeshDisplacement",
+                       &WasmOcctView::setMeshDisplacement,
+                       emscripten::allow_raw_pointers());
+  emscripten::function("setMeshDisplacementField",
+                       &WasmOcctView::setMeshDisplacementField);
+  emscripten::function("meshResultRange", &WasmOcctView::meshResultRange);
+  emscripten::function("clearMeshResult", &WasmOcctView::clearMeshResult);
+  emscripten::function("setResultColormap",
+                       &WasmOcctView::setResultColormap);
+  emscripten::function("setMeshIsoField", &WasmOcctView::setMeshIsoField);
+  emscripten::function("setMeshIsoValues", &WasmOcctView::setMeshIsoValues,
+                       emscripten::allow_raw_pointers());
+  emscripten::function("showMeshIsosurface",
+                       &WasmOcctView::showMeshIsosurface);
+  emscripten::function("showMeshIsoLines", &WasmOcctView::showMeshIsoLines);
+  emscripten::function("showMeshContourBands",
+                       &WasmOcctView::showMeshContourBands);
+  emscripten::function("clearMeshIso", &WasmOcctView::clearMeshIso);
+  emscripten::function("showMeshQuality", &WasmOcctView::showMeshQuality);
+  emscripten::function("meshQualityHistogram",
+                       &WasmOcctView::meshQualityHistogram);
+  emscripten::function("exportModel", &WasmOcctView::exportModel);
   emscripten::function("openFromUrl", &WasmOcctView::openFromUrl);
+  emscripten::function("setLogLevel", &WasmLog::SetLevelName);
+  emscripten::function("setLogEcho", &WasmLog::SetEcho);
+  emscripten::function("setLogCapacity", &WasmLog::SetCapacity);
+  emscripten::function("dumpLog", &WasmLog::Dump);
+  emscripten::function("clearLog", &WasmLog::Clear);
+  emscripten::function("updateFromUrl", &WasmOcctView::updateFromUrl);
+  emscripten::function("cancelOpenFromUrl", &WasmOcctView::cancelOpenFromUrl);
+  emscripten::function("cancelLoading", &WasmOcctView::cancelLoading);
+  emscripten::function("clearModelCache", &WasmOcctView::clearModelCache);
+  emscripten::function("memoryUsage", &WasmOcctView::memoryUsage);
+  emscripten::function("nbFullRedraws", &WasmOcctView::nbFullRedraws);
+  emscripten::function("nbImmediateRedraws",
+                       &WasmOcctView::nbImmediateRedraws);
+  emscripten::function("resetRedrawCounters",
+                       &WasmOcctView::resetRedrawCounters);
+  emscripten::function("detectAt", &WasmOcctView::detectAt);
+  emscripten::function("addView", &WasmOcctView::addView);
+  emscripten::function("setViewLayout", &WasmOcctView::setViewLayout);
+  emscripten::function("removeView", &WasmOcctView::removeView);
+  emscripten::function("setViewsLinked", &WasmOcctView::setViewsLinked);
   emscripten::function("openFromMemory", &WasmOcctView::openFromMemory,
                        emscripten::allow_raw_pointers());
+  emscripten::function("updateFromMemory", &WasmOcctView::updateFromMemory,
+                       emscripten::allow_raw_pointers());
   emscripten::function("openFromString", &WasmOcctView::openFromString);
   emscripten::function("openBRepFromMemory", &WasmOcctView::openBRepFromMemory,
                        emscripten::allow_raw_pointers());
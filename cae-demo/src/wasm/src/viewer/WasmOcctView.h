@@ -26,12 +26,20 @@
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
+#include <emscripten/val.h>
 
 #include <AIS_InteractiveContext.hxx>
 #include <AIS_ViewController.hxx>
+#include <Message_ProgressRange.hxx>
 #include <V3d_View.hxx>
 
+#include "FeResult.h"
+#include "WasmOcctModel.h"
+#include "WasmRemeshQueue.h"
+
 class AIS_ViewCube;
+class WasmFeIsoPrs;
+class WasmFeMeshPrs;
 
 //! Sample class creating 3D Viewer within Emscripten canvas.
 class WasmOcctView : protected AIS_ViewController {
@@ -41,8 +49,11 @@ class WasmOcctView : protected AIS_ViewController {
 
  public:  //! @name methods exported by Module
   //! Set cubemap background.
-  //! File will be loaded asynchronously.
-  //! @param theImagePath [in] image path to load
+  //! File will be loaded asynchronously. Images (JPEG, PNG and other formats
+  //! supported by the browser) are decoded by the browser off the main
+  //! thread. DDS cubemaps (e.g. BC1/BC3) are uploaded to the GPU without
+  //! decompression when WebGL context supports S3TC formats.
+  //! @param theImagePath [in] image path to load, empty to reset background
   static void setCubemapBackground(const std::string& theImagePath);
 
   //! Clear all named objects from viewer.
@@ -71,39 +82,389 @@ class WasmOcctView : protected AIS_ViewController {
   //! @param theToShow [in] show or hide flag
   static void displayGround(bool theToShow);
 
+  //! Show/hide edge overlay built from triangulation of loaded models.
+  //! Replaces face boundaries of shaded shapes, which require a separate
+  //! discretization of every edge. Overlay is shown by default.
+  //! @param theToShow [in] show or hide flag
+  static void setEdgeOverlay(bool theToShow);
+
+  //! Set tessellation quality of all objects of the named model.
+  //! Model is remeshed asynchronously in small time slices, and the old mesh
+  //! stays visible until the new one is ready; optional JS callback
+  //! Module.onRemeshDone(name) is called when the whole model is remeshed.
+  //! @param theName       [in] model name
+  //! @param theDeflection [in] linear deflection - absolute, or relative to
+  //!                           the bounding box size of every solid
+  //! @param theAngle      [in] angular deflection in degrees
+  //! @param theIsRelative [in] linear deflection is relative
+  //! @return FALSE if model is not found or parameters are invalid
+  static bool setMeshQuality(const std::string& theName, double theDeflection,
+                             double theAngle, bool theIsRelative);
+
+  //! Set tessellation quality of a single object of the named model,
+  //! see setMeshQuality().
+  //! @param theName  [in] model name
+  //! @param theIndex [in] object index within the model, from 0 to
+  //!                      nbModelObjects() - 1
+  static bool setObjectMeshQuality(const std::string& theName, int theIndex,
+                                   double theDeflection, double theAngle,
+                                   bool theIsRelative);
+
+  //! Set default tessellation quality of models loaded afterwards,
+  //! see setMeshQuality(). Relative deflection is used by default.
+  //! @return FALSE if parameters are invalid
+  static bool setDefaultMeshQuality(double theDeflection, double theAngle,
+                                    bool theIsRelative);
+
+  //! Return number of objects in the named model, or -1 if not found.
+  static int nbModelObjects(const std::string& theName);
+
+  //! Return volume, area, center of mass, inertia and bounding box of the
+  //! named model (see ModelMassProperties). Solids are computed in parallel
+  //! and cached, so that repeated queries are free.
+  //! @return properties with isDone set to FALSE if model is not found
+  static ModelMassProps modelMassProperties(const std::string& theName);
+
+  //! Return mass properties of the object within the named model.
+  //! @param theName  [in] model name
+  //! @param theIndex [in] object index within the model, from 0 to
+  //!                      nbModelObjects() - 1
+  //! @return properties with isDone set to FALSE if object is not found
+  static ModelMassProps objectMassProperties(const std::string& theName,
+                                             int theIndex);
+
+  //! Return number of children of the node of the named STEP/IGES model tree
+  //! (see ModelTree), or -1 if model or node is not found.
+  //! @param theName   [in] model name
+  //! @param theNodeId [in] node id, empty string for the roots
+  static int modelTreeNbChildren(const std::string& theName,
+                                 const std::string& theNodeId);
+
+  //! Return page of children of the node of the named model tree.
+  //! Node objectIndex refers to the model object of the root containing the
+  //! node; the node itself is highlighted by selectModelTreeNode().
+  //! @param theName   [in] model name
+  //! @param theNodeId [in] node id, empty string for the roots
+  //! @param theOffset [in] index of the first child
+  //! @param theCount  [in] maximum number of children to return
+  static std::vector<ModelTreeNode> modelTreeChildren(
+      const std::string& theName, const std::string& theNodeId,
+      int theOffset, int theCount);
+
+  //! Find nodes of the named model tree which name has a word starting with
+  //! the query (case-insensitive). Name index is built on the first search.
+  //! @param theName       [in] model name
+  //! @param theQuery      [in] word prefix
+  //! @param theMaxResults [in] maximum number of nodes to return
+  static std::vector<ModelTreeNode> findModelTreeNodes(
+      const std::string& theName, const std::string& theQuery,
+      int theMaxResults);
+
+  //! Select the node of the named model tree, replacing current selection.
+  //! Nested parts and sub-assemblies are highlighted as located sub-shapes
+  //! of the root object displaying them (see ModelTree::NodeShape()).
+  //! @param theName   [in] model name
+  //! @param theNodeId [in] node id, empty string to clear selection
+  //! @return FALSE if model or node is not found, or node is not displayed
+  static bool selectModelTreeNode(const std::string& theName,
+                                  const std::string& theNodeId);
+
+  //! Return names of result fields read with the named FE mesh.
+  static std::vector<std::string> meshResultFields(const std::string& theName);
+
+  //! Return external node ids of the named FE mesh as Int32Array.
+  //! Values streamed per node are expected in this order, which is the file
+  //! order of node records.
+  //! @return empty array if model is not found
+  static emscripten::val meshNodeIds(const std::string& theName);
+
+  //! Return external element ids of the named FE mesh as Int32Array.
+  //! Values streamed per element are expected in this order, which is the
+  //! file order of supported element records; records of unsupported types
+  //! (beams, rigid elements, etc.) are not part of the mesh, so indices
+  //! generally differ from positions of the records in the file.
+  //! @return empty array if model is not found
+  static emscripten::val meshElementIds(const std::string& theName);
+
+  //! Color the named FE mesh by result field read with the mesh.
+  //! Vector fields are shown by magnitude.
+  //! @param theName      [in] model name
+  //! @param theFieldName [in] field name
+  //! @param theMin       [in] value mapped to the first color
+  //! @param theMax       [in] value mapped to the last color; the range is
+  //!                          computed from the field if theMin >= theMax
+  //! @return FALSE if model or field is not found
+  static bool showMeshResultField(const std::string& theName,
+                                  const std::string& theFieldName,
+                                  double theMin, double theMax);
+
+  //! Color the named FE mesh by result values of a time step.
+  //! Steps are streamed from JS one by one: only colors of skin vertices are
+  //! updated in place, the geometry and presentation are kept, so that
+  //! animation should use a fixed range. Values follow the order of
+  //! meshNodeIds() or meshElementIds(), not the solver ids.
+  //! @param theName         [in] model name
+  //! @param theBuffer       [in] pointer to float32 values
+  //! @param theNbValues     [in] number of values
+  //! @param theNbComponents [in] 1 for scalars, 3 for vectors shown by
+  //!                             magnitude
+  //! @param theIsElemental  [in] values are given per element instead of
+  //!                             per node; skin faces of every element
+  //!                             are colored flat by its value
+  //! @param theMin          [in] value mapped to the first color
+  //! @param theMax          [in] value mapped to the last color, the range is
+  //!                             computed from the values if theMin >= theMax
+  //! @param theToFree       [in] free theBuffer if set to TRUE
+  //! @return FALSE if model is not found or number of values does not match
+  static bool showMeshResult(const std::string& theName, uintptr_t theBuffer,
+                             int theNbValues, int theNbComponents,
+                             bool theIsElemental, double theMin, double theMax,
+                             bool theToFree);
+
+  //! Deform the named FE mesh by nodal displacements of a time step.
+  //! Only positions of skin vertices are updated in place; shown isosurface,
+  //! iso-lines or contour bands are extracted again on the deformed mesh.
+  //! Values follow the order of meshNodeIds().
+  //! @param theName     [in] model name
+  //! @param theBuffer   [in] pointer to float32 values, 3 per node
+  //! @param theNbValues [in] number of values
+  //! @param theScale    [in] displacement scale
+  //! @param theToFree   [in] free theBuffer if set to TRUE
+  //! @return FALSE if model is not found or number of values does not match
+  static bool setMeshDisplacement(const std::string& theName,
+                                  uintptr_t theBuffer, int theNbValues,
+                                  double theScale, bool theToFree);
+
+  //! Deform the named FE mesh by nodal vector field read with the mesh.
+  //! @return FALSE if model or nodal vector field is not found
+  static bool setMeshDisplacementField(const std::string& theName,
+                                       const std::string& theFieldName,
+                                       double theScale);
+
+  //! Return range of result shown on the named FE mesh.
+  static FeResultRange meshResultRange(const std::string& theName);
+
+  //! Restore undeformed uncolored skin of the named FE mesh.
+  //! @return FALSE if model is not found
+  static bool clearMeshResult(const std::string& theName);
+
+  //! Set colormap of results: "rainbow" (default), "viridis", "coolwarm" or
+  //! "grayscale". Shown results are recolored.
+  //! @return FALSE if colormap is unknown
+  static bool setResultColormap(const std::string& theColormap);
+
+  //! Use result field read with the named FE mesh for isosurfaces, iso-lines
+  //! and contour bands. Vector fields are used by magnitude.
+  //! @return FALSE if model or field is not found
+  static bool setMeshIsoField(const std::string& theName,
+                              const std::string& theFieldName);
+
+  //! Use result values for isosurfaces, iso-lines and contour bands of the
+  //! named FE mesh; arguments are the same as for showMeshResult().
+  //! Value ranges of cells are computed here once, so that extraction at
+  //! another value only scans them.
+  //! @return FALSE if model is not found or number of values does not match
+  static bool setMeshIsoValues(const std::string& theName,
+                               uintptr_t theBuffer, int theNbValues,
+                               int theNbComponents, bool theIsElemental,
+                               bool theToFree);
+
+  //! Show isosurface of the named FE mesh at the value; the skin is made
+  //! transparent to see it.
+  //! @return FALSE if model is not found or iso values are not set
+  static bool showMeshIsosurface(const std::string& theName, double theValue);
+
+  //! Show iso-lines on the skin of the named FE mesh at theNbLevels values
+  //! evenly dividing the range.
+  //! @param theName     [in] model name
+  //! @param theMin      [in] range minimum
+  //! @param theMax      [in] range maximum; range of iso values is used if
+  //!                         theMin >= theMax
+  //! @param theNbLevels [in] number of iso-lines
+  //! @return FALSE if model is not found or iso values are not set
+  static bool showMeshIsoLines(const std::string& theName, double theMin,
+                               double theMax, int theNbLevels);
+
+  //! Show the skin of the named FE mesh split into theNbBands contour bands
+  //! evenly dividing the range; values outside of the range fall into the
+  //! first and the last bands.
+  //! @param theName    [in] model name
+  //! @param theMin     [in] range minimum
+  //! @param theMax     [in] range maximum; range of iso values is used if
+  //!                        theMin >= theMax
+  //! @param theNbBands [in] number of bands
+  //! @return FALSE if model is not found or iso values are not set
+  static bool showMeshContourBands(const std::string& theName, double theMin,
+                                   double theMax, int theNbBands);
+
+  //! Remove isosurface, iso-lines or contour bands of the named FE mesh.
+  //! @return FALSE if model is not found
+  static bool clearMeshIso(const std::string& theName);
+
+  //! Color the named FE mesh by element quality metric; like other element
+  //! results, skin faces of every element are colored flat by its value.
+  //! @param theName   [in] model name
+  //! @param theMetric [in] "aspect", "skew", "jacobian" or "warpage"
+  //! @param theMin    [in] value mapped to the first color
+  //! @param theMax    [in] value mapped to the last color; the range of
+  //!                       values is used if theMin >= theMax
+  //! @return FALSE if model or metric is not found
+  static bool showMeshQuality(const std::string& theName,
+                              const std::string& theMetric, double theMin,
+                              double theMax);
+
+  //! Return histogram of element quality metric of the named FE mesh.
+  //! @param theName   [in] model name
+  //! @param theMetric [in] metric name, see showMeshQuality()
+  //! @param theNbBins [in] number of bins between minimal and maximal
+  //!                       finite values
+  //! @return empty histogram if model or metric is not found
+  static FeQualityHistogram meshQualityHistogram(const std::string& theName,
+                                                 const std::string& theMetric,
+                                                 int theNbBins);
+
+  //! Export triangulation of the named model as displayed, without
+  //! remeshing. The file is streamed to JS by chunks and passed as a Blob to
+  //! optional callback Module.onExportDone(fileName, blob), or downloaded;
+  //! progress is reported as for loading.
+  //! @param theName     [in] model name
+  //! @param theFormat   [in] "stl", "vtk" or "brep" (meshed binary BRep,
+  //!                         not available for FE meshes)
+  //! @param theFileName [in] name of exported file
+  //! @return FALSE if model or format is not found, or export has failed
+  static bool exportModel(const std::string& theName,
+                          const std::string& theFormat,
+                          const std::string& theFileName);
+
   //! Open object from the given URL.
-  //! File will be loaded asynchronously.
+  //! File will be downloaded asynchronously as a stream written directly into
+  //! the heap; progress is reported to optional JS callback
+  //! Module.onDownloadProgress(name, loadedBytes, totalBytes).
   //! @param theName      [in] object name
   //! @param theModelPath [in] model path
   static void openFromUrl(const std::string& theName,
                           const std::string& theModelPath);
 
+  //! Update object from the given URL, see updateFromMemory().
+  //! @param theName      [in] object name
+  //! @param theModelPath [in] model path
+  static void updateFromUrl(const std::string& theName,
+                            const std::string& theModelPath);
+
+  //! Cancel download started by openFromUrl().
+  //! @param theName [in] object name
+  //! @return FALSE if there is no active download for this object
+  static bool cancelOpenFromUrl(const std::string& theName);
+
   //! Open object from memory.
+  //! STEP, IGES and BRep data may be gzip- or zstd-compressed (zstd requires
+  //! WITH_ZSTD build option); it is decompressed while being parsed.
+  //! Finite-element meshes (VTK, Nastran, Abaqus) are shown by their skin.
   //! @param theName    [in] object name
   //! @param theBuffer  [in] pointer to data
   //! @param theDataLen [in] data length
   //! @param theToFree  [in] free theBuffer if set to TRUE
   //! @return FALSE on reading error
   static bool openFromMemory(const std::string& theName, uintptr_t theBuffer,
-                             int theDataLen, bool theToFree);
+                             size_t theDataLen, bool theToFree);
+
+  //! Load new revision of the named object from memory.
+  //! Objects and parts are matched with the displayed revision by geometric
+  //! and topological fingerprints (see ModelFingerprint): unchanged objects
+  //! keep their presentations and selection, and only changed parts are
+  //! meshed. Camera and other objects are kept. Falls back to loading
+  //! a new object if there is no object with this name.
+  //! @param theName    [in] object name
+  //! @param theBuffer  [in] pointer to data
+  //! @param theDataLen [in] data length
+  //! @param theToFree  [in] free theBuffer if set to TRUE
+  //! @return FALSE on reading error
+  static bool updateFromMemory(const std::string& theName,
+                               uintptr_t theBuffer, size_t theDataLen,
+                               bool theToFree);
 
   //! Open BRep object from memory.
+  //! Both ASCII (BRepTools) and binary (BinTools) formats are accepted.
   //! @param theName    [in] object name
   //! @param theBuffer  [in] pointer to data
   //! @param theDataLen [in] data length
   //! @param theToFree  [in] free theBuffer if set to TRUE
   //! @return FALSE on reading error
   static bool openBRepFromMemory(const std::string& theName,
-                                 uintptr_t theBuffer, int theDataLen,
+                                 uintptr_t theBuffer, size_t theDataLen,
                                  bool theToFree);
 
   static bool openFromString(const std::string& theName,
                              const std::string& buffer);
 
   static bool openSTEPAndIGESFromMemory(const std::string& theName,
-                                        uintptr_t theBuffer, int theDataLen,
+                                        uintptr_t theBuffer, size_t theDataLen,
                                         bool theToFree);
 
+  //! Request cancellation of the model being loaded, and abort downloads
+  //! started by openFromUrl(); does nothing if no model is being loaded or
+  //! fetched. Loading progress is reported to optional JS callback
+  //! Module.onLoadProgress(name, stage, fraction), which may also return TRUE
+  //! to cancel. Cancelled loading releases all partially loaded data and
+  //! keeps previously displayed objects untouched.
+  static void cancelLoading();
+
+  //! Remove all cached STEP/IGES documents.
+  //! Transferred documents are cached in IndexedDB-backed directory, so that
+  //! re-opening the same file skips parsing and transfer.
+  static void clearModelCache();
+
+  //! Return heap memory in use (allocated by malloc) in bytes.
+  //! Unlike the size of WebAssembly memory, this value decreases when models
+  //! are removed, so it is used by scaling benchmarks.
+  static double memoryUsage();
+
+  //! Return number of full redraws, which render all layers of the scene.
+  static int nbFullRedraws();
+
+  //! Return number of partial redraws, which render only the immediate layer
+  //! (hover and selection highlighting) over the cached main scene.
+  static int nbImmediateRedraws();
+
+  //! Reset redraw counters.
+  static void resetRedrawCounters();
+
+  //! Detect (hover-highlight) object at the canvas point, the same way as
+  //! mouse move does; used to time picking by benchmarks.
+  //! @param theX [in] X coordinate in canvas pixels
+  //! @param theY [in] Y coordinate in canvas pixels
+  //! @return TRUE if an object is detected
+  static bool detectAt(int theX, int theY);
+
+  //! Add view of the same scene within a rectangle of the canvas.
+  //! All views share the viewer, interactive context, presentations and GPU
+  //! buffers, as they are drawn by the same WebGL context, so that every
+  //! view adds only its camera and offscreen buffers. Once a view is added,
+  //! the main view only composes added views, so that the layout is defined
+  //! by added views. Input goes to the view clicked last.
+  //! Requires OCCT 7.7 or later.
+  //! @param theId     [in] view identifier
+  //! @param theLeft   [in] left offset as fraction of canvas width
+  //! @param theTop    [in] top offset as fraction of canvas height
+  //! @param theWidth  [in] width as fraction of canvas width
+  //! @param theHeight [in] height as fraction of canvas height
+  //! @return FALSE if view already exists or layout is invalid
+  static bool addView(const std::string& theId, double theLeft, double theTop,
+                      double theWidth, double theHeight);
+
+  //! Change layout of the view added by addView().
+  //! @return FALSE if view is not found or layout is invalid
+  static bool setViewLayout(const std::string& theId, double theLeft,
+                            double theTop, double theWidth, double theHeight);
+
+  //! Remove view added by addView(); the main view is shown again
+  //! when the last view is removed.
+  //! @return FALSE if view is not found
+  static bool removeView(const std::string& theId);
+
+  //! Synchronize camera orientation of all views with the active one.
+  static void setViewsLinked(bool theToLink);
+
  public:
   //! Default constructor.
   WasmOcctView();
@@ -120,6 +481,12 @@ class WasmOcctView : protected AIS_ViewController {
   //! Return view.
   const Handle(V3d_View) & View() const { return myView; }
 
+  //! Return view receiving input: the last clicked added view (the first
+  //! added one until a click), or the main view if no views are added.
+  const Handle(V3d_View) & FocusView() const {
+    return !myFocusView.IsNull() ? myFocusView : myView;
+  }
+
   //! Return device pixel ratio for handling high DPI displays.
   float DevicePixelRatio() const { return myDevicePixelRatio; }
 
@@ -127,6 +494,130 @@ class WasmOcctView : protected AIS_ViewController {
   void UpdateView();
 
  private:
+  //! Register model under specified name and display it.
+  //! Objects which are already displayed are kept as is.
+  void displayModel(const TCollection_AsciiString& theName,
+                    const Handle(WasmOcctModel) & theModel);
+
+  //! Open or update object from memory.
+  //! @param theToUpdate [in] reuse unchanged parts of the displayed object
+  //!                         and keep other objects
+  static bool loadFromMemory(const std::string& theName, uintptr_t theBuffer,
+                             size_t theDataLen, bool theToFree,
+                             bool theToUpdate);
+
+  //! Read BRep data into new meshed model.
+  //! @param thePrevModel [in] previous revision to reuse parts from or NULL
+  //! @return NULL on reading error or cancellation
+  static Handle(WasmOcctModel) readBRepModel(
+      const std::string& theName, uintptr_t theBuffer, size_t theDataLen,
+      bool theToFree, const Handle(WasmOcctModel) & thePrevModel);
+
+  //! Read STEP or IGES data into new meshed model.
+  //! @param thePrevModel [in] previous revision to reuse parts from or NULL
+  //! @return NULL on reading error or cancellation
+  static Handle(WasmOcctModel) readXCafModel(
+      const std::string& theName, uintptr_t theBuffer, size_t theDataLen,
+      bool theToFree, const Handle(WasmOcctModel) & thePrevModel);
+
+  //! Read finite-element mesh into new model showing its skin.
+  //! @return NULL on reading error or cancellation
+  static Handle(WasmOcctModel) readFeMeshModel(const std::string& theName,
+                                               uintptr_t theBuffer,
+                                               size_t theDataLen,
+                                               bool theToFree);
+
+  //! Display loaded model replacing the named one.
+  //! @param thePrevModel [in] previous revision which objects may be reused
+  //!                          by the model, or NULL to fit the view
+  void showModel(const TCollection_AsciiString& theName,
+                 const Handle(WasmOcctModel) & theModel,
+                 const Handle(WasmOcctModel) & thePrevModel);
+
+  //! Compute fingerprints of objects and parts of not yet meshed model,
+  //! so that they are not computed again for the next revision. Objects
+  //! equal to objects of the previous revision are replaced by them,
+  //! and parts of other objects by known parts.
+  //! @param thePrevModel [in] previous revision or NULL
+  void reuseModel(const Handle(WasmOcctModel) & thePrevModel,
+                  const Handle(WasmOcctModel) & theModel);
+
+  //! Return FE mesh presentation of the named model or NULL.
+  Handle(WasmFeMeshPrs) findMeshPrs(const std::string& theName) const;
+
+  //! Find result field read with FE mesh.
+  static const FeResultField* findMeshField(const Handle(WasmFeMeshPrs) &
+                                                thePrs,
+                                            const std::string& theFieldName);
+
+  //! Return quality metric values of the named FE mesh or NULL.
+  const std::vector<float>* meshQualityValues(const std::string& theName,
+                                              const std::string& theMetric);
+
+  //! Set scalars of iso extraction of the named FE mesh.
+  bool setIsoScalars(const std::string& theName, const float* theValues,
+                     size_t theNbValues, int theNbComponents,
+                     FeResultLocation theLocation);
+
+  //! Extract and display iso presentation of the model with iso values set
+  //! according to its IsoParams.
+  void showIso(const std::string& theName,
+               const Handle(WasmOcctModel) & theModel);
+
+  //! Apply mesh displacements to iso extraction of the named FE mesh,
+  //! extracting shown iso presentation again.
+  //! @param theValues [in] 3 values per node, or NULL to clear displacements
+  void setIsoDisplacements(const std::string& theName, const float* theValues,
+                           size_t theNbValues, float theScale);
+
+  //! Return the named model with iso values set or NULL.
+  Handle(WasmOcctModel) findIsoModel(const std::string& theName) const;
+
+  //! Replace iso presentation of the model.
+  //! @param thePrs          [in] new presentation or NULL to remove
+  //! @param theToSeeThrough [in] make the skin transparent
+  void displayIsoPrs(const Handle(WasmOcctModel) & theModel,
+                     const Handle(WasmFeIsoPrs) & thePrs,
+                     bool theToSeeThrough);
+
+  //! Create or remove edge overlay of the model according to current mode.
+  void updateEdgeOverlay(const Handle(WasmOcctModel) & theModel);
+
+  //! Mesh model shapes with parameters of their presentations.
+  //! Presentations are set up to never mesh shapes by themselves,
+  //! so that meshing is controlled by the viewer only.
+  //! @return FALSE if meshing has been cancelled
+  bool meshModel(const Handle(WasmOcctModel) & theModel,
+                 const Message_ProgressRange& theProgress);
+
+  //! Apply tessellation quality to presentation attributes.
+  //! @return FALSE if parameters are invalid
+  static bool applyMeshQuality(const Handle(Prs3d_Drawer) & theDrawer,
+                               double theDeflection, double theAngle,
+                               bool theIsRelative);
+
+  //! Update presentations of remeshed object.
+  void onObjectRemeshed(const Handle(WasmOcctModel) & theModel,
+                        const Handle(AIS_Shape) & theObject,
+                        const ModelMeshStats& theStats);
+
+  //! Create view within a rectangle of the main view.
+  Handle(V3d_View) createSubview(double theLeft, double theTop,
+                                 double theWidth, double theHeight);
+
+  //! Make the view under specified point of the canvas receiving input.
+  void focusViewAt(double theX, double theY);
+
+  //! Copy camera orientation of the view to other views.
+  void syncViewCameras(const Handle(V3d_View) & theSource);
+
+  //! Invalidate immediate layer (hover and selection highlighting) of the
+  //! main view and all added views, as they share the interactive context.
+  void invalidateImmediateViews();
+
+  //! Remove all models except the named one.
+  void removeOtherObjects(const TCollection_AsciiString& theName);
+
   //! Create window.
   void initWindow();
 
@@ -146,6 +637,11 @@ class WasmOcctView : protected AIS_ViewController {
   virtual void handleViewRedraw(const Handle(AIS_InteractiveContext) & theCtx,
                                 const Handle(V3d_View) & theView) override;
 
+  //! Handle selection by click, invalidating only the immediate layer.
+  virtual void handleSelectionPick(const Handle(AIS_InteractiveContext) &
+                                       theCtx,
+                                   const Handle(V3d_View) & theView) override;
+
   //! Schedule processing of window input events with the next repaint event.
   virtual void ProcessInput() override;
 
@@ -268,15 +764,18 @@ class WasmOcctView : protected AIS_ViewController {
   bool processKeyPress(Aspect_VKey theKey);
 
  private:
-  NCollection_IndexedDataMap<TCollection_AsciiString,
-                             Handle(AIS_InteractiveObject)>
-      myObjects;  //!< map of named objects
+  NCollection_IndexedDataMap<TCollection_AsciiString, Handle(WasmOcctModel)>
+      myModels;                     //!< map of named models
+  WasmRemeshQueue myRemeshQueue;  //!< asynchronous remeshing jobs
 
   NCollection_DataMap<unsigned int, Aspect_VKey>
       myNavKeyMap;  //!< map of Hot-Key (key+modifiers) to Action
 
   Handle(AIS_InteractiveContext) myContext;  //!< interactive context
   Handle(V3d_View) myView;                   //!< 3D view
+  Handle(V3d_View) myFocusView;  //!< added view receiving input or NULL
+  NCollection_IndexedDataMap<TCollection_AsciiString, Handle(V3d_View)>
+      mySubviews;  //!< views added by addView()
   Handle(Prs3d_TextAspect) myTextStyle;      //!< text style for OSD elements
   Handle(AIS_ViewCube) myViewCube;           //!< view cube object
   TCollection_AsciiString myCanvasId;        //!< canvas element id on HTML page
@@ -284,6 +783,11 @@ class WasmOcctView : protected AIS_ViewController {
   float myDevicePixelRatio;  //!< device pixel ratio for handling high DPI
                              //!< displays
   unsigned int myNbUpdateRequests;  //!< counter for unhandled update requests
+  int myNbFullRedraws;              //!< counter of full redraws
+  int myNbImmediateRedraws;         //!< counter of immediate layer redraws
+  bool myToShowEdges;               //!< display edge overlay of models
+  FeColormap myColormap;            //!< colormap of FE results
+  bool myToLinkViews;               //!< synchronize cameras of views
 };
 
 #endif  // _WasmOcctView_HeaderFile
@@ -0,0 +1,109 @@
+#include "WasmProgressIndicator.h"
+
+#include <emscripten.h>
+#include <emscripten/threading.h>
+
+#include <Message_ProgressScope.hxx>
+
+#include <atomic>
+
+namespace {
+//! Pending cancellation request.
+std::atomic<bool> THE_TO_CANCEL(false);
+
+//! Number of existing indicators, i.e. active loadings.
+std::atomic<int> THE_NB_ACTIVE(0);
+}  // namespace
+
+//! Report progress to JS callback; return TRUE if callback requests cancel.
+EM_JS(int, jsReportLoadProgress,
+      (const char* theName, const char* theStage, double theFraction), {
+        if (Module['onLoadProgress'] === undefined) {
+          return 0;
+        }
+        return Module['onLoadProgress'](UTF8ToString(theName),
+                                        UTF8ToString(theStage), theFraction)
+                   ? 1
+                   : 0;
+      });
+
+// ================================================================
+// Function : RequestCancel
+// Purpose  :
+// ================================================================
+void WasmProgressIndicator::RequestCancel() { THE_TO_CANCEL = true; }
+
+// ================================================================
+// Function : IsActive
+// Purpose  :
+// ================================================================
+bool WasmProgressIndicator::IsActive() { return THE_NB_ACTIVE > 0; }
+
+// ================================================================
+// Function : ClearCancel
+// Purpose  :
+// ================================================================
+void WasmProgressIndicator::ClearCancel() {
+  if (THE_NB_ACTIVE == 0) {
+    THE_TO_CANCEL = false;
+  }
+}
+
+// ================================================================
+// Function : WasmProgressIndicator
+// Purpose  :
+// ================================================================
+WasmProgressIndicator::WasmProgressIndicator(
+    const TCollection_AsciiString& theName, double theInterval)
+    : myName(theName),
+      myInterval(theInterval),
+      myLastShowTime(0.0),
+      myIsCancelled(false) {
+  ++THE_NB_ACTIVE;
+}
+
+// ================================================================
+// Function : ~WasmProgressIndicator
+// Purpose  :
+// ================================================================
+WasmProgressIndicator::~WasmProgressIndicator() {
+  if (--THE_NB_ACTIVE == 0) {
+    THE_TO_CANCEL = false;
+  }
+}
+
+// ================================================================
+// Function : UserBreak
+// Purpose  :
+// ================================================================
+Standard_Boolean WasmProgressIndicator::UserBreak() {
+  return myIsCancelled || THE_TO_CANCEL;
+}
+
+// ================================================================
+// Function : Show
+// Purpose  :
+// ================================================================
+void WasmProgressIndicator::Show(const Message_ProgressScope& theScope,
+                                 const Standard_Boolean isForce) {
+  // JS callback is defined only within main thread
+  if (!emscripten_is_main_runtime_thread()) {
+    return;
+  }
+
+  // forced updates are issued on every nested scope (e.g. per face while
+  // meshing), so only a change of the named stage bypasses the rate limit;
+  // the stage name is copied as the scope may own and free its name
+  const char* aStage = theScope.Name() != nullptr ? theScope.Name() : "";
+  const bool isNewStage = isForce && !myLastStage.IsEqual(aStage);
+  const double aTime = emscripten_get_now();
+  if (!isNewStage && aTime - myLastShowTime < myInterval) {
+    return;
+  }
+
+  myLastStage = aStage;
+  myLastShowTime = aTime;
+  if (jsReportLoadProgress(myName.ToCString(), aStage, GetPosition()) != 0) {
+    myIsCancelled = true;
+  }
+}
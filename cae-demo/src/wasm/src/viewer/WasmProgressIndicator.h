@@ -0,0 +1,56 @@
+#ifndef _WasmProgressIndicator_HeaderFile
+#define _WasmProgressIndicator_HeaderFile
+
+#include <Message_ProgressIndicator.hxx>
+#include <TCollection_AsciiString.hxx>
+
+//! Progress indicator reporting model loading progress to optional JS callback
+//! Module.onLoadProgress(name, stage, fraction) at a bounded rate.
+//!
+//! Loading is cancelled cooperatively: readers, transfer and meshing poll
+//! UserBreak() and stop at the next check. Cancellation is requested either
+//! by returning TRUE from the JS callback, or by RequestCancel(). Browser
+//! events are not dispatched while loading blocks the main thread, so
+//! RequestCancel() called from an event handler cannot interrupt a running
+//! load; it is kept pending instead and cancels the load started next. The
+//! request is cleared when the last active indicator is destroyed, i.e. when
+//! loading finishes or is cancelled, or by ClearCancel().
+class WasmProgressIndicator : public Message_ProgressIndicator {
+  DEFINE_STANDARD_RTTI_INLINE(WasmProgressIndicator, Message_ProgressIndicator)
+ public:
+  //! Request cancellation of the active or the next started loading.
+  static void RequestCancel();
+
+  //! Return TRUE if some loading is in progress.
+  static bool IsActive();
+
+  //! Clear pending cancellation request, unless some loading is in progress.
+  static void ClearCancel();
+
+ public:
+  //! Main constructor.
+  //! @param theName     [in] name of the loaded object
+  //! @param theInterval [in] minimal interval between reports in milliseconds
+  WasmProgressIndicator(const TCollection_AsciiString& theName,
+                        double theInterval = 100.0);
+
+  //! Destructor; clears cancellation request after the last active loading.
+  virtual ~WasmProgressIndicator();
+
+  //! Return TRUE if cancellation has been requested.
+  virtual Standard_Boolean UserBreak() override;
+
+ protected:
+  //! Report progress to JS.
+  virtual void Show(const Message_ProgressScope& theScope,
+                    const Standard_Boolean isForce) override;
+
+ private:
+  TCollection_AsciiString myName;       //!< name of the loaded object
+  TCollection_AsciiString myLastStage;  //!< name of the last reported stage
+  double myInterval;                    //!< minimal interval between reports
+  double myLastShowTime;                //!< time of the last report
+  bool myIsCancelled;                   //!< cancelled by JS callback
+};
+
+#endif  // _WasmProgressIndicator_HeaderFile
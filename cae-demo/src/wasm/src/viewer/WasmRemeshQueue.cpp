@@ -0,0 +1,143 @@
+#include "WasmRemeshQueue.h"
+
+#include <NCollection_Map.hxx>
+#include <emscripten.h>
+
+#include <algorithm>
+
+// ================================================================
+// Function : MeshObject
+// Purpose  :
+// ================================================================
+bool WasmRemeshQueue::MeshObject(const Handle(AIS_Shape) & theObject,
+                                 const Message_ProgressRange& theProgress) {
+  ModelMeshStats aStats;
+  return ModelMesher::MeshShape(theObject->Shape(), theObject->Attributes(),
+                                aStats, theProgress);
+}
+
+// ================================================================
+// Function : WasmRemeshQueue
+// Purpose  :
+// ================================================================
+WasmRemeshQueue::WasmRemeshQueue(double theBudget)
+    : myBudget(theBudget), myIsScheduled(false) {}
+
+// ================================================================
+// Function : Add
+// Purpose  :
+// ================================================================
+void WasmRemeshQueue::Add(const Handle(WasmOcctModel) & theModel,
+                          const Handle(AIS_Shape) & theObject,
+                          bool theToRemeshAll) {
+  Job aJob;
+  aJob.Model = theModel;
+  aJob.Object = theObject;
+  aJob.ToRemeshAll = theToRemeshAll;
+  for (auto aJobIter = myJobs.begin(); aJobIter != myJobs.end(); ++aJobIter) {
+    if (aJobIter->Object == theObject) {
+      // faces not yet remeshed by interrupted job may still need remeshing
+      aJob.ToRemeshAll = aJob.ToRemeshAll || aJobIter->ToRemeshAll;
+      // faces already replaced by it are counted as remeshed, so that the
+      // presentation is recomputed even if the new job reuses all faces
+      aJob.Stats.NbFaces = aJobIter->Stats.NbFaces - aJobIter->Stats.NbReused;
+      myJobs.erase(aJobIter);
+      break;
+    }
+  }
+
+  ModelMesher::SplitShape(theObject->Shape(), aJob.Chunks);
+  myJobs.push_back(aJob);
+  schedule();
+}
+
+// ================================================================
+// Function : Remove
+// Purpose  :
+// ================================================================
+void WasmRemeshQueue::Remove(const Handle(WasmOcctModel) & theModel) {
+  myJobs.erase(std::remove_if(myJobs.begin(), myJobs.end(),
+                              [&theModel](const Job& theJob) {
+                                return theJob.Model == theModel;
+                              }),
+               myJobs.end());
+}
+
+// ================================================================
+// Function : Move
+// Purpose  :
+// ================================================================
+void WasmRemeshQueue::Move(const Handle(WasmOcctModel) & theFrom,
+                           const Handle(WasmOcctModel) & theTo) {
+  NCollection_Map<Handle(Standard_Transient)> anObjects;
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator anObjIter(
+           theTo->Objects);
+       anObjIter.More(); anObjIter.Next()) {
+    anObjects.Add(anObjIter.Value());
+  }
+  for (auto aJobIter = myJobs.begin(); aJobIter != myJobs.end();) {
+    if (aJobIter->Model != theFrom) {
+      ++aJobIter;
+    } else if (anObjects.Contains(aJobIter->Object)) {
+      aJobIter->Model = theTo;
+      ++aJobIter;
+    } else {
+      aJobIter = myJobs.erase(aJobIter);
+    }
+  }
+}
+
+// ================================================================
+// Function : HasJobs
+// Purpose  :
+// ================================================================
+bool WasmRemeshQueue::HasJobs(const Handle(WasmOcctModel) & theModel) const {
+  return std::any_of(
+      myJobs.begin(), myJobs.end(),
+      [&theModel](const Job& theJob) { return theJob.Model == theModel; });
+}
+
+// ================================================================
+// Function : schedule
+// Purpose  :
+// ================================================================
+void WasmRemeshQueue::schedule() {
+  if (!myIsScheduled && !myJobs.empty()) {
+    myIsScheduled = true;
+    emscripten_async_call(onTimer, this, 0);
+  }
+}
+
+// ================================================================
+// Function : onTimer
+// Purpose  :
+// ================================================================
+void WasmRemeshQueue::onTimer(void* theQueue) {
+  static_cast<WasmRemeshQueue*>(theQueue)->processJobs();
+}
+
+// ================================================================
+// Function : processJobs
+// Purpose  :
+// ================================================================
+void WasmRemeshQueue::processJobs() {
+  myIsScheduled = false;
+  const double aStartTime = emscripten_get_now();
+  while (!myJobs.empty() && emscripten_get_now() - aStartTime < myBudget) {
+    Job& aJob = myJobs.front();
+    if (aJob.NextChunk <= aJob.Chunks.Size()) {
+      ModelMesher::MeshChunk(aJob.Chunks.Value(aJob.NextChunk++),
+                             aJob.Object->Attributes(),
+                             THE_MIN_DEFLECTION_RATIO, aJob.ToRemeshAll,
+                             aJob.Stats);
+      continue;
+    }
+
+    const Job aDoneJob = aJob;
+    myJobs.pop_front();
+    if (myCallback) {
+      myCallback(aDoneJob.Model, aDoneJob.Object, aDoneJob.Stats);
+    }
+  }
+  schedule();
+}
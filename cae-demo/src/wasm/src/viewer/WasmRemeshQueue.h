@@ -0,0 +1,103 @@
+#ifndef _WasmRemeshQueue_HeaderFile
+#define _WasmRemeshQueue_HeaderFile
+
+#include <AIS_Shape.hxx>
+#include <Message_ProgressRange.hxx>
+#include <NCollection_Sequence.hxx>
+
+#include <deque>
+#include <functional>
+
+#include "ModelMesher.h"
+#include "WasmOcctModel.h"
+
+//! Queue of asynchronous remeshing jobs.
+//!
+//! Shapes are meshed by chunks (see ModelMesher) within a time budget per
+//! browser task, so that the page stays responsive while the model is
+//! remeshed. Presentations are not recomputed until all chunks of the object
+//! are meshed, so the old mesh stays visible in the meantime.
+//!
+//! Remeshing is incremental: faces which triangulation already fits the new
+//! linear deflection (not coarser, and not much finer) are kept, and only
+//! the other faces are meshed again, conformally to the kept ones.
+//! Angular deflection is not stored within triangulation, so changing it
+//! remeshes all faces of the object.
+class WasmRemeshQueue {
+ public:
+  //! Callback called when all chunks of the object have been meshed.
+  typedef std::function<void(const Handle(WasmOcctModel)&,
+                             const Handle(AIS_Shape)&, const ModelMeshStats&)>
+      ObjectCallback;
+
+  //! Faces meshed finer than this fraction of the requested deflection
+  //! are remeshed to reduce the number of triangles.
+  static constexpr double THE_MIN_DEFLECTION_RATIO = 0.5;
+
+  //! Mesh the object synchronously, keeping any existing triangulation
+  //! which is fine enough.
+  //! @param theObject   [in] object to mesh
+  //! @param theProgress [in] progress range
+  //! @return FALSE if meshing has been cancelled
+  static bool MeshObject(const Handle(AIS_Shape) & theObject,
+                         const Message_ProgressRange& theProgress);
+
+ public:
+  //! Main constructor.
+  //! @param theBudget [in] time budget per browser task in milliseconds
+  WasmRemeshQueue(double theBudget = 20.0);
+
+  //! Set callback called when object has been remeshed.
+  void SetObjectCallback(const ObjectCallback& theCallback) {
+    myCallback = theCallback;
+  }
+
+  //! Queue remeshing of the object; pending job of the same object restarts.
+  //! @param theModel       [in] model of the object
+  //! @param theObject      [in] object to remesh
+  //! @param theToRemeshAll [in] remesh all faces, e.g. on angular deflection
+  //!                            change
+  void Add(const Handle(WasmOcctModel) & theModel,
+           const Handle(AIS_Shape) & theObject, bool theToRemeshAll);
+
+  //! Drop pending jobs of the model (e.g. on removal).
+  void Remove(const Handle(WasmOcctModel) & theModel);
+
+  //! Move pending jobs of the model to its new revision: jobs of objects
+  //! reused by the new revision continue where they stopped, with the same
+  //! options, and jobs of other objects are dropped.
+  void Move(const Handle(WasmOcctModel) & theFrom,
+            const Handle(WasmOcctModel) & theTo);
+
+  //! Return TRUE if the model has pending jobs.
+  bool HasJobs(const Handle(WasmOcctModel) & theModel) const;
+
+ private:
+  //! Timer callback.
+  static void onTimer(void* theQueue);
+
+  //! Schedule processing of jobs within the next browser task.
+  void schedule();
+
+  //! Process jobs within the time budget.
+  void processJobs();
+
+ private:
+  //! Remeshing job of a single object.
+  struct Job {
+    Handle(WasmOcctModel) Model;
+    Handle(AIS_Shape) Object;
+    NCollection_Sequence<TopoDS_Shape> Chunks;
+    int NextChunk = 1;
+    bool ToRemeshAll = false;
+    ModelMeshStats Stats;
+  };
+
+ private:
+  std::deque<Job> myJobs;   //!< pending jobs
+  ObjectCallback myCallback;  //!< callback on remeshed object
+  double myBudget;          //!< time budget per task in milliseconds
+  bool myIsScheduled;       //!< processing has been scheduled
+};
+
+#endif  // _WasmRemeshQueue_HeaderFile
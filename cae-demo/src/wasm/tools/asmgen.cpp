@@ -0,0 +1,243 @@
+// Generator of synthetic assemblies for loader scaling tests.
+//
+// Usage: asmgen [-parts N] [-faces N] [-instancing R] [-depth N] [-binary]
+//               output1.step [output2.brep ...]
+//
+//   -parts      number of unique parts (default 100)
+//   -faces      number of faces per part, at least 5 (default 12)
+//   -instancing average number of instances per unique part (default 1)
+//   -depth      assembly nesting depth, 1 for a flat assembly (default 2)
+//   -binary     write BRep outputs in binary format
+//
+// Parts are prisms over regular polygons, so that face count is exact.
+// Every part gets a name and a color, every assembly level a name, so the
+// generated STEP files exercise the same XCAF attributes as customer models.
+// Output format is chosen by extension: .step/.stp or .brep.
+// Statistics are printed as a single JSON object.
+
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepBuilderAPI_MakePolygon.hxx>
+#include <BRepPrimAPI_MakePrism.hxx>
+#include <BRepTools.hxx>
+#include <BinTools.hxx>
+#include <Quantity_Color.hxx>
+#include <STEPCAFControl_Writer.hxx>
+#include <TDataStd_Name.hxx>
+#include <TDocStd_Document.hxx>
+#include <XCAFApp_Application.hxx>
+#include <XCAFDoc_ColorTool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+//! Generator parameters.
+struct GenParams {
+  int NbParts = 100;
+  int NbFaces = 12;
+  double Instancing = 1.0;
+  int Depth = 2;
+  bool ToWriteBinary = false;
+  std::vector<std::string> Outputs;
+};
+
+//! Synthetic assembly builder.
+class AssemblyGenerator {
+ public:
+  AssemblyGenerator(const GenParams& theParams)
+      : myParams(theParams), myNbInstances(0), myNbAssemblies(0) {
+    XCAFApp_Application::GetApplication()->NewDocument("MDTV-XCAF", myDoc);
+    myShapeTool = XCAFDoc_DocumentTool::ShapeTool(myDoc->Main());
+    myColorTool = XCAFDoc_DocumentTool::ColorTool(myDoc->Main());
+  }
+
+  ~AssemblyGenerator() { XCAFApp_Application::GetApplication()->Close(myDoc); }
+
+  //! Build parts and assembly structure.
+  void Perform() {
+    for (int aPartIter = 0; aPartIter < myParams.NbParts; ++aPartIter) {
+      const TDF_Label aLabel =
+          myShapeTool->AddShape(makePart(aPartIter), false);
+      TDataStd_Name::Set(aLabel, TCollection_ExtendedString("Part_") +
+                                     TCollection_ExtendedString(aPartIter));
+      // colors are spread over hue circle
+      const Quantity_Color aColor(
+          360.0 * aPartIter / myParams.NbParts, 0.6, 0.8, Quantity_TOC_HLS);
+      myColorTool->SetColor(aLabel, aColor, XCAFDoc_ColorSurf);
+      myParts.push_back(aLabel);
+    }
+
+    const int aNbLeaves =
+        std::max(myParams.NbParts,
+                 int(std::lround(myParams.NbParts * myParams.Instancing)));
+    // branching factor giving requested number of leaves at requested depth
+    myBranching = std::max(
+        2, int(std::ceil(std::pow(double(aNbLeaves), 1.0 / myParams.Depth))));
+    myGridSize = std::max(1, int(std::ceil(std::cbrt(double(aNbLeaves)))));
+    myRoot = makeAssembly(1, 0, aNbLeaves, "Root");
+    myShapeTool->UpdateAssemblies();
+  }
+
+  //! Write document into STEP file.
+  bool WriteStep(const std::string& thePath) {
+    STEPCAFControl_Writer aWriter;
+    aWriter.SetColorMode(true);
+    aWriter.SetNameMode(true);
+    return aWriter.Transfer(myDoc, STEPControl_AsIs) &&
+           aWriter.Write(thePath.c_str()) == IFSelect_RetDone;
+  }
+
+  //! Write assembly shape into BRep file; instances share part geometry.
+  bool WriteBRep(const std::string& thePath) {
+    const TopoDS_Shape aShape = myShapeTool->GetShape(myRoot);
+    return myParams.ToWriteBinary
+               ? BinTools::Write(aShape, thePath.c_str())
+               : BRepTools::Write(aShape, thePath.c_str());
+  }
+
+  //! Return number of part instances.
+  int NbInstances() const { return myNbInstances; }
+
+  //! Return number of assemblies, including root.
+  int NbAssemblies() const { return myNbAssemblies; }
+
+ private:
+  //! Create prism over regular polygon with (NbFaces - 2) sides.
+  TopoDS_Shape makePart(int theIndex) const {
+    const int aNbSides = std::max(3, myParams.NbFaces - 2);
+    const double aRadius = 0.5 + 0.3 * (theIndex % 7) / 7.0;
+    const double aHeight = 0.5 + 0.1 * (theIndex % 5);
+    BRepBuilderAPI_MakePolygon aPolygon;
+    for (int aSideIter = 0; aSideIter < aNbSides; ++aSideIter) {
+      const double anAngle = 2.0 * M_PI * aSideIter / aNbSides;
+      aPolygon.Add(gp_Pnt(aRadius * std::cos(anAngle),
+                          aRadius * std::sin(anAngle), 0.0));
+    }
+    aPolygon.Close();
+    BRepBuilderAPI_MakeFace aFace(aPolygon.Wire(), true);
+    return BRepPrimAPI_MakePrism(aFace.Face(), gp_Vec(0.0, 0.0, aHeight))
+        .Shape();
+  }
+
+  //! Create assembly of specified level holding leaves
+  //! [theFirstLeaf, theFirstLeaf + theNbLeaves).
+  TDF_Label makeAssembly(int theLevel, int theFirstLeaf, int theNbLeaves,
+                         const TCollection_AsciiString& theName) {
+    const TDF_Label anAssembly = myShapeTool->NewShape();
+    TDataStd_Name::Set(anAssembly, TCollection_ExtendedString(theName));
+    ++myNbAssemblies;
+    if (theLevel >= myParams.Depth || theNbLeaves <= 1) {
+      for (int aLeafIter = theFirstLeaf;
+           aLeafIter < theFirstLeaf + theNbLeaves; ++aLeafIter) {
+        // leaves are placed on a grid in global coordinates
+        const int aGridX = aLeafIter % myGridSize;
+        const int aGridY = aLeafIter / myGridSize % myGridSize;
+        const int aGridZ = aLeafIter / myGridSize / myGridSize;
+        gp_Trsf aTrsf;
+        aTrsf.SetTranslation(gp_Vec(2.0 * aGridX, 2.0 * aGridY, 2.0 * aGridZ));
+        myShapeTool->AddComponent(anAssembly,
+                                  myParts[aLeafIter % myParts.size()],
+                                  TopLoc_Location(aTrsf));
+        ++myNbInstances;
+      }
+      return anAssembly;
+    }
+
+    const int aNbChildren = std::min(myBranching, theNbLeaves);
+    int aFirstLeaf = theFirstLeaf;
+    for (int aChildIter = 0; aChildIter < aNbChildren; ++aChildIter) {
+      const int aNbChildLeaves =
+          theNbLeaves / aNbChildren + (aChildIter < theNbLeaves % aNbChildren);
+      const TDF_Label aChild =
+          makeAssembly(theLevel + 1, aFirstLeaf, aNbChildLeaves,
+                       theName + "_" + TCollection_AsciiString(aChildIter));
+      myShapeTool->AddComponent(anAssembly, aChild, TopLoc_Location());
+      aFirstLeaf += aNbChildLeaves;
+    }
+    return anAssembly;
+  }
+
+ private:
+  GenParams myParams;
+  Handle(TDocStd_Document) myDoc;
+  Handle(XCAFDoc_ShapeTool) myShapeTool;
+  Handle(XCAFDoc_ColorTool) myColorTool;
+  std::vector<TDF_Label> myParts;
+  TDF_Label myRoot;
+  int myBranching = 2;
+  int myGridSize = 1;
+  int myNbInstances;
+  int myNbAssemblies;
+};
+}  // namespace
+
+int main(int theNbArgs, char** theArgVec) {
+  GenParams aParams;
+  for (int anArgIter = 1; anArgIter < theNbArgs; ++anArgIter) {
+    const char* anArg = theArgVec[anArgIter];
+    const bool hasValue = anArgIter + 1 < theNbArgs;
+    if (::strcmp(anArg, "-parts") == 0 && hasValue) {
+      aParams.NbParts = std::max(1, std::atoi(theArgVec[++anArgIter]));
+    } else if (::strcmp(anArg, "-faces") == 0 && hasValue) {
+      aParams.NbFaces = std::max(5, std::atoi(theArgVec[++anArgIter]));
+    } else if (::strcmp(anArg, "-instancing") == 0 && hasValue) {
+      aParams.Instancing = std::max(1.0, std::atof(theArgVec[++anArgIter]));
+    } else if (::strcmp(anArg, "-depth") == 0 && hasValue) {
+      aParams.Depth = std::max(1, std::atoi(theArgVec[++anArgIter]));
+    } else if (::strcmp(anArg, "-binary") == 0) {
+      aParams.ToWriteBinary = true;
+    } else if (anArg[0] != '-') {
+      aParams.Outputs.push_back(anArg);
+    } else {
+      std::cerr << "Error: unknown argument '" << anArg << "'\n";
+      return 1;
+    }
+  }
+  if (aParams.Outputs.empty()) {
+    std::cerr << "Usage: " << theArgVec[0]
+              << " [-parts N] [-faces N] [-instancing R] [-depth N]"
+                 " [-binary] output1.step [output2.brep ...]\n";
+    return 1;
+  }
+
+  AssemblyGenerator aGenerator(aParams);
+  aGenerator.Perform();
+
+  std::cout << "{\"parts\": " << aParams.NbParts
+            << ", \"instances\": " << aGenerator.NbInstances()
+            << ", \"assemblies\": " << aGenerator.NbAssemblies()
+            << ", \"depth\": " << aParams.Depth
+            << ", \"faces\": " << aGenerator.NbInstances() * aParams.NbFaces
+            << ", \"files\": [";
+  int aResult = 0, aNbWritten = 0;
+  for (size_t anOutIter = 0; anOutIter < aParams.Outputs.size(); ++anOutIter) {
+    const std::string& aPath = aParams.Outputs[anOutIter];
+    const std::string anExt =
+        std::filesystem::path(aPath).extension().string();
+    bool isWritten = false;
+    if (anExt == ".step" || anExt == ".stp") {
+      isWritten = aGenerator.WriteStep(aPath);
+    } else if (anExt == ".brep") {
+      isWritten = aGenerator.WriteBRep(aPath);
+    } else {
+      std::cerr << "Error: unsupported output format '" << aPath << "'\n";
+    }
+    if (!isWritten) {
+      std::cerr << "Error: unable to write file '" << aPath << "'\n";
+      aResult = 1;
+      continue;
+    }
+    std::cout << (aNbWritten++ != 0 ? ", " : "") << "{\"path\": \"" << aPath
+              << "\", \"bytes\": " << std::filesystem::file_size(aPath) << "}";
+  }
+  std::cout << "]}\n";
+  return aResult;
+}
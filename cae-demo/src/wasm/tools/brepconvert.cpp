@@ -0,0 +1,158 @@
+// Round-trip converter between ASCII (BRepTools) and binary (BinTools) BRep
+// formats, reporting file size and read time of both representations.
+//
+// Usage: brepconvert <input> <output> [-ascii|-binary] [-repeat N]
+//
+// Output format defaults to the opposite of the input format.
+
+#include <BRepBndLib.hxx>
+#include <BRepTools.hxx>
+#include <BinTools.hxx>
+#include <Bnd_Box.hxx>
+#include <OSD_Timer.hxx>
+#include <Precision.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "ModelFormat.h"
+#include "ModelReader.h"
+
+namespace {
+//! Read BRep shape from memory the same way as the viewer does.
+bool readShape(const std::string& theName, const std::string& theData,
+               TopoDS_Shape& theShape, ModelFormat& theFormat) {
+  theFormat = ModelFormatTool::Detect(theName, theData.data(), theData.size());
+  return ModelReader::ReadBRep(theName, theData.data(), theData.size(),
+                               theShape);
+}
+
+//! Measure average read time in milliseconds.
+double measureRead(const std::string& theName, const std::string& theData,
+                   int theNbRepeats) {
+  OSD_Timer aTimer;
+  aTimer.Start();
+  for (int aRepeatIter = 0; aRepeatIter < theNbRepeats; ++aRepeatIter) {
+    TopoDS_Shape aShape;
+    ModelFormat aFormat = ModelFormat_Unknown;
+    readShape(theName, theData, aShape, aFormat);
+  }
+  aTimer.Stop();
+  return aTimer.ElapsedTime() * 1000.0 / theNbRepeats;
+}
+
+//! Return number of sub-shapes of specified type.
+int nbSubShapes(const TopoDS_Shape& theShape, TopAbs_ShapeEnum theType) {
+  TopTools_IndexedMapOfShape aMap;
+  TopExp::MapShapes(theShape, theType, aMap);
+  return aMap.Extent();
+}
+
+//! Check that shapes have the same topology and bounding box.
+bool isSameShape(const TopoDS_Shape& theShape1, const TopoDS_Shape& theShape2) {
+  for (TopAbs_ShapeEnum aType : {TopAbs_SOLID, TopAbs_FACE, TopAbs_EDGE,
+                                 TopAbs_VERTEX}) {
+    if (nbSubShapes(theShape1, aType) != nbSubShapes(theShape2, aType)) {
+      return false;
+    }
+  }
+
+  Bnd_Box aBox1, aBox2;
+  BRepBndLib::Add(theShape1, aBox1, false);
+  BRepBndLib::Add(theShape2, aBox2, false);
+  if (aBox1.IsVoid() || aBox2.IsVoid()) {
+    return aBox1.IsVoid() == aBox2.IsVoid();
+  }
+  return aBox1.CornerMin().IsEqual(aBox2.CornerMin(), Precision::Confusion()) &&
+         aBox1.CornerMax().IsEqual(aBox2.CornerMax(), Precision::Confusion());
+}
+
+//! Return format name.
+const char* formatName(ModelFormat theFormat) {
+  return theFormat == ModelFormat_BinBRep ? "binary" : "ascii";
+}
+}  // namespace
+
+int main(int theNbArgs, char** theArgVec) {
+  if (theNbArgs < 3) {
+    std::cerr << "Usage: " << theArgVec[0]
+              << " <input> <output> [-ascii|-binary] [-repeat N]\n";
+    return 1;
+  }
+
+  const std::string anInPath = theArgVec[1];
+  const std::string anOutPath = theArgVec[2];
+  ModelFormat anOutFormat = ModelFormat_Unknown;
+  int aNbRepeats = 3;
+  for (int anArgIter = 3; anArgIter < theNbArgs; ++anArgIter) {
+    if (::strcmp(theArgVec[anArgIter], "-ascii") == 0) {
+      anOutFormat = ModelFormat_BRep;
+    } else if (::strcmp(theArgVec[anArgIter], "-binary") == 0) {
+      anOutFormat = ModelFormat_BinBRep;
+    } else if (::strcmp(theArgVec[anArgIter], "-repeat") == 0 &&
+               anArgIter + 1 < theNbArgs) {
+      aNbRepeats = std::max(1, std::atoi(theArgVec[++anArgIter]));
+    } else {
+      std::cerr << "Error: unknown argument '" << theArgVec[anArgIter] << "'\n";
+      return 1;
+    }
+  }
+
+  std::string anInData;
+  TopoDS_Shape anInShape;
+  ModelFormat anInFormat = ModelFormat_Unknown;
+  if (!ModelReader::ReadFile(anInPath, anInData) ||
+      !readShape(anInPath, anInData, anInShape, anInFormat)) {
+    std::cerr << "Error: unable to read BRep file '" << anInPath << "'\n";
+    return 1;
+  }
+  if (anOutFormat == ModelFormat_Unknown) {
+    anOutFormat = anInFormat == ModelFormat_BinBRep ? ModelFormat_BRep
+                                                    : ModelFormat_BinBRep;
+  }
+
+  {
+    std::ofstream anOutFile(anOutPath, std::ios::binary);
+    if (anOutFormat == ModelFormat_BinBRep) {
+      BinTools::Write(anInShape, anOutFile, true, false,
+                      BinTools_FormatVersion_CURRENT);
+    } else {
+      BRepTools::Write(anInShape, anOutFile, true, false,
+                       TopTools_FormatVersion_CURRENT);
+    }
+    if (!anOutFile) {
+      std::cerr << "Error: unable to write file '" << anOutPath << "'\n";
+      return 1;
+    }
+  }
+
+  std::string anOutData;
+  TopoDS_Shape anOutShape;
+  ModelFormat aReadFormat = ModelFormat_Unknown;
+  if (!ModelReader::ReadFile(anOutPath, anOutData) ||
+      !readShape(anOutPath, anOutData, anOutShape, aReadFormat) ||
+      aReadFormat != anOutFormat) {
+    std::cerr << "Error: unable to read back file '" << anOutPath << "'\n";
+    return 1;
+  }
+  const bool isSame = isSameShape(anInShape, anOutShape);
+
+  const double anInTime = measureRead(anInPath, anInData, aNbRepeats);
+  const double anOutTime = measureRead(anOutPath, anOutData, aNbRepeats);
+  std::cout << "format\tsize (bytes)\tread (ms)\tfile\n"
+            << formatName(anInFormat) << "\t" << anInData.size() << "\t"
+            << anInTime << "\t" << anInPath << "\n"
+            << formatName(anOutFormat) << "\t" << anOutData.size() << "\t"
+            << anOutTime << "\t" << anOutPath << "\n"
+            << "size ratio: " << double(anOutData.size()) / anInData.size()
+            << ", read time ratio: " << anOutTime / anInTime << "\n"
+            << "round trip: " << (isSame ? "OK" : "MISMATCH") << "\n";
+  return isSame ? 0 : 2;
+}
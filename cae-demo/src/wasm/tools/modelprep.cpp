@@ -0,0 +1,403 @@
+// Batch preparation of models for the viewer on the server side. Reads
+// STEP, IGES or BRep files (optionally compressed) with the same readers
+// as the viewer, meshes them with the viewer meshing parameters and writes
+// viewer-ready output, so that browsers never run import and meshing:
+//  - meshed binary BRep (.brep), displayed by the viewer without remeshing;
+//  - pre-tessellated glTF package (.glb or .gltf) keeping assembly
+//    hierarchy, names and colors.
+//
+// Usage: modelprep [-jobs N] [-format brep|glb|gltf] [-deflection D]
+//                  [-angle DEG] [-absolute] [-outdir DIR] input1 [input2 ...]
+//
+//   -jobs       number of worker threads (default hardware concurrency)
+//   -format     output format (default glb)
+//   -deflection deviation coefficient, or chordal deviation with -absolute
+//   -angle      angular deflection in degrees
+//   -outdir     output directory (default current directory)
+//
+// Files are distributed over a pool of worker threads; solids of every file
+// are meshed in parallel by BRepMesh using the OCCT thread pool, which
+// falls back to the calling thread when all pool threads are busy.
+// Output file names are input names without extensions. Statistics are
+// printed as a single JSON object, including throughput in files per hour
+// of wall time and per hour of process CPU time.
+
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <BinTools.hxx>
+#include <IGESControl_Controller.hxx>
+#include <OSD_Chronometer.hxx>
+#include <OSD_Timer.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Prs3d_Drawer.hxx>
+#include <RWGltf_CafWriter.hxx>
+#include <STEPCAFControl_Controller.hxx>
+#include <Standard_Failure.hxx>
+#include <TColStd_IndexedDataMapOfStringString.hxx>
+#include <TDataStd_Name.hxx>
+#include <TDocStd_Document.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <XCAFApp_Application.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DecompressStreamBuffer.h"
+#include "ModelFormat.h"
+#include "ModelMesher.h"
+#include "ModelReader.h"
+
+namespace {
+//! Output format.
+enum OutputFormat {
+  OutputFormat_BRep,  //!< meshed binary BRep
+  OutputFormat_Glb,   //!< binary glTF
+  OutputFormat_Gltf,  //!< glTF with external buffers
+};
+
+//! Batch parameters.
+struct PrepParams {
+  std::vector<std::string> Inputs;
+  std::filesystem::path OutDir = ".";
+  OutputFormat Format = OutputFormat_Glb;
+  int NbJobs = 1;
+  Handle(Prs3d_Drawer) Drawer = new Prs3d_Drawer();
+};
+
+//! Result of single file preparation.
+struct PrepResult {
+  std::string Output;
+  std::string Error;  //!< empty on success
+  int NbFaces = 0;
+  int NbTriangles = 0;
+  double ReadTime = 0.0;   //!< seconds
+  double MeshTime = 0.0;   //!< seconds
+  double WriteTime = 0.0;  //!< seconds
+};
+
+//! XCAF application keeps the list of open documents,
+//! so documents are created and closed one at a time.
+std::mutex THE_APP_MUTEX;
+
+//! XCAF document closed on destruction.
+class ScopedDocument {
+ public:
+  ScopedDocument() {
+    std::lock_guard<std::mutex> aLock(THE_APP_MUTEX);
+    XCAFApp_Application::GetApplication()->NewDocument("MDTV-XCAF", myDoc);
+  }
+
+  ~ScopedDocument() {
+    std::lock_guard<std::mutex> aLock(THE_APP_MUTEX);
+    XCAFApp_Application::GetApplication()->Close(myDoc);
+  }
+
+  const Handle(TDocStd_Document) & Document() const { return myDoc; }
+
+ private:
+  ScopedDocument(const ScopedDocument&) = delete;
+  ScopedDocument& operator=(const ScopedDocument&) = delete;
+
+ private:
+  Handle(TDocStd_Document) myDoc;
+};
+
+//! Return elapsed time in seconds and restart the timer.
+double lapTime(OSD_Timer& theTimer) {
+  theTimer.Stop();
+  const double anElapsed = theTimer.ElapsedTime();
+  theTimer.Reset();
+  theTimer.Start();
+  return anElapsed;
+}
+
+//! Return output file extension.
+const char* formatExtension(OutputFormat theFormat) {
+  switch (theFormat) {
+    case OutputFormat_BRep:
+      return ".brep";
+    case OutputFormat_Glb:
+      return ".glb";
+    case OutputFormat_Gltf:
+      return ".gltf";
+  }
+  return "";
+}
+
+//! Return output path of the input file: output directory, name of the input
+//! without compression and format extensions, and extension of the format.
+std::filesystem::path outputPath(const std::string& theInput,
+                                 const PrepParams& theParams) {
+  const std::filesystem::path aPlainName =
+      DecompressStreamBuffer::StripCodecExtension(theInput);
+  return theParams.OutDir /
+         (aPlainName.stem().string() + formatExtension(theParams.Format));
+}
+
+//! Return string quoted for JSON.
+std::string jsonString(const std::string& theString) {
+  std::string aResult = "\"";
+  for (char aChar : theString) {
+    if (aChar == '"' || aChar == '\\') {
+      aResult += '\\';
+    }
+    aResult += (unsigned char)aChar < 0x20 ? ' ' : aChar;
+  }
+  return aResult + "\"";
+}
+
+//! Count faces and triangles of the shape; shared faces are counted once.
+void countTriangles(const TopoDS_Shape& theShape, PrepResult& theResult) {
+  TopTools_IndexedMapOfShape aFaces;
+  TopExp::MapShapes(theShape, TopAbs_FACE, aFaces);
+  theResult.NbFaces = aFaces.Extent();
+  for (int aFaceIter = 1; aFaceIter <= aFaces.Extent(); ++aFaceIter) {
+    TopLoc_Location aLoc;
+    const Handle(Poly_Triangulation)& aTris =
+        BRep_Tool::Triangulation(TopoDS::Face(aFaces.FindKey(aFaceIter)), aLoc);
+    if (!aTris.IsNull()) {
+      theResult.NbTriangles += aTris->NbTriangles();
+    }
+  }
+}
+
+//! Read, mesh and write a single file.
+void prepareFile(const std::string& theInput, const PrepParams& theParams,
+                 PrepResult& theResult) {
+  OSD_Timer aTimer;
+  aTimer.Start();
+  const std::filesystem::path aPlainName =
+      DecompressStreamBuffer::StripCodecExtension(theInput);
+  const std::filesystem::path anOutPath = outputPath(theInput, theParams);
+  theResult.Output = anOutPath.string();
+
+  ScopedDocument aDoc;
+  const Handle(XCAFDoc_ShapeTool) aShapeTool =
+      XCAFDoc_DocumentTool::ShapeTool(aDoc.Document()->Main());
+  {
+    std::string aData;
+    if (!ModelReader::ReadFile(theInput, aData)) {
+      theResult.Error = "unable to read file";
+      return;
+    }
+
+    switch (ModelFormatTool::Detect(theInput, aData.data(), aData.size())) {
+      case ModelFormat_BRep:
+      case ModelFormat_BinBRep: {
+        // BRep has no names - the shape is named after the file
+        TopoDS_Shape aShape;
+        if (!ModelReader::ReadBRep(theInput, aData.data(), aData.size(),
+                                   aShape)) {
+          theResult.Error = "unable to read BRep";
+          return;
+        }
+        const TDF_Label aLabel = aShapeTool->AddShape(aShape, false);
+        TDataStd_Name::Set(aLabel, TCollection_ExtendedString(
+                                       aPlainName.stem().string().c_str(),
+                                       true));
+        break;
+      }
+      case ModelFormat_STEP:
+      case ModelFormat_IGES:
+        if (!ModelReader::ReadXCaf(theInput, aData.data(), aData.size(),
+                                   aDoc.Document())) {
+          theResult.Error = "unable to read STEP/IGES";
+          return;
+        }
+        break;
+      case ModelFormat_VTK:
+      case ModelFormat_Nastran:
+      case ModelFormat_Abaqus:
+      case ModelFormat_Unknown:
+        theResult.Error = "unsupported format";
+        return;
+    }
+  }
+  theResult.ReadTime = lapTime(aTimer);
+
+  // shared parts are meshed once, as instances share their faces
+  TDF_LabelSequence aRoots;
+  aShapeTool->GetFreeShapes(aRoots);
+  TopoDS_Compound aCompound;
+  BRep_Builder aBuilder;
+  aBuilder.MakeCompound(aCompound);
+  ModelMeshStats aStats;
+  for (TDF_LabelSequence::Iterator aRootIter(aRoots); aRootIter.More();
+       aRootIter.Next()) {
+    const TopoDS_Shape aShape = XCAFDoc_ShapeTool::GetShape(aRootIter.Value());
+    ModelMesher::MeshShape(aShape, theParams.Drawer, aStats);
+    aBuilder.Add(aCompound, aShape);
+  }
+  countTriangles(aCompound, theResult);
+  theResult.MeshTime = lapTime(aTimer);
+
+  if (theParams.Format == OutputFormat_BRep) {
+    std::ofstream anOutFile(anOutPath, std::ios::binary);
+    BinTools::Write(aRoots.Size() == 1
+                        ? XCAFDoc_ShapeTool::GetShape(aRoots.First())
+                        : TopoDS_Shape(aCompound),
+                    anOutFile, true, false, BinTools_FormatVersion_CURRENT);
+    if (!anOutFile) {
+      theResult.Error = "unable to write file";
+    }
+  } else {
+    // glTF is Y-up in meters, while CAD models are Z-up in millimeters
+    RWGltf_CafWriter aWriter(anOutPath.string().c_str(),
+                             theParams.Format == OutputFormat_Glb);
+    aWriter.ChangeCoordinateSystemConverter().SetInputLengthUnit(0.001);
+    aWriter.ChangeCoordinateSystemConverter().SetInputCoordinateSystem(
+        RWMesh_CoordinateSystem_Zup);
+    if (!aWriter.Perform(aDoc.Document(),
+                         TColStd_IndexedDataMapOfStringString(),
+                         Message_ProgressRange())) {
+      theResult.Error = "unable to write file";
+    }
+  }
+  theResult.WriteTime = lapTime(aTimer);
+}
+}  // namespace
+
+int main(int theNbArgs, char** theArgVec) {
+  PrepParams aParams;
+  aParams.NbJobs = std::max(1, int(std::thread::hardware_concurrency()));
+  for (int anArgIter = 1; anArgIter < theNbArgs; ++anArgIter) {
+    const char* anArg = theArgVec[anArgIter];
+    const bool hasValue = anArgIter + 1 < theNbArgs;
+    if (::strcmp(anArg, "-jobs") == 0 && hasValue) {
+      aParams.NbJobs = std::max(1, std::atoi(theArgVec[++anArgIter]));
+    } else if (::strcmp(anArg, "-format") == 0 && hasValue) {
+      const std::string aFormat = theArgVec[++anArgIter];
+      if (aFormat == "brep") {
+        aParams.Format = OutputFormat_BRep;
+      } else if (aFormat == "glb") {
+        aParams.Format = OutputFormat_Glb;
+      } else if (aFormat == "gltf") {
+        aParams.Format = OutputFormat_Gltf;
+      } else {
+        std::cerr << "Error: unknown format '" << aFormat << "'\n";
+        return 1;
+      }
+    } else if (::strcmp(anArg, "-deflection") == 0 && hasValue) {
+      const double aDeflection = std::atof(theArgVec[++anArgIter]);
+      aParams.Drawer->SetDeviationCoefficient(aDeflection);
+      aParams.Drawer->SetMaximalChordialDeviation(aDeflection);
+    } else if (::strcmp(anArg, "-angle") == 0 && hasValue) {
+      aParams.Drawer->SetDeviationAngle(std::atof(theArgVec[++anArgIter]) *
+                                        M_PI / 180.0);
+    } else if (::strcmp(anArg, "-absolute") == 0) {
+      aParams.Drawer->SetTypeOfDeflection(Aspect_TOD_ABSOLUTE);
+    } else if (::strcmp(anArg, "-outdir") == 0 && hasValue) {
+      aParams.OutDir = theArgVec[++anArgIter];
+    } else if (anArg[0] != '-') {
+      aParams.Inputs.push_back(anArg);
+    } else {
+      std::cerr << "Error: unknown argument '" << anArg << "'\n";
+      return 1;
+    }
+  }
+  if (aParams.Inputs.empty()) {
+    std::cerr << "Usage: " << theArgVec[0]
+              << " [-jobs N] [-format brep|glb|gltf] [-deflection D]"
+                 " [-angle DEG] [-absolute] [-outdir DIR]"
+                 " input1 [input2 ...]\n";
+    return 1;
+  }
+  // inputs with the same name in different directories would be written
+  // into the same output file, concurrently by different workers
+  std::map<std::filesystem::path, std::string> anOutputs;
+  for (const std::string& anInput : aParams.Inputs) {
+    const auto anInserted =
+        anOutputs.emplace(outputPath(anInput, aParams), anInput);
+    if (!anInserted.second) {
+      std::cerr << "Error: '" << anInput << "' and '"
+                << anInserted.first->second << "' are both written to '"
+                << anInserted.first->first.string() << "'\n";
+      return 1;
+    }
+  }
+  std::filesystem::create_directories(aParams.OutDir);
+
+  // global state of translators is initialized before starting workers
+  STEPCAFControl_Controller::Init();
+  IGESControl_Controller::Init();
+  XCAFApp_Application::GetApplication();
+
+  OSD_Timer aTimer;
+  aTimer.Start();
+  std::vector<PrepResult> aResults(aParams.Inputs.size());
+  std::atomic<size_t> aNextInput(0);
+  const auto aWorker = [&aParams, &aResults, &aNextInput]() {
+    for (size_t anInputIter = aNextInput++;
+         anInputIter < aParams.Inputs.size(); anInputIter = aNextInput++) {
+      PrepResult& aResult = aResults[anInputIter];
+      try {
+        prepareFile(aParams.Inputs[anInputIter], aParams, aResult);
+      } catch (const Standard_Failure& theFailure) {
+        aResult.Error = theFailure.GetMessageString();
+      } catch (const std::exception& theException) {
+        aResult.Error = theException.what();
+      }
+    }
+  };
+  const int aNbJobs = std::min(aParams.NbJobs, int(aParams.Inputs.size()));
+  std::vector<std::thread> aThreads;
+  for (int aJobIter = 1; aJobIter < aNbJobs; ++aJobIter) {
+    aThreads.emplace_back(aWorker);
+  }
+  aWorker();
+  for (std::thread& aThread : aThreads) {
+    aThread.join();
+  }
+  aTimer.Stop();
+
+  double aCpuUser = 0.0, aCpuSystem = 0.0;
+  OSD_Chronometer::GetProcessCPU(aCpuUser, aCpuSystem);
+  const double aWallTime = aTimer.ElapsedTime();
+  const double aCpuTime = aCpuUser + aCpuSystem;
+  const int aNbFailed = int(std::count_if(
+      aResults.begin(), aResults.end(),
+      [](const PrepResult& theResult) { return !theResult.Error.empty(); }));
+  const int aNbDone = int(aResults.size()) - aNbFailed;
+
+  std::cout << "{\"jobs\": " << aNbJobs << ", \"files\": " << aResults.size()
+            << ", \"failed\": " << aNbFailed << ", \"wall\": " << aWallTime
+            << ", \"cpu\": " << aCpuTime << ", \"files_per_hour\": "
+            << (aWallTime > 0.0 ? aNbDone * 3600.0 / aWallTime : 0.0)
+            << ", \"files_per_cpu_hour\": "
+            << (aCpuTime > 0.0 ? aNbDone * 3600.0 / aCpuTime : 0.0)
+            << ", \"results\": [";
+  for (size_t anInputIter = 0; anInputIter < aResults.size(); ++anInputIter) {
+    const PrepResult& aResult = aResults[anInputIter];
+    std::cout << (anInputIter != 0 ? ", " : "")
+              << "{\"input\": " << jsonString(aParams.Inputs[anInputIter]);
+    if (!aResult.Error.empty()) {
+      std::cout << ", \"error\": " << jsonString(aResult.Error) << "}";
+      continue;
+    }
+    std::cout << ", \"output\": " << jsonString(aResult.Output)
+              << ", \"bytes\": " << std::filesystem::file_size(aResult.Output)
+              << ", \"faces\": " << aResult.NbFaces
+              << ", \"triangles\": " << aResult.NbTriangles
+              << ", \"read\": " << aResult.ReadTime
+              << ", \"mesh\": " << aResult.MeshTime
+              << ", \"write\": " << aResult.WriteTime << "}";
+  }
+  std::cout << "]}\n";
+  return aNbFailed == 0 ? 0 : 1;
+}